@@ -0,0 +1,132 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#include "GridAttributeLayers.h"
+
+namespace GridAttributeLayers
+{
+	template <typename T>
+	FORCEINLINE T ConvertValue(const float Value)
+	{
+		if constexpr (std::is_same_v<T, float>)
+		{
+			return Value;
+		}
+		else
+		{
+			return static_cast<T>(FMath::Clamp(FMath::RoundToInt32(Value), 0, static_cast<int32>(TNumericLimits<T>::Max())));
+		}
+	}
+
+	template <typename T>
+	FORCEINLINE void FillTyped(TArray<uint8>& Bytes, const int32 StartTile, const int32 Count, const float Value)
+	{
+		const T Converted = ConvertValue<T>(Value);
+		T* Plane = reinterpret_cast<T*>(Bytes.GetData()) + StartTile;
+		if constexpr (sizeof(T) == 1)
+		{
+			FMemory::Memset(Plane, Converted, Count);
+		}
+		else
+		{
+			for (int32 i = 0; i < Count; ++i)
+			{
+				Plane[i] = Converted;
+			}
+		}
+	}
+}
+
+void FGridAttributeLayers::Init(const int32 InNumTiles)
+{
+	NumTiles = FMath::Max(InNumTiles, 0);
+	for (FLayer& Layer : Layers)
+	{
+		Layer.Bytes.SetNumUninitialized(NumTiles * GetTypeSize(Layer.Type));
+		++Layer.Version;
+	}
+
+	for (int32 Layer = 0; Layer < Layers.Num(); ++Layer)
+	{
+		Fill(Layer, Layers[Layer].DefaultValue);
+	}
+}
+
+void FGridAttributeLayers::Empty()
+{
+	Layers.Empty();
+	NumTiles = 0;
+}
+
+SIZE_T FGridAttributeLayers::GetAllocatedSize() const
+{
+	SIZE_T Size = Layers.GetAllocatedSize();
+	for (const FLayer& Layer : Layers)
+	{
+		Size += Layer.Bytes.GetAllocatedSize();
+	}
+	return Size;
+}
+
+int32 FGridAttributeLayers::AddLayer(const FName Name, const EGridAttributeType Type, const float DefaultValue)
+{
+	if(const int32 Existing = FindLayer(Name); Existing != INDEX_NONE)
+	{
+		return Layers[Existing].Type == Type ? Existing : INDEX_NONE;
+	}
+
+	const int32 LayerIndex = Layers.AddDefaulted();
+	FLayer& Layer = Layers[LayerIndex];
+	Layer.Name = Name;
+	Layer.Type = Type;
+	Layer.DefaultValue = DefaultValue;
+	Layer.Bytes.SetNumUninitialized(NumTiles * GetTypeSize(Type));
+	Fill(LayerIndex, DefaultValue);
+	return LayerIndex;
+}
+
+int32 FGridAttributeLayers::FindLayer(const FName Name) const
+{
+	return Layers.IndexOfByPredicate([Name](const FLayer& Layer) { return Layer.Name == Name; });
+}
+
+void FGridAttributeLayers::SetPlaneBytes(const int32 Layer, const TConstArrayView<uint8> Bytes)
+{
+	FLayer& LayerData = Layers[Layer];
+	check(Bytes.Num() == LayerData.Bytes.Num());
+	FMemory::Memcpy(LayerData.Bytes.GetData(), Bytes.GetData(), Bytes.Num());
+	++LayerData.Version;
+}
+
+void FGridAttributeLayers::SetValue(const int32 Layer, const int32 Tile, const float Value)
+{
+	FillRange(Layer, Tile, 1, Value);
+}
+
+void FGridAttributeLayers::Fill(const int32 Layer, const float Value)
+{
+	FillRange(Layer, 0, NumTiles, Value);
+}
+
+void FGridAttributeLayers::FillRange(const int32 Layer, const int32 StartTile, const int32 Count, const float Value)
+{
+	check(StartTile >= 0 && Count >= 0 && StartTile + Count <= NumTiles);
+
+	FLayer& LayerData = Layers[Layer];
+	switch (LayerData.Type)
+	{
+	case EGridAttributeType::UInt8: GridAttributeLayers::FillTyped<uint8>(LayerData.Bytes, StartTile, Count, Value); break;
+	case EGridAttributeType::UInt16: GridAttributeLayers::FillTyped<uint16>(LayerData.Bytes, StartTile, Count, Value); break;
+	default: GridAttributeLayers::FillTyped<float>(LayerData.Bytes, StartTile, Count, Value); break;
+	}
+	++LayerData.Version;
+}
+
+int32 FGridAttributeLayers::GetTypeSize(const EGridAttributeType Type)
+{
+	switch (Type)
+	{
+	case EGridAttributeType::UInt8: return sizeof(uint8);
+	case EGridAttributeType::UInt16: return sizeof(uint16);
+	default: return sizeof(float);
+	}
+}
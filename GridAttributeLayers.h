@@ -0,0 +1,140 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "GridAttributeLayers.generated.h"
+
+UENUM(BlueprintType)
+enum class EGridAttributeType : uint8
+{
+	UInt8,
+	UInt16,
+	Float
+};
+
+/**
+ * Attribute layer declared on the grid, allocated with the tiles info
+ */
+USTRUCT(BlueprintType)
+struct FGridAttributeLayerDesc
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FName Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EGridAttributeType Type = EGridAttributeType::UInt8;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float DefaultValue = 0.0f;
+};
+
+template <typename T> struct TGridAttributeTypeOf;
+template <> struct TGridAttributeTypeOf<uint8> { static constexpr EGridAttributeType Value = EGridAttributeType::UInt8; };
+template <> struct TGridAttributeTypeOf<uint16> { static constexpr EGridAttributeType Value = EGridAttributeType::UInt16; };
+template <> struct TGridAttributeTypeOf<float> { static constexpr EGridAttributeType Value = EGridAttributeType::Float; };
+
+/**
+ * Read only view of a layer plane for code that does not know the element type up front, like the pathfinder
+ */
+struct FGridAttributePlaneView
+{
+	const void* Data = nullptr;
+	EGridAttributeType Type = EGridAttributeType::UInt8;
+
+	FORCEINLINE bool IsValid() const { return Data != nullptr; }
+
+	FORCEINLINE float Get(const int32 Index) const
+	{
+		switch (Type)
+		{
+		case EGridAttributeType::UInt8: return static_cast<const uint8*>(Data)[Index];
+		case EGridAttributeType::UInt16: return static_cast<const uint16*>(Data)[Index];
+		default: return static_cast<const float*>(Data)[Index];
+		}
+	}
+};
+
+/**
+ * Dense per-tile attribute planes, each aligned with the tile index.
+ * Layers are addressed by the index returned from AddLayer / FindLayer so hot loops never hash a name.
+ */
+class FGridAttributeLayers
+{
+public:
+	/** Resize every layer to the tile count, values are reset to the layer default */
+	void Init(int32 InNumTiles);
+	void Empty();
+
+	/** Bytes held by the planes */
+	SIZE_T GetAllocatedSize() const;
+
+	/**
+	 * @return Layer index, the existing one if a layer with this name and type exists, INDEX_NONE if the name is taken by another type
+	 */
+	int32 AddLayer(FName Name, EGridAttributeType Type, float DefaultValue);
+	int32 FindLayer(FName Name) const;
+
+	FORCEINLINE int32 NumLayers() const { return Layers.Num(); }
+	FORCEINLINE bool IsValidLayer(const int32 Layer) const { return Layers.IsValidIndex(Layer); }
+	FORCEINLINE FName GetLayerName(const int32 Layer) const { return Layers[Layer].Name; }
+	FORCEINLINE EGridAttributeType GetLayerType(const int32 Layer) const { return Layers[Layer].Type; }
+
+	/** Incremented on every write through this class or a mutable plane, lets readers reuse copies of the plane */
+	FORCEINLINE uint32 GetLayerVersion(const int32 Layer) const { return Layers[Layer].Version; }
+
+	/** Typed plane, T must match the layer type */
+	template <typename T>
+	TConstArrayView<T> GetPlane(const int32 Layer) const
+	{
+		check(Layers[Layer].Type == TGridAttributeTypeOf<T>::Value);
+		return TConstArrayView<T>(reinterpret_cast<const T*>(Layers[Layer].Bytes.GetData()), NumTiles);
+	}
+
+	/** Typed mutable plane, counts as a write to the whole layer */
+	template <typename T>
+	TArrayView<T> GetMutablePlane(const int32 Layer)
+	{
+		check(Layers[Layer].Type == TGridAttributeTypeOf<T>::Value);
+		++Layers[Layer].Version;
+		return TArrayView<T>(reinterpret_cast<T*>(Layers[Layer].Bytes.GetData()), NumTiles);
+	}
+
+	/** Raw bytes of the plane, for copies that keep the type aside */
+	FORCEINLINE TConstArrayView<uint8> GetPlaneBytes(const int32 Layer) const { return Layers[Layer].Bytes; }
+
+	FORCEINLINE FGridAttributePlaneView GetPlaneView(const int32 Layer) const
+	{
+		return FGridAttributePlaneView{Layers[Layer].Bytes.GetData(), Layers[Layer].Type};
+	}
+
+	/** Value converted to float whatever the layer type */
+	FORCEINLINE float GetValue(const int32 Layer, const int32 Tile) const { return GetPlaneView(Layer).Get(Tile); }
+
+	/** Replace the whole plane, Bytes must hold one element of the layer type per tile */
+	void SetPlaneBytes(int32 Layer, TConstArrayView<uint8> Bytes);
+
+	/** Write a value, rounded and clamped to the range of integer layers */
+	void SetValue(int32 Layer, int32 Tile, float Value);
+
+	void Fill(int32 Layer, float Value);
+	void FillRange(int32 Layer, int32 StartTile, int32 Count, float Value);
+
+private:
+	struct FLayer
+	{
+		FName Name;
+		EGridAttributeType Type = EGridAttributeType::UInt8;
+		float DefaultValue = 0.0f;
+		TArray<uint8> Bytes;
+		uint32 Version = 0;
+	};
+
+	static int32 GetTypeSize(EGridAttributeType Type);
+
+	TArray<FLayer> Layers;
+	int32 NumTiles = 0;
+};
@@ -0,0 +1,351 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#include "GridBenchmarkCommandlet.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GridManager.h"
+#include "GridMeshBuilder.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace GridBenchmark
+{
+	// Sampled tiles and locations are cycled through, small enough to stay in cache so the calls are what gets timed
+	constexpr int32 NumSamples = 4096;
+	constexpr int32 SeedBase = 0x6B1D;
+
+	const TCHAR* DefaultSizes = TEXT("10,64,256,1024,4096");
+	constexpr int64 DefaultOps = 1000000;
+
+	// Per call cost of the generation cases grows with the tiles, fewer runs on large grids
+	FORCEINLINE int32 GetNumGenerationRuns(const int32 Size) { return Size >= 1024 ? 1 : 5; }
+
+	/**
+	 * @brief Line quad emission as AGridManager::CreateLine did it before FGridMeshBuilder, kept as the baseline of the
+	 * line geometry case. Every call fills two temporary arrays then appends them to buffers that were never reserved
+	 */
+	void AppendLineBaseline(const FVector& Start, const FVector& End, const float Thickness, TArray<FVector>& Vertices, TArray<int>& Triangles)
+	{
+		FVector Direction = End - Start;
+		Direction.Normalize();
+		const FVector ThicknessDirection = FVector::CrossProduct(Direction, FVector::UpVector);
+		const float HalfThickness = Thickness / 2;
+
+		const int VerticesCount = Vertices.Num();
+		TArray<int> NewTriangles;
+		NewTriangles.Add(VerticesCount + 2);
+		NewTriangles.Add(VerticesCount + 1);
+		NewTriangles.Add(VerticesCount + 0);
+		NewTriangles.Add(VerticesCount + 2);
+		NewTriangles.Add(VerticesCount + 3);
+		NewTriangles.Add(VerticesCount + 1);
+		Triangles.Append(NewTriangles);
+
+		TArray<FVector> NewVertices;
+		NewVertices.Add(Start + ThicknessDirection * HalfThickness);
+		NewVertices.Add(End + ThicknessDirection * HalfThickness);
+		NewVertices.Add(Start - ThicknessDirection * HalfThickness);
+		NewVertices.Add(End - ThicknessDirection * HalfThickness);
+		Vertices.Append(NewVertices);
+	}
+}
+
+UGridBenchmarkCommandlet::UGridBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+	HelpDescription = TEXT("Time the grid manager hot paths across grid sizes and write the results to JSON or CSV");
+	HelpUsage = TEXT("-run=GridBenchmark -nullrhi [-Sizes=10,64,256,1024,4096] [-Ops=1000000] [-Output=<Path.json|Path.csv>]");
+}
+
+int32 UGridBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString SizesParam = GridBenchmark::DefaultSizes;
+	FParse::Value(*Params, TEXT("Sizes="), SizesParam);
+	int64 NumOps = GridBenchmark::DefaultOps;
+	FParse::Value(*Params, TEXT("Ops="), NumOps);
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("GridBenchmark") / TEXT("GridBenchmark.json");
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+	TArray<FString> SizeStrings;
+	SizesParam.ParseIntoArray(SizeStrings, TEXT(","));
+	if(SizeStrings.IsEmpty() || NumOps <= 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s() Expected -Sizes=<N,N,...> and -Ops=<N> greater than 0"), *FString(__FUNCTION__));
+		return 1;
+	}
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("GridBenchmark"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	for (const FString& SizeString : SizeStrings)
+	{
+		const int32 Size = FCString::Atoi(*SizeString);
+		if(Size <= 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s() Skipping grid size %s"), *FString(__FUNCTION__), *SizeString);
+			continue;
+		}
+		RunSize(World, Size, NumOps);
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	const bool bCsv = FPaths::GetExtension(OutputPath).Equals(TEXT("csv"), ESearchCase::IgnoreCase);
+	if(!FFileHelper::SaveStringToFile(bCsv ? ToCsv() : ToJson(), *OutputPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s() Could not write %s"), *FString(__FUNCTION__), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("%s() %d results written to %s (checksum %llu)"), *FString(__FUNCTION__), Results.Num(), *OutputPath, Checksum);
+	return 0;
+}
+
+/**
+ * @brief Spawn a Size x Size grid and time every case on it
+ */
+void UGridBenchmarkCommandlet::RunSize(UWorld* World, const int32 Size, const int64 NumOps)
+{
+	// Sized before FinishSpawning so the spawn construction builds the grid once at the right size
+	AGridManager* Grid = World->SpawnActorDeferred<AGridManager>(AGridManager::StaticClass(), FTransform::Identity);
+	Grid->NumRows = Size;
+	Grid->NumColumns = Size;
+	Grid->FinishSpawning(FTransform::Identity);
+
+	const int32 NumGenerationRuns = GridBenchmark::GetNumGenerationRuns(Size);
+	uint64 StartCycles = FPlatformTime::Cycles64();
+	for (int32 Run = 0; Run < NumGenerationRuns; ++Run)
+	{
+		Grid->OnConstruction(FTransform::Identity);
+	}
+	AddResult(TEXT("OnConstruction"), Grid, NumGenerationRuns, FPlatformTime::Cycles64() - StartCycles);
+
+	// Geometry of every grid line without the mesh sections, the old per line arrays against the reserved builder
+	const float LineThickness = Grid->LineThickness;
+	const float TileSize = Grid->TileSize;
+	StartCycles = FPlatformTime::Cycles64();
+	for (int32 Run = 0; Run < NumGenerationRuns; ++Run)
+	{
+		TArray<FVector> Vertices;
+		TArray<int> Triangles;
+		for (int32 i = 0; i < Size + 1; ++i)
+		{
+			GridBenchmark::AppendLineBaseline(FVector(TileSize * i, 0.0f, 0.0f), FVector(TileSize * i, Grid->GetGridWidth(), 0.0f), LineThickness, Vertices, Triangles);
+		}
+		for (int32 i = 0; i < Size + 1; ++i)
+		{
+			GridBenchmark::AppendLineBaseline(FVector(0.0f, TileSize * i, 0.0f), FVector(Grid->GetGridHeight(), TileSize * i, 0.0f), LineThickness, Vertices, Triangles);
+		}
+		Checksum += Vertices.Num() + Triangles.Num();
+	}
+	AddResult(TEXT("LineGeometryBaseline"), Grid, NumGenerationRuns, FPlatformTime::Cycles64() - StartCycles);
+
+	FGridMeshBuilder MeshBuilder;
+	StartCycles = FPlatformTime::Cycles64();
+	for (int32 Run = 0; Run < NumGenerationRuns; ++Run)
+	{
+		MeshBuilder.Reset((Size + 1) * 2);
+		for (int32 i = 0; i < Size + 1; ++i)
+		{
+			MeshBuilder.AddLine(FVector(TileSize * i, 0.0f, 0.0f), FVector(TileSize * i, Grid->GetGridWidth(), 0.0f), LineThickness);
+		}
+		for (int32 i = 0; i < Size + 1; ++i)
+		{
+			MeshBuilder.AddLine(FVector(0.0f, TileSize * i, 0.0f), FVector(Grid->GetGridHeight(), TileSize * i, 0.0f), LineThickness);
+		}
+		Checksum += MeshBuilder.Vertices.Num() + MeshBuilder.Triangles.Num();
+	}
+	AddResult(TEXT("LineGeometry"), Grid, NumGenerationRuns, FPlatformTime::Cycles64() - StartCycles);
+
+	// Emptying the storage is not timed, GenerateTileInfo returns early on an initialized grid
+	uint64 GenerationCycles = 0;
+	for (int32 Run = 0; Run < NumGenerationRuns; ++Run)
+	{
+		Grid->TileStorage.Empty();
+		StartCycles = FPlatformTime::Cycles64();
+		Grid->GenerateTileInfo();
+		GenerationCycles += FPlatformTime::Cycles64() - StartCycles;
+	}
+	AddResult(TEXT("GenerateTileInfo"), Grid, NumGenerationRuns, GenerationCycles);
+
+	FRandomStream Random(GridBenchmark::SeedBase + Size);
+	TArray<FIntPoint> Tiles;
+	TArray<FVector> Locations;
+	Tiles.SetNumUninitialized(GridBenchmark::NumSamples);
+	Locations.SetNumUninitialized(GridBenchmark::NumSamples);
+	for (int32 i = 0; i < GridBenchmark::NumSamples; ++i)
+	{
+		Tiles[i] = FIntPoint(Random.RandHelper(Size), Random.RandHelper(Size));
+		Locations[i] = FVector(Random.FRandRange(0.0f, Grid->GetGridHeight()), Random.FRandRange(0.0f, Grid->GetGridWidth()), 0.0f);
+	}
+	constexpr int32 SampleMask = GridBenchmark::NumSamples - 1;
+
+	StartCycles = FPlatformTime::Cycles64();
+	for (int64 Op = 0; Op < NumOps; ++Op)
+	{
+		int Row, Column;
+		bool bValid;
+		Grid->LocationToTile(Locations[Op & SampleMask], Row, Column, bValid);
+		Checksum += Row + Column + bValid;
+	}
+	AddResult(TEXT("LocationToTile"), Grid, NumOps, FPlatformTime::Cycles64() - StartCycles);
+
+	StartCycles = FPlatformTime::Cycles64();
+	for (int64 Op = 0; Op < NumOps; ++Op)
+	{
+		bool bValid;
+		const FIntPoint& Tile = Tiles[Op & SampleMask];
+		Checksum += static_cast<uint64>(Grid->TileToGridLocation(Tile.X, Tile.Y, bValid).X) + bValid;
+	}
+	AddResult(TEXT("TileToGridLocation"), Grid, NumOps, FPlatformTime::Cycles64() - StartCycles);
+
+	// Batch forms convert the whole sample array per call, ops count single conversions
+	const int64 NumBatches = FMath::Max<int64>(NumOps / GridBenchmark::NumSamples, 1);
+	TArray<FIntPoint> BatchTiles;
+	TArray<FVector> BatchLocations;
+	TArray<bool> BatchValid;
+	StartCycles = FPlatformTime::Cycles64();
+	for (int64 Batch = 0; Batch < NumBatches; ++Batch)
+	{
+		Grid->LocationsToTiles(Locations, BatchTiles, BatchValid);
+		Checksum += BatchTiles[Batch & SampleMask].X;
+	}
+	AddResult(TEXT("LocationsToTiles"), Grid, NumBatches * GridBenchmark::NumSamples, FPlatformTime::Cycles64() - StartCycles);
+
+	StartCycles = FPlatformTime::Cycles64();
+	for (int64 Batch = 0; Batch < NumBatches; ++Batch)
+	{
+		Grid->TilesToGridLocations(Tiles, BatchLocations, BatchValid);
+		Checksum += static_cast<uint64>(BatchLocations[Batch & SampleMask].Y);
+	}
+	AddResult(TEXT("TilesToGridLocations"), Grid, NumBatches * GridBenchmark::NumSamples, FPlatformTime::Cycles64() - StartCycles);
+
+	// Every call allocates its result, a tenth of the ops keeps large runs short
+	const int64 NumNeighborOps = FMath::Max<int64>(NumOps / 10, 1);
+	StartCycles = FPlatformTime::Cycles64();
+	for (int64 Op = 0; Op < NumNeighborOps; ++Op)
+	{
+		const FIntPoint& Tile = Tiles[Op & SampleMask];
+		Checksum += Grid->GetNeighboringTiles(Tile.X, Tile.Y, 1, 1).Num();
+	}
+	AddResult(TEXT("GetNeighboringTiles"), Grid, NumNeighborOps, FPlatformTime::Cycles64() - StartCycles);
+
+	StartCycles = FPlatformTime::Cycles64();
+	for (int64 Op = 0; Op < NumOps; ++Op)
+	{
+		const FIntPoint& Tile = Tiles[Op & SampleMask];
+		Checksum += Grid->GetTileInfoAtIndexCopy(Grid->GetTileIndex(Tile.X, Tile.Y)).bCanWalkOn;
+	}
+	AddResult(TEXT("GetTileInfo"), Grid, NumOps, FPlatformTime::Cycles64() - StartCycles);
+
+	// Flipping the walk flag every call times the derived state updates too, not only the early out
+	StartCycles = FPlatformTime::Cycles64();
+	for (int64 Op = 0; Op < NumOps; ++Op)
+	{
+		const FIntPoint& Tile = Tiles[Op & SampleMask];
+		FTileInfo TileInfo(true, (Op & 1) != 0, nullptr);
+		Checksum += Grid->SetTileInfoAtIndex(Grid->GetTileIndex(Tile.X, Tile.Y), TileInfo);
+	}
+	AddResult(TEXT("SetTileInfo"), Grid, NumOps, FPlatformTime::Cycles64() - StartCycles);
+
+	// Spawn bookkeeping without the actor spawns, placed actors take then release their tiles.
+	// Each actor gets a tile of its own so every take is a placement that changes the tile
+	const int32 NumActors = FMath::Min(GridBenchmark::NumSamples, Size * Size);
+	TSet<int32> ActorTiles;
+	ActorTiles.Reserve(NumActors);
+	while (ActorTiles.Num() < NumActors)
+	{
+		ActorTiles.Add(Random.RandHelper(Size * Size));
+	}
+
+	TArray<AActor*> Actors;
+	Actors.Reserve(NumActors);
+	for (const int32 Index : ActorTiles)
+	{
+		// A bare actor has no root to hold its location
+		AActor* Actor = World->SpawnActor<AActor>();
+		USceneComponent* Root = NewObject<USceneComponent>(Actor);
+		Actor->SetRootComponent(Root);
+		Root->RegisterComponent();
+
+		bool bValid;
+		Actor->SetActorLocation(Grid->TileToGridLocation(Index / Size, Index % Size, bValid));
+		Actors.Add(Actor);
+	}
+
+	// Small grids repeat the rounds to time as many ops as the large ones
+	const int32 NumRounds = FMath::DivideAndRoundUp(GridBenchmark::NumSamples, NumActors);
+	uint64 TakeCycles = 0;
+	uint64 ReleaseCycles = 0;
+	for (int32 Round = 0; Round < NumRounds; ++Round)
+	{
+		// Releasing leaves the flags as they are, they are restored untimed so the next takes change them again
+		Grid->SetTilesInRect(0, 0, Size - 1, Size - 1, static_cast<int32>(EGridTileField::Spawnable), true, true);
+
+		StartCycles = FPlatformTime::Cycles64();
+		for (AActor* Actor : Actors)
+		{
+			Checksum += Grid->TakeTileSpace(Actor, false);
+		}
+		TakeCycles += FPlatformTime::Cycles64() - StartCycles;
+
+		StartCycles = FPlatformTime::Cycles64();
+		for (AActor* Actor : Actors)
+		{
+			Checksum += Grid->ReleaseTileSpace(Actor);
+		}
+		ReleaseCycles += FPlatformTime::Cycles64() - StartCycles;
+	}
+	AddResult(TEXT("TakeTileSpace"), Grid, static_cast<int64>(NumRounds) * NumActors, TakeCycles);
+	AddResult(TEXT("ReleaseTileSpace"), Grid, static_cast<int64>(NumRounds) * NumActors, ReleaseCycles);
+
+	for (AActor* Actor : Actors)
+	{
+		Actor->Destroy();
+	}
+	Grid->Destroy();
+	CollectGarbage(RF_NoFlags);
+}
+
+void UGridBenchmarkCommandlet::AddResult(const FString& Case, const AGridManager* Grid, const int64 NumOps, const uint64 Cycles)
+{
+	FResult& Result = Results.AddDefaulted_GetRef();
+	Result.Case = Case;
+	Result.NumRows = Grid->NumRows;
+	Result.NumColumns = Grid->NumColumns;
+	Result.NumOps = NumOps;
+	Result.NanosecondsPerOp = FPlatformTime::ToSeconds64(Cycles) * 1e9 / FMath::Max<int64>(NumOps, 1);
+	Result.BytesPerTile = static_cast<double>(Grid->TileStorage.GetAllocatedSize()) / FMath::Max(Grid->NumRows * Grid->NumColumns, 1);
+
+	UE_LOG(LogTemp, Display, TEXT("%-22s %5dx%-5d %12.2f ns/op %8.3f B/tile"), *Case, Result.NumRows, Result.NumColumns, Result.NanosecondsPerOp, Result.BytesPerTile);
+}
+
+FString UGridBenchmarkCommandlet::ToJson() const
+{
+	FString Json = TEXT("{\n\t\"results\": [\n");
+	for (int32 i = 0; i < Results.Num(); ++i)
+	{
+		const FResult& Result = Results[i];
+		Json += FString::Printf(TEXT("\t\t{\"case\": \"%s\", \"rows\": %d, \"columns\": %d, \"ops\": %lld, \"ns_per_op\": %.3f, \"bytes_per_tile\": %.4f}%s\n"),
+			*Result.Case, Result.NumRows, Result.NumColumns, Result.NumOps, Result.NanosecondsPerOp, Result.BytesPerTile, i + 1 < Results.Num() ? TEXT(",") : TEXT(""));
+	}
+	Json += TEXT("\t]\n}\n");
+	return Json;
+}
+
+FString UGridBenchmarkCommandlet::ToCsv() const
+{
+	FString Csv = TEXT("case,rows,columns,ops,ns_per_op,bytes_per_tile\n");
+	for (const FResult& Result : Results)
+	{
+		Csv += FString::Printf(TEXT("%s,%d,%d,%lld,%.3f,%.4f\n"), *Result.Case, Result.NumRows, Result.NumColumns, Result.NumOps, Result.NanosecondsPerOp, Result.BytesPerTile);
+	}
+	return Csv;
+}
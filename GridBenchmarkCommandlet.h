@@ -0,0 +1,47 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GridBenchmarkCommandlet.generated.h"
+
+class AGridManager;
+
+/**
+ * Times the AGridManager hot paths across grid sizes and writes ns/op and bytes per tile to JSON or CSV.
+ * Runs headless, no rendering needed:
+ * UnrealEditor-Cmd <Project> -run=GridBenchmark -nullrhi [-Sizes=10,64,256,1024,4096] [-Ops=1000000] [-Output=<Path.json|Path.csv>]
+ */
+UCLASS()
+class UGridBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UGridBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	struct FResult
+	{
+		FString Case;
+		int32 NumRows = 0;
+		int32 NumColumns = 0;
+		int64 NumOps = 0;
+		double NanosecondsPerOp = 0.0;
+		double BytesPerTile = 0.0;
+	};
+
+	void RunSize(UWorld* World, int32 Size, int64 NumOps);
+	void AddResult(const FString& Case, const AGridManager* Grid, int64 NumOps, uint64 Cycles);
+
+	FString ToJson() const;
+	FString ToCsv() const;
+
+	TArray<FResult> Results;
+
+	// Folded results of the timed calls so the optimizer keeps them
+	uint64 Checksum = 0;
+};
@@ -0,0 +1,94 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#include "GridCoordinateMapper.h"
+
+#include "GridTileStorage.h"
+
+void FGridCoordinateMapper::LocationsToTiles(const TConstArrayView<FVector> Locations, const TArrayView<FIntPoint> OutTiles, FGridBitset& OutValid) const
+{
+	check(OutTiles.Num() == Locations.Num());
+	OutValid.Init(Locations.Num(), false);
+
+	// Lanes are Row, Column, Row, Column for two locations. Divided by the grid extent then scaled by the tile count like
+	// LocationToTile rather than multiplied by the reciprocal tile size, which rounds differently on tile borders
+	const double GridWidth = static_cast<float>(NumColumns * TileSize);
+	const double GridHeight = static_cast<float>(NumRows * TileSize);
+	const VectorRegister4Double OriginXY = MakeVectorRegisterDouble(Origin.X, Origin.Y, Origin.X, Origin.Y);
+	const VectorRegister4Double Extents = MakeVectorRegisterDouble(GridWidth, GridHeight, GridWidth, GridHeight);
+	const VectorRegister4Double TileCounts = MakeVectorRegisterDouble(static_cast<double>(NumColumns), static_cast<double>(NumRows), static_cast<double>(NumColumns), static_cast<double>(NumRows));
+	const VectorRegister4Double Limits = MakeVectorRegisterDouble(static_cast<double>(NumRows), static_cast<double>(NumColumns), static_cast<double>(NumRows), static_cast<double>(NumColumns));
+	const VectorRegister4Double MinTiles = VectorSetFloat1(static_cast<double>(MIN_int32 / 2));
+	const VectorRegister4Double MaxTiles = VectorSetFloat1(static_cast<double>(MAX_int32 / 2));
+
+	uint64* ValidWords = OutValid.GetWords();
+	const int32 NumPairs = Locations.Num() / 2;
+	for (int32 Pair = 0; Pair < NumPairs; ++Pair)
+	{
+		const FVector& First = Locations[Pair * 2];
+		const FVector& Second = Locations[Pair * 2 + 1];
+
+		const VectorRegister4Double Scaled = VectorMultiply(VectorDivide(VectorSubtract(MakeVectorRegisterDouble(First.X, First.Y, Second.X, Second.Y), OriginXY), Extents), TileCounts);
+		const VectorRegister4Double Floored = VectorMin(VectorMax(VectorFloor(Scaled), MinTiles), MaxTiles);
+		const VectorRegister4Double InGrid = VectorBitwiseAnd(VectorCompareGE(Floored, GlobalVectorConstants::DoubleZero), VectorCompareLT(Floored, Limits));
+
+		// Both components of a location must be in range, lanes 0-1 for the first and 2-3 for the second
+		const uint32 LaneBits = static_cast<uint32>(VectorMaskBits(InGrid));
+		const uint64 PairBits = ((LaneBits & 0x3) == 0x3 ? 1ull : 0ull) | ((LaneBits & 0xC) == 0xC ? 2ull : 0ull);
+		ValidWords[(Pair * 2) >> 6] |= PairBits << ((Pair * 2) & 63);
+
+		double Components[4];
+		VectorStore(Floored, Components);
+		OutTiles[Pair * 2] = FIntPoint(static_cast<int32>(Components[0]), static_cast<int32>(Components[1]));
+		OutTiles[Pair * 2 + 1] = FIntPoint(static_cast<int32>(Components[2]), static_cast<int32>(Components[3]));
+	}
+
+	// Odd one out, clamped like the pairs so far away locations don't overflow the cast
+	if(Locations.Num() & 1)
+	{
+		const int32 Index = Locations.Num() - 1;
+		const double Row = FMath::Clamp(FMath::Floor((Locations[Index].X - Origin.X) / GridWidth * NumColumns), static_cast<double>(MIN_int32 / 2), static_cast<double>(MAX_int32 / 2));
+		const double Column = FMath::Clamp(FMath::Floor((Locations[Index].Y - Origin.Y) / GridHeight * NumRows), static_cast<double>(MIN_int32 / 2), static_cast<double>(MAX_int32 / 2));
+		const FIntPoint Tile(static_cast<int32>(Row), static_cast<int32>(Column));
+		OutTiles[Index] = Tile;
+		OutValid.Set(Index, Tile.X >= 0 && Tile.X < NumRows && Tile.Y >= 0 && Tile.Y < NumColumns);
+	}
+}
+
+void FGridCoordinateMapper::TilesToLocations(const TConstArrayView<FIntPoint> Tiles, const TArrayView<FVector> OutLocations, FGridBitset& OutValid, const bool bCenter, const FVector& Offset) const
+{
+	check(OutLocations.Num() == Tiles.Num());
+	OutValid.Init(Tiles.Num(), false);
+
+	const double CenterOffset = bCenter ? TileSize / 2 : 0.0;
+	const FVector2D Base(Origin.X + CenterOffset + Offset.X, Origin.Y + CenterOffset + Offset.Y);
+	const VectorRegister4Double BaseXY = MakeVectorRegisterDouble(Base.X, Base.Y, Base.X, Base.Y);
+	const VectorRegister4Double TileSizes = VectorSetFloat1(TileSize);
+	const VectorRegister4Int Limits = MakeVectorRegisterInt(NumRows, NumColumns, NumRows, NumColumns);
+
+	uint64* ValidWords = OutValid.GetWords();
+	const int32 NumPairs = Tiles.Num() / 2;
+	for (int32 Pair = 0; Pair < NumPairs; ++Pair)
+	{
+		// Two FIntPoint are four packed int32, one unaligned load
+		const VectorRegister4Int Packed = VectorIntLoad(&Tiles[Pair * 2]);
+		const VectorRegister4Int InGrid = VectorIntAnd(VectorIntCompareGE(Packed, GlobalVectorConstants::IntZero), VectorIntCompareLT(Packed, Limits));
+
+		const uint32 LaneBits = static_cast<uint32>(VectorMaskBits(VectorCastIntToFloat(InGrid)));
+		const uint64 PairBits = ((LaneBits & 0x3) == 0x3 ? 1ull : 0ull) | ((LaneBits & 0xC) == 0xC ? 2ull : 0ull);
+		ValidWords[(Pair * 2) >> 6] |= PairBits << ((Pair * 2) & 63);
+
+		const VectorRegister4Double Locations = VectorMultiplyAdd(VectorRegister4Double(VectorIntToFloat(Packed)), TileSizes, BaseXY);
+		double Components[4];
+		VectorStore(Locations, Components);
+		OutLocations[Pair * 2] = FVector(Components[0], Components[1], Offset.Z);
+		OutLocations[Pair * 2 + 1] = FVector(Components[2], Components[3], Offset.Z);
+	}
+
+	if(Tiles.Num() & 1)
+	{
+		const int32 Index = Tiles.Num() - 1;
+		const FIntPoint& Tile = Tiles[Index];
+		OutLocations[Index] = FVector(Tile.X * TileSize + Base.X, Tile.Y * TileSize + Base.Y, Offset.Z);
+		OutValid.Set(Index, Tile.X >= 0 && Tile.X < NumRows && Tile.Y >= 0 && Tile.Y < NumColumns);
+	}
+}
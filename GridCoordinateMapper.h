@@ -0,0 +1,34 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FGridBitset;
+
+/**
+ * Grid origin and tile size hoisted out of the actor, converts world locations and tiles in bulk.
+ * Two locations or tiles are converted per vector register, validity is written a whole bitset word at a time.
+ */
+struct FGridCoordinateMapper
+{
+	FVector Origin = FVector::ZeroVector;
+	double TileSize = 1.0;
+	int32 NumRows = 0;
+	int32 NumColumns = 0;
+
+	/**
+	 * @brief World locations to tiles, same mapping as AGridManager::LocationToTile
+	 * @param OutTiles Must hold as many elements as Locations
+	 * @param OutValid Resized to Locations, bit set when the tile is in the grid
+	 */
+	void LocationsToTiles(TConstArrayView<FVector> Locations, TArrayView<FIntPoint> OutTiles, FGridBitset& OutValid) const;
+
+	/**
+	 * @brief Tiles to world locations, same mapping as AGridManager::TileToGridLocation
+	 * @param OutLocations Must hold as many elements as Tiles
+	 * @param OutValid Resized to Tiles, bit set when the tile is in the grid
+	 * @param bCenter Center of the tile or its bottom left corner
+	 */
+	void TilesToLocations(TConstArrayView<FIntPoint> Tiles, TArrayView<FVector> OutLocations, FGridBitset& OutValid, bool bCenter = true, const FVector& Offset = FVector::ZeroVector) const;
+};
@@ -0,0 +1,354 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#include "GridFlowField.h"
+
+#include "Algo/Unique.h"
+#include "Tasks/Task.h"
+
+namespace GridFlowField
+{
+	// Steps are paired with their opposite, Direction ^ 1 goes back the other way
+	constexpr int32 NumBuckets = FGridFlowField::DiagonalCost + 1;
+
+	FORCEINLINE bool IsDiagonal(const int32 Direction) { return Direction >= 4; }
+	FORCEINLINE uint32 GetStepCost(const int32 Direction) { return IsDiagonal(Direction) ? FGridFlowField::DiagonalCost : FGridFlowField::StraightCost; }
+
+	FORCEINLINE bool HeapPredicate(const TPair<uint32, int32>& A, const TPair<uint32, int32>& B) { return A.Key < B.Key; }
+}
+
+const FIntPoint FGridFlowField::Steps[8] = {
+	FIntPoint(-1, 0), FIntPoint(1, 0), FIntPoint(0, -1), FIntPoint(0, 1),
+	FIntPoint(-1, -1), FIntPoint(1, 1), FIntPoint(-1, 1), FIntPoint(1, -1)
+};
+
+void FGridFlowField::Build(const FGridBitset& Walkable, const int32 InNumRows, const int32 InNumColumns, const TConstArrayView<int32> Goals)
+{
+	NumRows = InNumRows;
+	NumColumns = InNumColumns;
+	const int32 NumTiles = NumRows * NumColumns;
+	Distances.Init(Unreachable, NumTiles);
+	Directions.Init(NoDirection, NumTiles);
+	GoalFlags.Init(NumTiles, false);
+
+	// Step costs are at most DiagonalCost, so a ring of that many + 1 buckets holds every pending distance
+	TArray<int32> Buckets[GridFlowField::NumBuckets];
+	int32 NumPending = 0;
+	for (const int32 Goal : Goals)
+	{
+		GoalFlags.Set(Goal, true);
+		if(Walkable.Get(Goal) && Distances[Goal] != 0)
+		{
+			Distances[Goal] = 0;
+			Buckets[0].Add(Goal);
+			++NumPending;
+		}
+	}
+
+	for (uint32 Distance = 0; NumPending > 0; ++Distance)
+	{
+		TArray<int32>& Bucket = Buckets[Distance % GridFlowField::NumBuckets];
+		for (const int32 Index : Bucket)
+		{
+			--NumPending;
+			if(Distances[Index] != Distance) continue;
+
+			for (int32 Direction = 0; Direction < 8; ++Direction)
+			{
+				const int32 Neighbor = GetNeighbor(Walkable, Index, Direction);
+				const uint32 NeighborDistance = Distance + GridFlowField::GetStepCost(Direction);
+				if(Neighbor == INDEX_NONE || NeighborDistance >= Distances[Neighbor]) continue;
+
+				Distances[Neighbor] = NeighborDistance;
+				Directions[Neighbor] = Direction ^ 1;
+				Buckets[NeighborDistance % GridFlowField::NumBuckets].Add(Neighbor);
+				++NumPending;
+			}
+		}
+		Bucket.Reset();
+	}
+}
+
+void FGridFlowField::Repair(const FGridBitset& Walkable, const int32 Index)
+{
+	TArray<TPair<uint32, int32>> Queue;
+	const auto Seed = [&](const int32 Tile)
+	{
+		if(GoalFlags.Get(Tile))
+		{
+			Distances[Tile] = 0;
+			Directions[Tile] = NoDirection;
+		}
+		else
+		{
+			// Best step into a tile that still has its distance
+			for (int32 Direction = 0; Direction < 8; ++Direction)
+			{
+				const int32 Neighbor = GetNeighbor(Walkable, Tile, Direction);
+				if(Neighbor == INDEX_NONE || Distances[Neighbor] == Unreachable) continue;
+
+				const uint32 Distance = Distances[Neighbor] + GridFlowField::GetStepCost(Direction);
+				if(Distance < Distances[Tile])
+				{
+					Distances[Tile] = Distance;
+					Directions[Tile] = Direction;
+				}
+			}
+		}
+		if(Distances[Tile] != Unreachable) Queue.HeapPush(TPair<uint32, int32>(Distances[Tile], Tile), GridFlowField::HeapPredicate);
+	};
+
+	const int32 Row = Index / NumColumns;
+	const int32 Column = Index - Row * NumColumns;
+	if(Walkable.Get(Index))
+	{
+		// The tile also opens the diagonals around it, its neighbors spread again through them
+		Seed(Index);
+		for (int32 Direction = 0; Direction < 8; ++Direction)
+		{
+			const FIntPoint Tile(Row + Steps[Direction].X, Column + Steps[Direction].Y);
+			if(Tile.X < 0 || Tile.X >= NumRows || Tile.Y < 0 || Tile.Y >= NumColumns) continue;
+
+			const int32 Neighbor = Tile.X * NumColumns + Tile.Y;
+			if(Distances[Neighbor] != Unreachable) Queue.HeapPush(TPair<uint32, int32>(Distances[Neighbor], Neighbor), GridFlowField::HeapPredicate);
+		}
+		Propagate(Walkable, Queue);
+		return;
+	}
+
+	// Reset the tile, the diagonal steps that cut its corners and every tile whose steps led through them
+	TArray<int32> Affected;
+	Distances[Index] = Unreachable;
+	Directions[Index] = NoDirection;
+	Affected.Add(Index);
+	for (int32 Direction = 0; Direction < 8; ++Direction)
+	{
+		const FIntPoint Tile(Row + Steps[Direction].X, Column + Steps[Direction].Y);
+		if(Tile.X < 0 || Tile.X >= NumRows || Tile.Y < 0 || Tile.Y >= NumColumns) continue;
+
+		const int32 Neighbor = Tile.X * NumColumns + Tile.Y;
+		const uint8 NeighborDirection = Directions[Neighbor];
+		if(NeighborDirection == NoDirection || !GridFlowField::IsDiagonal(NeighborDirection)) continue;
+
+		const FIntPoint Step = Steps[NeighborDirection];
+		if(FIntPoint(Tile.X + Step.X, Tile.Y) == FIntPoint(Row, Column) || FIntPoint(Tile.X, Tile.Y + Step.Y) == FIntPoint(Row, Column))
+		{
+			Distances[Neighbor] = Unreachable;
+			Directions[Neighbor] = NoDirection;
+			Affected.Add(Neighbor);
+		}
+	}
+
+	for (int32 AffectedIndex = 0; AffectedIndex < Affected.Num(); ++AffectedIndex)
+	{
+		const int32 Parent = Affected[AffectedIndex];
+		const int32 ParentRow = Parent / NumColumns;
+		const int32 ParentColumn = Parent - ParentRow * NumColumns;
+		for (int32 Direction = 0; Direction < 8; ++Direction)
+		{
+			const FIntPoint Tile(ParentRow + Steps[Direction].X, ParentColumn + Steps[Direction].Y);
+			if(Tile.X < 0 || Tile.X >= NumRows || Tile.Y < 0 || Tile.Y >= NumColumns) continue;
+
+			// A child steps back onto the parent, the opposite of the direction that reached it
+			const int32 Child = Tile.X * NumColumns + Tile.Y;
+			if(Directions[Child] == (Direction ^ 1))
+			{
+				Distances[Child] = Unreachable;
+				Directions[Child] = NoDirection;
+				Affected.Add(Child);
+			}
+		}
+	}
+
+	for (const int32 Tile : Affected)
+	{
+		if(Walkable.Get(Tile)) Seed(Tile);
+	}
+	Propagate(Walkable, Queue);
+}
+
+int32 FGridFlowField::GetNeighbor(const FGridBitset& Walkable, const int32 Index, const int32 Direction) const
+{
+	const int32 Row = Index / NumColumns;
+	const int32 Column = Index - Row * NumColumns;
+	const FIntPoint Step = Steps[Direction];
+	const int32 NeighborRow = Row + Step.X;
+	const int32 NeighborColumn = Column + Step.Y;
+	if(NeighborRow < 0 || NeighborRow >= NumRows || NeighborColumn < 0 || NeighborColumn >= NumColumns) return INDEX_NONE;
+
+	const int32 Neighbor = NeighborRow * NumColumns + NeighborColumn;
+	if(!Walkable.Get(Neighbor)) return INDEX_NONE;
+
+	// No corner cutting, both orthogonal tiles must be open to step diagonally
+	if(GridFlowField::IsDiagonal(Direction) && (!Walkable.Get(NeighborRow * NumColumns + Column) || !Walkable.Get(Row * NumColumns + NeighborColumn)))
+	{
+		return INDEX_NONE;
+	}
+	return Neighbor;
+}
+
+void FGridFlowField::Propagate(const FGridBitset& Walkable, TArray<TPair<uint32, int32>>& Queue)
+{
+	while (Queue.Num() > 0)
+	{
+		TPair<uint32, int32> Item;
+		Queue.HeapPop(Item, GridFlowField::HeapPredicate, EAllowShrinking::No);
+		if(Item.Key != Distances[Item.Value]) continue;
+
+		for (int32 Direction = 0; Direction < 8; ++Direction)
+		{
+			const int32 Neighbor = GetNeighbor(Walkable, Item.Value, Direction);
+			const uint32 NeighborDistance = Item.Key + GridFlowField::GetStepCost(Direction);
+			if(Neighbor == INDEX_NONE || NeighborDistance >= Distances[Neighbor]) continue;
+
+			Distances[Neighbor] = NeighborDistance;
+			Directions[Neighbor] = Direction ^ 1;
+			Queue.HeapPush(TPair<uint32, int32>(NeighborDistance, Neighbor), GridFlowField::HeapPredicate);
+		}
+	}
+}
+
+FGridFlowFields::~FGridFlowFields()
+{
+	Reset();
+}
+
+int32 FGridFlowFields::Acquire(TArray<int32> Goals)
+{
+	// The same goals in any order or with repeats are the same field
+	Goals.Sort();
+	Goals.SetNum(Algo::Unique(Goals));
+	const uint32 GoalsHash = FCrc::MemCrc32(Goals.GetData(), Goals.Num() * sizeof(int32));
+
+	for (TPair<int32, FEntry>& Pair : Entries)
+	{
+		if(Pair.Value.GoalsHash == GoalsHash && Pair.Value.Goals == Goals)
+		{
+			++Pair.Value.References;
+			return Pair.Key;
+		}
+	}
+
+	const int32 FieldId = NextFieldId++;
+	if(NextFieldId <= 0) NextFieldId = 1;
+
+	FEntry& Entry = Entries.Add(FieldId);
+	Entry.Goals = MoveTemp(Goals);
+	Entry.GoalsHash = GoalsHash;
+	Entry.References = 1;
+	return FieldId;
+}
+
+bool FGridFlowFields::Release(const int32 FieldId)
+{
+	FEntry* Entry = Entries.Find(FieldId);
+	if(Entry == nullptr) return false;
+
+	// A build in flight owns what it writes to, the entry can go right away
+	if(--Entry->References <= 0)
+	{
+		Entries.Remove(FieldId);
+	}
+	return true;
+}
+
+const FGridFlowField* FGridFlowFields::Find(const int32 FieldId) const
+{
+	const FEntry* Entry = Entries.Find(FieldId);
+	return Entry != nullptr ? Entry->Field.Get() : nullptr;
+}
+
+bool FGridFlowFields::Tick(const FGridTileStorage& Storage)
+{
+	if(Storage.IsPaged()) return false;
+
+	// Resized grids drop the old fields since their indices no longer match, other edits keep them until rebuilt
+	const FIntPoint Size(Storage.GetNumRows(), Storage.GetNumColumns());
+	const bool bResized = Size != KnownSize;
+	const bool bWalkChanged = Storage.GetWalkVersion() != KnownWalkVersion;
+	KnownSize = Size;
+	KnownWalkVersion = Storage.GetWalkVersion();
+
+	TSharedPtr<const FGridBitset, ESPMode::ThreadSafe> Walkable;
+	bool bHasBuilds = false;
+	for (TPair<int32, FEntry>& Pair : Entries)
+	{
+		FEntry& Entry = Pair.Value;
+		if(bResized) Entry.Field.Reset();
+		Entry.bDirty |= bWalkChanged;
+
+		if(Entry.Building.IsValid())
+		{
+			if(!Entry.BuildTask.IsCompleted())
+			{
+				bHasBuilds = true;
+				continue;
+			}
+
+			// Builds started before a resize are for the old size
+			if(Entry.Building->GetNumRows() == Size.X && Entry.Building->GetNumColumns() == Size.Y)
+			{
+				Entry.Field = MoveTemp(Entry.Building);
+			}
+			Entry.Building.Reset();
+		}
+
+		if(!Entry.bDirty) continue;
+
+		// Every build launched this tick shares one copy of the walk flags
+		if(!Walkable.IsValid())
+		{
+			Walkable = MakeShared<FGridBitset, ESPMode::ThreadSafe>(Storage.GetWalkableBits());
+		}
+
+		Entry.bDirty = false;
+		Entry.Building = MakeShared<FGridFlowField, ESPMode::ThreadSafe>();
+		Entry.BuildTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Field = Entry.Building, Walkable, Goals = Entry.Goals, Size]()
+		{
+			Field->Build(*Walkable, Size.X, Size.Y, Goals);
+		});
+		bHasBuilds = true;
+	}
+	return bHasBuilds;
+}
+
+bool FGridFlowFields::HasPendingWork(const FGridTileStorage& Storage) const
+{
+	if(Storage.IsPaged() || Entries.Num() == 0) return false;
+	if(Storage.GetWalkVersion() != KnownWalkVersion || FIntPoint(Storage.GetNumRows(), Storage.GetNumColumns()) != KnownSize) return true;
+
+	for (const TPair<int32, FEntry>& Pair : Entries)
+	{
+		if(Pair.Value.bDirty || Pair.Value.Building.IsValid()) return true;
+	}
+	return false;
+}
+
+void FGridFlowFields::OnWalkableChanged(const FGridTileStorage& Storage, const int32 Index)
+{
+	// Missed walk changes need a full build anyway, repairing on top of them would hide them
+	if(Storage.IsPaged() || KnownWalkVersion + 1 != Storage.GetWalkVersion()) return;
+	KnownWalkVersion = Storage.GetWalkVersion();
+
+	for (TPair<int32, FEntry>& Pair : Entries)
+	{
+		FEntry& Entry = Pair.Value;
+		if(Entry.Building.IsValid())
+		{
+			// The build in flight started from older flags
+			Entry.bDirty = true;
+		}
+		else if(Entry.Field.IsValid() && !Entry.bDirty)
+		{
+			Entry.Field->Repair(Storage.GetWalkableBits(), Index);
+		}
+	}
+}
+
+void FGridFlowFields::Reset()
+{
+	for (TPair<int32, FEntry>& Pair : Entries)
+	{
+		Pair.Value.BuildTask.Wait();
+	}
+	Entries.Empty();
+}
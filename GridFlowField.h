@@ -0,0 +1,124 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GridTileStorage.h"
+#include "Tasks/Task.h"
+
+/**
+ * Distance to the nearest of a set of goal tiles and the step to take toward it, for every walkable tile.
+ * Moves are 8-connected without cutting corners like the pathfinder, straight steps cost 10 and diagonals 14
+ * so distances stay integers and the wavefront is a bucket queue instead of a heap.
+ */
+class FGridFlowField
+{
+public:
+	static constexpr uint32 Unreachable = MAX_uint32;
+	static constexpr uint8 NoDirection = 0xFF;
+	static constexpr uint32 StraightCost = 10;
+	static constexpr uint32 DiagonalCost = 14;
+
+	/**
+	 * @brief Expand the wavefront from every goal at once
+	 * @param Goals Tile indices, blocked goals are skipped but stay goals if they open later
+	 */
+	void Build(const FGridBitset& Walkable, int32 InNumRows, int32 InNumColumns, TConstArrayView<int32> Goals);
+
+	/**
+	 * @brief Fix the field after the walk flag of one tile was written, the bitset holds the new value.
+	 * A closed tile only resets the tiles whose steps led through it, an opened one only spreads the distances it shortens
+	 */
+	void Repair(const FGridBitset& Walkable, int32 Index);
+
+	FORCEINLINE int32 GetNumRows() const { return NumRows; }
+	FORCEINLINE int32 GetNumColumns() const { return NumColumns; }
+
+	/** Distance in StraightCost units, Unreachable if no goal can be reached */
+	FORCEINLINE uint32 GetDistance(const int32 Index) const { return Distances[Index]; }
+
+	/** @return Row/column step toward the goals, zero on goals and unreachable tiles */
+	FORCEINLINE FIntPoint GetStep(const int32 Index) const
+	{
+		return Directions[Index] != NoDirection ? Steps[Directions[Index]] : FIntPoint::ZeroValue;
+	}
+
+	FORCEINLINE SIZE_T GetAllocatedSize() const
+	{
+		return Distances.GetAllocatedSize() + Directions.GetAllocatedSize() + GoalFlags.NumWords() * sizeof(uint64);
+	}
+
+private:
+	static const FIntPoint Steps[8];
+
+	/** @return Index of the neighbor in that direction, INDEX_NONE if off grid, blocked or cutting a corner */
+	int32 GetNeighbor(const FGridBitset& Walkable, int32 Index, int32 Direction) const;
+
+	/** Spread distances from the queued tiles, the queue holds (distance, index) pairs */
+	void Propagate(const FGridBitset& Walkable, TArray<TPair<uint32, int32>>& Queue);
+
+	int32 NumRows = 0;
+	int32 NumColumns = 0;
+	TArray<uint32> Distances;
+
+	// Index in Steps of the move toward the parent tile
+	TArray<uint8> Directions;
+	FGridBitset GoalFlags;
+};
+
+/**
+ * Flow fields shared by goal set, built on worker threads against a copy of the walk flags.
+ * Readers always get the last completed field, single tile changes are repaired in place on the game thread
+ * and batch changes rebuild in the background. Must only be used from the game thread.
+ */
+class FGridFlowFields
+{
+public:
+	~FGridFlowFields();
+
+	/**
+	 * @brief Reference the field of a goal set, built on the next Tick if it is new
+	 * @return Id of the field, the same for the same goals until every reference is released
+	 */
+	int32 Acquire(TArray<int32> Goals);
+	bool Release(int32 FieldId);
+
+	/** @return Last completed field, nullptr until the first build is done */
+	const FGridFlowField* Find(int32 FieldId) const;
+
+	/**
+	 * @brief Collect finished builds and launch the ones that are due
+	 * @return true while builds are queued or in flight
+	 */
+	bool Tick(const FGridTileStorage& Storage);
+
+	/** Repair the fields after the walk flag of one tile was written, other walk changes are caught up by Tick */
+	void OnWalkableChanged(const FGridTileStorage& Storage, int32 Index);
+
+	/** Wait for the builds in flight and drop every field */
+	void Reset();
+
+	FORCEINLINE bool HasFields() const { return Entries.Num() > 0; }
+
+	/** @return true while a field is due for a build, has one in flight or missed a walk change since the last Tick */
+	bool HasPendingWork(const FGridTileStorage& Storage) const;
+
+private:
+	struct FEntry
+	{
+		TArray<int32> Goals;
+		uint32 GoalsHash = 0;
+		int32 References = 0;
+		bool bDirty = true;
+		TSharedPtr<FGridFlowField, ESPMode::ThreadSafe> Field;
+		TSharedPtr<FGridFlowField, ESPMode::ThreadSafe> Building;
+		UE::Tasks::FTask BuildTask;
+	};
+
+	TMap<int32, FEntry> Entries;
+	int32 NextFieldId = 1;
+
+	// Walk version the fields are up to date with, anything else was a batch edit and rebuilds them
+	uint32 KnownWalkVersion = 0;
+	FIntPoint KnownSize = FIntPoint::ZeroValue;
+};
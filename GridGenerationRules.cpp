@@ -0,0 +1,389 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#include "GridGenerationRules.h"
+
+#include "Async/ParallelFor.h"
+#include "GridManager.h"
+#include "GridTileStorage.h"
+
+namespace GridGenerationRules
+{
+	// Bitset words packed by one task, whole words so no two tasks write the same one
+	constexpr int32 WordsPerTask = 256;
+
+	/** Call Func(Neighbor) for the 4-connected neighbors of the tile inside the grid */
+	template <typename FuncType>
+	FORCEINLINE void ForEachNeighbor(const FGridGenerationContext& Context, const int32 Index, FuncType&& Func)
+	{
+		const int32 Row = Index / Context.NumColumns;
+		const int32 Column = Index % Context.NumColumns;
+		if(Row > 0) Func(Index - Context.NumColumns);
+		if(Row < Context.NumRows - 1) Func(Index + Context.NumColumns);
+		if(Column > 0) Func(Index - 1);
+		if(Column < Context.NumColumns - 1) Func(Index + 1);
+	}
+
+	/** Mark every walkable tile connected to Start as reached, tiles reached already stop the flood */
+	void Flood(const FGridGenerationContext& Context, const int32 Start, TBitArray<>& Reached, TArray<int32>& Queue)
+	{
+		if(Reached[Start] || !Context.Walkable[Start]) return;
+
+		Queue.Reset();
+		Queue.Add(Start);
+		Reached[Start] = true;
+		for (int32 Head = 0; Head < Queue.Num(); ++Head)
+		{
+			ForEachNeighbor(Context, Queue[Head], [&Context, &Reached, &Queue](const int32 Neighbor)
+			{
+				if(Reached[Neighbor] || !Context.Walkable[Neighbor]) return;
+				Reached[Neighbor] = true;
+				Queue.Add(Neighbor);
+			});
+		}
+	}
+}
+
+void FGridGenerationContext::FromBits(const int32 InNumRows, const int32 InNumColumns, const FGridBitset& InWalkable, const FGridBitset& InSpawnable)
+{
+	NumRows = FMath::Max(InNumRows, 0);
+	NumColumns = FMath::Max(InNumColumns, 0);
+	check(InWalkable.Num() == Num() && InSpawnable.Num() == Num());
+	Walkable.SetNumUninitialized(Num());
+	Spawnable.SetNumUninitialized(Num());
+
+	ParallelFor(NumRows, [this, &InWalkable, &InSpawnable](const int32 Row)
+	{
+		for (int32 Index = Row * NumColumns; Index < (Row + 1) * NumColumns; ++Index)
+		{
+			Walkable[Index] = InWalkable.Get(Index);
+			Spawnable[Index] = InSpawnable.Get(Index);
+		}
+	});
+}
+
+void FGridGenerationContext::ToBits(FGridBitset& OutWalkable, FGridBitset& OutSpawnable) const
+{
+	OutWalkable.Init(Num(), false);
+	OutSpawnable.Init(Num(), false);
+	uint64* WalkableWords = OutWalkable.GetWords();
+	uint64* SpawnableWords = OutSpawnable.GetWords();
+	const int32 NumWords = OutWalkable.NumWords();
+
+	ParallelFor(FMath::DivideAndRoundUp(NumWords, GridGenerationRules::WordsPerTask), [this, WalkableWords, SpawnableWords, NumWords](const int32 Task)
+	{
+		const int32 LastWord = FMath::Min((Task + 1) * GridGenerationRules::WordsPerTask, NumWords);
+		for (int32 Word = Task * GridGenerationRules::WordsPerTask; Word < LastWord; ++Word)
+		{
+			uint64 WalkableWord = 0;
+			uint64 SpawnableWord = 0;
+			const int32 FirstIndex = Word << 6;
+			const int32 NumBits = FMath::Min(64, Num() - FirstIndex);
+			for (int32 Bit = 0; Bit < NumBits; ++Bit)
+			{
+				WalkableWord |= static_cast<uint64>(Walkable[FirstIndex + Bit] != 0) << Bit;
+				SpawnableWord |= static_cast<uint64>(Spawnable[FirstIndex + Bit] != 0) << Bit;
+			}
+			WalkableWords[Word] = WalkableWord;
+			SpawnableWords[Word] = SpawnableWord;
+		}
+	});
+}
+
+void FGridGenerationContext::ApplyRules(const TConstArrayView<TObjectPtr<UGridGenerationRule>> Rules, const int32 Seed)
+{
+	if(Num() == 0) return;
+
+	for (int32 RuleIndex = 0; RuleIndex < Rules.Num(); ++RuleIndex)
+	{
+		// Seeds follow the rule position, so disabling a rule leaves the others unchanged
+		const UGridGenerationRule* Rule = Rules[RuleIndex];
+		if(Rule != nullptr && Rule->bEnabled) Rule->Apply(*this, Hash(static_cast<uint32>(Seed), RuleIndex));
+	}
+}
+
+uint32 FGridGenerationContext::Hash(const uint32 Seed, const uint32 Value)
+{
+	// Murmur3 finalizer over the seed mixed with the value
+	uint32 Result = Seed ^ (Value * 0x9E3779B9u);
+	Result ^= Result >> 16;
+	Result *= 0x85EBCA6Bu;
+	Result ^= Result >> 13;
+	Result *= 0xC2B2AE35u;
+	Result ^= Result >> 16;
+	return Result;
+}
+
+void UGridMaskRule::Apply(FGridGenerationContext& Context, const uint32 Seed) const
+{
+	const bool bWalkable = (Fields & static_cast<int32>(EGridTileField::Walkable)) != 0;
+	const bool bSpawnable = (Fields & static_cast<int32>(EGridTileField::Spawnable)) != 0;
+	if(!bWalkable && !bSpawnable) return;
+
+	TArray<uint8> Mask;
+	Mask.SetNumZeroed(Context.Num());
+	BuildMask(Context, Seed, Mask);
+
+	const uint8 Value = Operation == EGridGenerationOp::Clear ? 1 : 0;
+	ParallelFor(Context.NumRows, [&Context, &Mask, bWalkable, bSpawnable, Value](const int32 Row)
+	{
+		for (int32 Index = Row * Context.NumColumns; Index < (Row + 1) * Context.NumColumns; ++Index)
+		{
+			if(Mask[Index] == 0) continue;
+			if(bWalkable) Context.Walkable[Index] = Value;
+			if(bSpawnable) Context.Spawnable[Index] = Value;
+		}
+	});
+}
+
+void UGridNoiseRule::BuildMask(const FGridGenerationContext& Context, const uint32 Seed, TArray<uint8>& OutMask) const
+{
+	// Every octave reads its own part of the noise, picked by the seed within the 256 tile noise period
+	const int32 NumOctaves = FMath::Clamp(Octaves, 1, 8);
+	FVector2D Offsets[8];
+	float TotalWeight = 0.0f;
+	for (int32 Octave = 0; Octave < NumOctaves; ++Octave)
+	{
+		Offsets[Octave] = FVector2D(FGridGenerationContext::ToUnit(FGridGenerationContext::Hash(Seed, Octave * 2)),
+			FGridGenerationContext::ToUnit(FGridGenerationContext::Hash(Seed, Octave * 2 + 1))) * 256.0;
+		TotalWeight += 1.0f / (1 << Octave);
+	}
+
+	const float BaseFrequency = 1.0f / FMath::Max(FeatureSize, 1.0f);
+	const float ScaledThreshold = Threshold * TotalWeight;
+	ParallelFor(Context.NumRows, [&Context, &OutMask, &Offsets, NumOctaves, BaseFrequency, ScaledThreshold](const int32 Row)
+	{
+		for (int32 Column = 0; Column < Context.NumColumns; ++Column)
+		{
+			float Noise = 0.0f;
+			float Frequency = BaseFrequency;
+			float Weight = 1.0f;
+			for (int32 Octave = 0; Octave < NumOctaves; ++Octave)
+			{
+				Noise += Weight * FMath::PerlinNoise2D(FVector2D(Row, Column) * Frequency + Offsets[Octave]);
+				Frequency *= 2.0f;
+				Weight *= 0.5f;
+			}
+			OutMask[Row * Context.NumColumns + Column] = Noise > ScaledThreshold;
+		}
+	});
+}
+
+void UGridCaveRule::BuildMask(const FGridGenerationContext& Context, const uint32 Seed, TArray<uint8>& OutMask) const
+{
+	const int32 NumRows = Context.NumRows;
+	const int32 NumColumns = Context.NumColumns;
+
+	ParallelFor(NumRows, [this, &OutMask, NumColumns, Seed](const int32 Row)
+	{
+		for (int32 Index = Row * NumColumns; Index < (Row + 1) * NumColumns; ++Index)
+		{
+			OutMask[Index] = FGridGenerationContext::ToUnit(FGridGenerationContext::Hash(Seed, Index)) < FillRatio;
+		}
+	});
+
+	// Each generation reads the previous one only, rows are smoothed independently
+	TArray<uint8> NextWalls;
+	NextWalls.SetNumUninitialized(OutMask.Num());
+	const uint8 OutsideWall = bSolidBorder ? 1 : 0;
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		ParallelFor(NumRows, [this, &OutMask, &NextWalls, NumRows, NumColumns, OutsideWall](const int32 Row)
+		{
+			for (int32 Column = 0; Column < NumColumns; ++Column)
+			{
+				int32 Walls = 0;
+				for (int32 NeighborRow = Row - 1; NeighborRow <= Row + 1; ++NeighborRow)
+				{
+					if(NeighborRow < 0 || NeighborRow >= NumRows)
+					{
+						Walls += OutsideWall * 3;
+						continue;
+					}
+					for (int32 NeighborColumn = Column - 1; NeighborColumn <= Column + 1; ++NeighborColumn)
+					{
+						Walls += (NeighborColumn < 0 || NeighborColumn >= NumColumns) ? OutsideWall : OutMask[NeighborRow * NumColumns + NeighborColumn];
+					}
+				}
+				NextWalls[Row * NumColumns + Column] = Walls >= WallNeighbors;
+			}
+		});
+		Swap(OutMask, NextWalls);
+	}
+}
+
+void UGridScatterRule::BuildMask(const FGridGenerationContext& Context, const uint32 Seed, TArray<uint8>& OutMask) const
+{
+	const int32 Size = FMath::Max(ObstacleSize, 1);
+	const int32 Pitch = Size + FMath::Max(MinSpacing, 0);
+	const int32 NumCellRows = FMath::DivideAndRoundUp(Context.NumRows, Pitch);
+	const int32 NumCellColumns = FMath::DivideAndRoundUp(Context.NumColumns, Pitch);
+	const int32 NumCells = NumCellRows * NumCellColumns;
+
+	// Tried obstacle of each cell, its first tile or INDEX_NONE
+	TArray<FIntPoint> Tries;
+	TArray<uint32> Priorities;
+	Tries.SetNumUninitialized(NumCells);
+	Priorities.SetNumUninitialized(NumCells);
+	ParallelFor(NumCellRows, [this, &Context, &Tries, &Priorities, NumCellColumns, Pitch, Seed](const int32 CellRow)
+	{
+		for (int32 Cell = CellRow * NumCellColumns; Cell < (CellRow + 1) * NumCellColumns; ++Cell)
+		{
+			const uint32 CellHash = FGridGenerationContext::Hash(Seed, Cell);
+			const FIntPoint Tile(CellRow * Pitch + FGridGenerationContext::Hash(CellHash, 1) % Pitch, (Cell % NumCellColumns) * Pitch + FGridGenerationContext::Hash(CellHash, 2) % Pitch);
+			const bool bTry = FGridGenerationContext::ToUnit(CellHash) < Density && Context.IsValidTile(Tile.X, Tile.Y);
+			Tries[Cell] = bTry ? Tile : FIntPoint(INDEX_NONE, INDEX_NONE);
+			Priorities[Cell] = FGridGenerationContext::Hash(CellHash, 3);
+		}
+	});
+
+	// Tries closer than Pitch can only be in neighbor cells, ties go to the lower cell. Bytes so rows of cells are written apart
+	TArray<uint8> Kept;
+	Kept.SetNumZeroed(NumCells);
+	ParallelFor(NumCellRows, [&Tries, &Priorities, &Kept, NumCellRows, NumCellColumns, Pitch](const int32 CellRow)
+	{
+		for (int32 CellColumn = 0; CellColumn < NumCellColumns; ++CellColumn)
+		{
+			const int32 Cell = CellRow * NumCellColumns + CellColumn;
+			if(Tries[Cell].X == INDEX_NONE) continue;
+
+			bool bKeep = true;
+			for (int32 OtherRow = FMath::Max(CellRow - 1, 0); OtherRow <= FMath::Min(CellRow + 1, NumCellRows - 1) && bKeep; ++OtherRow)
+			{
+				for (int32 OtherColumn = FMath::Max(CellColumn - 1, 0); OtherColumn <= FMath::Min(CellColumn + 1, NumCellColumns - 1); ++OtherColumn)
+				{
+					const int32 Other = OtherRow * NumCellColumns + OtherColumn;
+					if(Other == Cell || Tries[Other].X == INDEX_NONE) continue;
+					const FIntPoint Delta = Tries[Other] - Tries[Cell];
+					if(FMath::Max(FMath::Abs(Delta.X), FMath::Abs(Delta.Y)) >= Pitch) continue;
+					if(Priorities[Other] > Priorities[Cell] || (Priorities[Other] == Priorities[Cell] && Other < Cell))
+					{
+						bKeep = false;
+						break;
+					}
+				}
+			}
+			Kept[Cell] = bKeep;
+		}
+	});
+
+	ParallelFor(Context.NumRows, [&Context, &OutMask, &Tries, &Kept, NumCellColumns, Pitch, Size](const int32 Row)
+	{
+		// Obstacles covering the row start in the cell rows at most Size - 1 tiles above it
+		for (int32 CellRow = FMath::Max(Row - Size + 1, 0) / Pitch; CellRow <= Row / Pitch; ++CellRow)
+		{
+			for (int32 Cell = CellRow * NumCellColumns; Cell < (CellRow + 1) * NumCellColumns; ++Cell)
+			{
+				const FIntPoint& Tile = Tries[Cell];
+				if(Kept[Cell] == 0 || Row < Tile.X || Row >= Tile.X + Size) continue;
+				for (int32 Column = Tile.Y; Column < FMath::Min(Tile.Y + Size, Context.NumColumns); ++Column)
+				{
+					OutMask[Row * Context.NumColumns + Column] = 1;
+				}
+			}
+		}
+	});
+}
+
+void UGridConnectivityRule::Apply(FGridGenerationContext& Context, const uint32 Seed) const
+{
+	TArray<int32> Anchors;
+	for (const FIntPoint& Tile : ZoneTiles)
+	{
+		if(!Context.IsValidTile(Tile.X, Tile.Y))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s() Zone tile (%d, %d) is outside the grid"), *FString(__FUNCTION__), Tile.X, Tile.Y);
+			continue;
+		}
+		const int32 Anchor = Tile.X * Context.NumColumns + Tile.Y;
+		Context.Walkable[Anchor] = 1;
+		if(bCarveSpawnable) Context.Spawnable[Anchor] = 1;
+		Anchors.Add(Anchor);
+	}
+	if(Anchors.Num() < 2) return;
+
+	// Tiles that walk to the first zone, grown after every corridor
+	TBitArray<> Reached(false, Context.Num());
+	TArray<int32> Queue;
+	GridGenerationRules::Flood(Context, Anchors[0], Reached, Queue);
+
+	// Search state is allocated by the first zone left out, then reset over the tiles each search touched
+	TArray<int32> Costs;
+	TArray<int32> Parents;
+	TArray<int32> Touched;
+	TArray<int32> Level;
+	TArray<int32> NextLevel;
+	for (int32 Zone = 1; Zone < Anchors.Num(); ++Zone)
+	{
+		const int32 Anchor = Anchors[Zone];
+		if(Reached[Anchor]) continue;
+
+		if(Costs.Num() == 0)
+		{
+			Costs.Init(MAX_int32, Context.Num());
+			Parents.Init(INDEX_NONE, Context.Num());
+		}
+
+		// 0-1 search in buckets of equal cost, entering a walkable tile is free and an unwalkable one costs a carve
+		Costs[Anchor] = 0;
+		Touched.Add(Anchor);
+		Level.Reset();
+		Level.Add(Anchor);
+		int32 Found = INDEX_NONE;
+		for (int32 Cost = 0; Level.Num() > 0 && Found == INDEX_NONE; ++Cost)
+		{
+			NextLevel.Reset();
+			for (int32 Head = 0; Head < Level.Num(); ++Head)
+			{
+				const int32 Tile = Level[Head];
+				// Entry left behind when the tile was reached again for less
+				if(Costs[Tile] != Cost) continue;
+				if(Reached[Tile])
+				{
+					Found = Tile;
+					break;
+				}
+
+				GridGenerationRules::ForEachNeighbor(Context, Tile, [&](const int32 Neighbor)
+				{
+					const int32 NeighborCost = Cost + (Context.Walkable[Neighbor] ? 0 : 1);
+					if(NeighborCost >= Costs[Neighbor]) return;
+					if(Costs[Neighbor] == MAX_int32) Touched.Add(Neighbor);
+					Costs[Neighbor] = NeighborCost;
+					Parents[Neighbor] = Tile;
+					(NeighborCost == Cost ? Level : NextLevel).Add(Neighbor);
+				});
+			}
+			Swap(Level, NextLevel);
+		}
+
+		// Every tile is reachable through carves, the first zone is always found
+		for (int32 Tile = Found; Tile != INDEX_NONE; Tile = Parents[Tile])
+		{
+			if(!Context.Walkable[Tile]) Carve(Context, Tile);
+		}
+		GridGenerationRules::Flood(Context, Anchor, Reached, Queue);
+
+		for (const int32 Tile : Touched)
+		{
+			Costs[Tile] = MAX_int32;
+			Parents[Tile] = INDEX_NONE;
+		}
+		Touched.Reset();
+	}
+}
+
+void UGridConnectivityRule::Carve(FGridGenerationContext& Context, const int32 Index) const
+{
+	const int32 Row = Index / Context.NumColumns;
+	const int32 Column = Index % Context.NumColumns;
+	for (int32 CarveRow = Row - (CorridorWidth - 1) / 2; CarveRow <= Row + CorridorWidth / 2; ++CarveRow)
+	{
+		for (int32 CarveColumn = Column - (CorridorWidth - 1) / 2; CarveColumn <= Column + CorridorWidth / 2; ++CarveColumn)
+		{
+			if(!Context.IsValidTile(CarveRow, CarveColumn)) continue;
+			const int32 Carved = CarveRow * Context.NumColumns + CarveColumn;
+			Context.Walkable[Carved] = 1;
+			if(bCarveSpawnable) Context.Spawnable[Carved] = 1;
+		}
+	}
+}
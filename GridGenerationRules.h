@@ -0,0 +1,201 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+
+#include "GridGenerationRules.generated.h"
+
+struct FGridBitset;
+class UGridGenerationRule;
+
+/**
+ * Walk and spawn state a layout is generated on, one byte per tile indexed like the tile storage, 1 where allowed.
+ * Bytes rather than bits so rows next to each other can be written from different threads.
+ */
+struct FGridGenerationContext
+{
+	int32 NumRows = 0;
+	int32 NumColumns = 0;
+	TArray<uint8> Walkable;
+	TArray<uint8> Spawnable;
+
+	FORCEINLINE int32 Num() const { return NumRows * NumColumns; }
+	FORCEINLINE bool IsValidTile(const int32 Row, const int32 Column) const { return Row >= 0 && Row < NumRows && Column >= 0 && Column < NumColumns; }
+
+	void FromBits(int32 InNumRows, int32 InNumColumns, const FGridBitset& InWalkable, const FGridBitset& InSpawnable);
+	void ToBits(FGridBitset& OutWalkable, FGridBitset& OutSpawnable) const;
+
+	/**
+	 * @brief Run the enabled rules in order
+	 * @param Seed Same seed, rules and grid size always give the same layout, whatever the thread count
+	 */
+	void ApplyRules(TConstArrayView<TObjectPtr<UGridGenerationRule>> Rules, int32 Seed);
+
+	/** Stateless hash, the same seed and value give the same result on any thread and in any order */
+	static uint32 Hash(uint32 Seed, uint32 Value);
+
+	/** Hash mapped to [0, 1) */
+	FORCEINLINE static float ToUnit(const uint32 InHash) { return (InHash >> 8) * (1.0f / 16777216.0f); }
+};
+
+UENUM(BlueprintType)
+enum class EGridGenerationOp : uint8
+{
+	// Selected tiles lose the rule fields
+	Block,
+	// Selected tiles get the rule fields back
+	Clear
+};
+
+/**
+ * Step of a procedural layout, run in order over the hand placed modifiers when the tiles are built
+ */
+UCLASS(Abstract, EditInlineNew, DefaultToInstanced, CollapseCategories)
+class UGridGenerationRule : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, Category="Rule")
+	bool bEnabled = true;
+
+	/**
+	 * @brief Change the context tiles. Called on the game thread, rules spread rows over worker threads themselves
+	 * @param Seed Derived from the layout seed and the rule position
+	 */
+	virtual void Apply(FGridGenerationContext& Context, uint32 Seed) const PURE_VIRTUAL(UGridGenerationRule::Apply, );
+};
+
+/**
+ * Rule that selects tiles independently of the current layout, then blocks or clears the fields on them
+ */
+UCLASS(Abstract)
+class UGridMaskRule : public UGridGenerationRule
+{
+	GENERATED_BODY()
+
+public:
+	/** Fields changed on the selected tiles, Occupant is ignored */
+	UPROPERTY(EditAnywhere, Category="Rule", meta=(Bitmask, BitmaskEnum="/Script/OptimizedGrid.EGridTileField"))
+	int32 Fields = 3;
+
+	UPROPERTY(EditAnywhere, Category="Rule")
+	EGridGenerationOp Operation = EGridGenerationOp::Block;
+
+	virtual void Apply(FGridGenerationContext& Context, uint32 Seed) const override;
+
+protected:
+	/** @param OutMask One byte per tile, already zeroed, set to 1 on the selected tiles */
+	virtual void BuildMask(const FGridGenerationContext& Context, uint32 Seed, TArray<uint8>& OutMask) const PURE_VIRTUAL(UGridMaskRule::BuildMask, );
+};
+
+/**
+ * Selects the tiles where layered Perlin noise is above a threshold, for blobs of rock or open clearings
+ */
+UCLASS(meta=(DisplayName="Noise Threshold"))
+class UGridNoiseRule : public UGridMaskRule
+{
+	GENERATED_BODY()
+
+public:
+	/** Rough size in tiles of the largest blobs */
+	UPROPERTY(EditAnywhere, Category="Noise", meta=(ClampMin=1))
+	float FeatureSize = 24.0f;
+
+	/** Tiles whose noise, from -1 to 1, is above this are selected */
+	UPROPERTY(EditAnywhere, Category="Noise", meta=(ClampMin=-1, ClampMax=1))
+	float Threshold = 0.25f;
+
+	/** Layers of finer noise, each half the size and weight of the previous one */
+	UPROPERTY(EditAnywhere, Category="Noise", meta=(ClampMin=1, ClampMax=8))
+	int32 Octaves = 3;
+
+protected:
+	virtual void BuildMask(const FGridGenerationContext& Context, uint32 Seed, TArray<uint8>& OutMask) const override;
+};
+
+/**
+ * Cellular automaton caves, a random fill smoothed a few times. Selects the cave walls
+ */
+UCLASS(meta=(DisplayName="Cellular Caves"))
+class UGridCaveRule : public UGridMaskRule
+{
+	GENERATED_BODY()
+
+public:
+	/** Share of tiles that start as walls */
+	UPROPERTY(EditAnywhere, Category="Caves", meta=(ClampMin=0, ClampMax=1))
+	float FillRatio = 0.45f;
+
+	UPROPERTY(EditAnywhere, Category="Caves", meta=(ClampMin=0, ClampMax=16))
+	int32 Iterations = 4;
+
+	/** A tile becomes a wall when at least this many tiles of its 3x3 block, itself included, are walls */
+	UPROPERTY(EditAnywhere, Category="Caves", meta=(ClampMin=1, ClampMax=9))
+	int32 WallNeighbors = 5;
+
+	/** Tiles past the grid edge count as walls, closing the caves along the border */
+	UPROPERTY(EditAnywhere, Category="Caves")
+	bool bSolidBorder = true;
+
+protected:
+	virtual void BuildMask(const FGridGenerationContext& Context, uint32 Seed, TArray<uint8>& OutMask) const override;
+};
+
+/**
+ * Square obstacles scattered with a minimum gap between any two of them, for cover or props.
+ * The grid is cut in cells one obstacle plus the gap wide, each cell may try one obstacle and a try is kept
+ * if it has the highest priority among the tries too close to it, so cells are decided independently
+ */
+UCLASS(meta=(DisplayName="Scatter"))
+class UGridScatterRule : public UGridMaskRule
+{
+	GENERATED_BODY()
+
+public:
+	/** Side of an obstacle in tiles */
+	UPROPERTY(EditAnywhere, Category="Scatter", meta=(ClampMin=1))
+	int32 ObstacleSize = 1;
+
+	/** Free tiles kept between two obstacles, along rows, columns and diagonals */
+	UPROPERTY(EditAnywhere, Category="Scatter", meta=(ClampMin=0))
+	int32 MinSpacing = 3;
+
+	/** Chance each cell tries an obstacle */
+	UPROPERTY(EditAnywhere, Category="Scatter", meta=(ClampMin=0, ClampMax=1))
+	float Density = 0.6f;
+
+protected:
+	virtual void BuildMask(const FGridGenerationContext& Context, uint32 Seed, TArray<uint8>& OutMask) const override;
+};
+
+/**
+ * Carves corridors through unwalkable tiles until every zone tile can walk to the first one, crossing as few
+ * unwalkable tiles as it can. Zones connected by the layout already cost one flood fill. Put it after the rules that
+ * block tiles. Searches run on the game thread, only over the tiles they reach
+ */
+UCLASS(meta=(DisplayName="Connect Zones"))
+class UGridConnectivityRule : public UGridGenerationRule
+{
+	GENERATED_BODY()
+
+public:
+	/** One (row, column) tile per spawn zone, made walkable if it is not */
+	UPROPERTY(EditAnywhere, Category="Connectivity")
+	TArray<FIntPoint> ZoneTiles;
+
+	UPROPERTY(EditAnywhere, Category="Connectivity", meta=(ClampMin=1, ClampMax=8))
+	int32 CorridorWidth = 1;
+
+	/** Carved tiles are made spawnable as well as walkable */
+	UPROPERTY(EditAnywhere, Category="Connectivity")
+	bool bCarveSpawnable = false;
+
+	virtual void Apply(FGridGenerationContext& Context, uint32 Seed) const override;
+
+private:
+	/** Open the corridor square centered on the tile */
+	void Carve(FGridGenerationContext& Context, int32 Index) const;
+};
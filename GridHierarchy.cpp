@@ -0,0 +1,493 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#include "GridHierarchy.h"
+
+#include "Algo/Reverse.h"
+#include "Async/ParallelFor.h"
+#include "GridTileStorage.h"
+
+namespace GridHierarchy
+{
+	constexpr uint32 Unreachable = MAX_uint32;
+	constexpr uint32 StraightCost = 10;
+	constexpr uint32 DiagonalCost = 14;
+	constexpr uint8 NoParent = 0xFF;
+
+	// Runs of open border tiles longer than this get an entrance at each end instead of one in the middle
+	constexpr int32 MaxSingleEntranceWidth = 6;
+
+	// Abstract search keys of the start and goal, node keys are their tile index
+	constexpr int32 StartKey = -2;
+	constexpr int32 GoalKey = -3;
+
+	// Paired with their opposite, Direction ^ 1 steps back
+	const FIntPoint Steps[8] = {
+		FIntPoint(-1, 0), FIntPoint(1, 0), FIntPoint(0, -1), FIntPoint(0, 1),
+		FIntPoint(-1, -1), FIntPoint(1, 1), FIntPoint(-1, 1), FIntPoint(1, -1)
+	};
+
+	FORCEINLINE bool HeapPredicate(const TPair<uint32, int32>& A, const TPair<uint32, int32>& B) { return A.Key < B.Key; }
+
+	FORCEINLINE uint32 Heuristic(const int32 TileA, const int32 TileB, const int32 NumColumns)
+	{
+		const int32 DeltaRows = FMath::Abs(TileA / NumColumns - TileB / NumColumns);
+		const int32 DeltaColumns = FMath::Abs(TileA % NumColumns - TileB % NumColumns);
+		return StraightCost * FMath::Max(DeltaRows, DeltaColumns) + (DiagonalCost - StraightCost) * FMath::Min(DeltaRows, DeltaColumns);
+	}
+}
+
+void FGridHierarchy::Init(const int32 InNumRows, const int32 InNumColumns, const int32 InClusterSize)
+{
+	Empty();
+
+	NumRows = FMath::Max(InNumRows, 0);
+	NumColumns = FMath::Max(InNumColumns, 0);
+	ClusterSize = FMath::Max(InClusterSize, 4);
+	NumClusterRows = FMath::DivideAndRoundUp(NumRows, ClusterSize);
+	NumClusterColumns = FMath::DivideAndRoundUp(NumColumns, ClusterSize);
+
+	// Nothing is built here, the first query builds every cluster
+	Clusters.SetNum(NumClusterRows * NumClusterColumns);
+	RowBorders.SetNum(FMath::Max(NumClusterRows - 1, 0) * NumClusterColumns);
+	ColumnBorders.SetNum(NumClusterRows * FMath::Max(NumClusterColumns - 1, 0));
+	DirtyRowBorders.Init(true, RowBorders.Num());
+	DirtyColumnBorders.Init(true, ColumnBorders.Num());
+}
+
+void FGridHierarchy::Empty()
+{
+	NumRows = 0;
+	NumColumns = 0;
+	NumClusterRows = 0;
+	NumClusterColumns = 0;
+	Clusters.Empty();
+	RowBorders.Empty();
+	ColumnBorders.Empty();
+	DirtyRowBorders.Empty();
+	DirtyColumnBorders.Empty();
+}
+
+void FGridHierarchy::MarkRectDirty(const FIntRect& Tiles)
+{
+	const FIntRect Clipped(FMath::Max(Tiles.Min.X, 0), FMath::Max(Tiles.Min.Y, 0), FMath::Min(Tiles.Max.X, NumRows), FMath::Min(Tiles.Max.Y, NumColumns));
+	if(Clipped.Min.X >= Clipped.Max.X || Clipped.Min.Y >= Clipped.Max.Y || !IsInitialized()) return;
+
+	const int32 MinClusterRow = Clipped.Min.X / ClusterSize;
+	const int32 MaxClusterRow = (Clipped.Max.X - 1) / ClusterSize;
+	const int32 MinClusterColumn = Clipped.Min.Y / ClusterSize;
+	const int32 MaxClusterColumn = (Clipped.Max.Y - 1) / ClusterSize;
+	for (int32 ClusterRow = MinClusterRow; ClusterRow <= MaxClusterRow; ++ClusterRow)
+	{
+		for (int32 ClusterColumn = MinClusterColumn; ClusterColumn <= MaxClusterColumn; ++ClusterColumn)
+		{
+			Clusters[ClusterRow * NumClusterColumns + ClusterColumn].bDirty = true;
+		}
+	}
+
+	// A border only depends on the two tile rows (or columns) facing each other across it
+	for (int32 BorderRow = FMath::Max(MinClusterRow - 1, 0); BorderRow <= FMath::Min(MaxClusterRow, NumClusterRows - 2); ++BorderRow)
+	{
+		const int32 FirstRowBelow = (BorderRow + 1) * ClusterSize;
+		if(Clipped.Min.X > FirstRowBelow || Clipped.Max.X < FirstRowBelow) continue;
+		for (int32 ClusterColumn = MinClusterColumn; ClusterColumn <= MaxClusterColumn; ++ClusterColumn)
+		{
+			DirtyRowBorders[BorderRow * NumClusterColumns + ClusterColumn] = true;
+		}
+	}
+
+	for (int32 BorderColumn = FMath::Max(MinClusterColumn - 1, 0); BorderColumn <= FMath::Min(MaxClusterColumn, NumClusterColumns - 2); ++BorderColumn)
+	{
+		const int32 FirstColumnRight = (BorderColumn + 1) * ClusterSize;
+		if(Clipped.Min.Y > FirstColumnRight || Clipped.Max.Y < FirstColumnRight) continue;
+		for (int32 ClusterRow = MinClusterRow; ClusterRow <= MaxClusterRow; ++ClusterRow)
+		{
+			DirtyColumnBorders[ClusterRow * (NumClusterColumns - 1) + BorderColumn] = true;
+		}
+	}
+}
+
+void FGridHierarchy::Update(const FGridBitset& Walkable)
+{
+	// Clusters only need their nodes and costs rebuilt when the entrances of one of their borders moved
+	TArray<FIntPoint> Transitions;
+	for (int32 Border = 0; Border < RowBorders.Num(); ++Border)
+	{
+		if(!DirtyRowBorders[Border]) continue;
+
+		const int32 ClusterA = Border;
+		const int32 ClusterB = Border + NumClusterColumns;
+		BuildBorder(Walkable, ClusterA, ClusterB, true, Transitions);
+		if(Transitions != RowBorders[Border])
+		{
+			RowBorders[Border] = Transitions;
+			Clusters[ClusterA].bDirty = true;
+			Clusters[ClusterB].bDirty = true;
+		}
+		DirtyRowBorders[Border] = false;
+	}
+
+	for (int32 Border = 0; Border < ColumnBorders.Num(); ++Border)
+	{
+		if(!DirtyColumnBorders[Border]) continue;
+
+		const int32 ClusterA = (Border / (NumClusterColumns - 1)) * NumClusterColumns + Border % (NumClusterColumns - 1);
+		const int32 ClusterB = ClusterA + 1;
+		BuildBorder(Walkable, ClusterA, ClusterB, false, Transitions);
+		if(Transitions != ColumnBorders[Border])
+		{
+			ColumnBorders[Border] = Transitions;
+			Clusters[ClusterA].bDirty = true;
+			Clusters[ClusterB].bDirty = true;
+		}
+		DirtyColumnBorders[Border] = false;
+	}
+
+	TArray<int32> DirtyClusters;
+	for (int32 Cluster = 0; Cluster < Clusters.Num(); ++Cluster)
+	{
+		if(Clusters[Cluster].bDirty) DirtyClusters.Add(Cluster);
+	}
+
+	// Clusters only write to themselves and read the borders, the first build of a large grid spreads over the workers
+	ParallelFor(DirtyClusters.Num(), [this, &Walkable, &DirtyClusters](const int32 i)
+	{
+		FClusterSearch Search;
+		BuildCluster(Walkable, DirtyClusters[i], Search);
+	}, DirtyClusters.Num() < 4);
+}
+
+bool FGridHierarchy::FindAbstractPath(const FGridBitset& Walkable, const int32 Start, const int32 Goal, TArray<int32>& OutWaypoints)
+{
+	OutWaypoints.Reset();
+	if(!IsInitialized() || !Walkable.Get(Start) || !Walkable.Get(Goal)) return false;
+
+	if(Start == Goal)
+	{
+		OutWaypoints.Add(Start);
+		return true;
+	}
+
+	// Connect the start and goal to the nodes of their clusters for this query only
+	const int32 StartCluster = GetClusterOfTile(Start);
+	const int32 GoalCluster = GetClusterOfTile(Goal);
+	const auto GetLocalIndex = [this](const FIntRect& Rect, const int32 Tile)
+	{
+		return (Tile / NumColumns - Rect.Min.X) * Rect.Height() + Tile % NumColumns - Rect.Min.Y;
+	};
+
+	TArray<uint32> StartCosts;
+	SearchCluster(Walkable, StartCluster, Start, QuerySearch);
+	for (const FNode& Node : Clusters[StartCluster].Nodes)
+	{
+		StartCosts.Add(QuerySearch.Distances[GetLocalIndex(QuerySearch.Rect, Node.Tile)]);
+	}
+	const uint32 DirectCost = StartCluster == GoalCluster ? QuerySearch.Distances[GetLocalIndex(QuerySearch.Rect, Goal)] : GridHierarchy::Unreachable;
+
+	TArray<uint32> GoalCosts;
+	SearchCluster(Walkable, GoalCluster, Goal, QuerySearch);
+	for (const FNode& Node : Clusters[GoalCluster].Nodes)
+	{
+		GoalCosts.Add(QuerySearch.Distances[GetLocalIndex(QuerySearch.Rect, Node.Tile)]);
+	}
+
+	struct FState
+	{
+		uint32 Cost;
+		int32 Parent;
+		bool bClosed;
+	};
+	TMap<int32, FState> States;
+	TArray<TPair<uint32, int32>> Open;
+
+	const auto GetTile = [Start, Goal](const int32 Key) { return Key == GridHierarchy::StartKey ? Start : Key == GridHierarchy::GoalKey ? Goal : Key; };
+	const auto Relax = [&](const int32 FromKey, const int32 ToKey, const uint32 StepCost)
+	{
+		const uint32 Cost = States[FromKey].Cost + StepCost;
+		const FState* State = States.Find(ToKey);
+		if(State != nullptr && State->Cost <= Cost) return;
+
+		States.Add(ToKey, FState{Cost, FromKey, false});
+		Open.HeapPush(TPair<uint32, int32>(Cost + GridHierarchy::Heuristic(GetTile(ToKey), Goal, NumColumns), ToKey), GridHierarchy::HeapPredicate);
+	};
+
+	States.Add(GridHierarchy::StartKey, FState{0, INDEX_NONE, false});
+	Open.HeapPush(TPair<uint32, int32>(0, GridHierarchy::StartKey), GridHierarchy::HeapPredicate);
+	bool bFound = false;
+	while (Open.Num() > 0)
+	{
+		TPair<uint32, int32> Item;
+		Open.HeapPop(Item, GridHierarchy::HeapPredicate, EAllowShrinking::No);
+		FState& State = States[Item.Value];
+		if(State.bClosed) continue;
+		State.bClosed = true;
+
+		if(Item.Value == GridHierarchy::GoalKey)
+		{
+			bFound = true;
+			break;
+		}
+
+		if(Item.Value == GridHierarchy::StartKey)
+		{
+			const TArray<FNode>& Nodes = Clusters[StartCluster].Nodes;
+			for (int32 i = 0; i < Nodes.Num(); ++i)
+			{
+				if(StartCosts[i] != GridHierarchy::Unreachable) Relax(GridHierarchy::StartKey, Nodes[i].Tile, StartCosts[i]);
+			}
+			if(DirectCost != GridHierarchy::Unreachable) Relax(GridHierarchy::StartKey, GridHierarchy::GoalKey, DirectCost);
+			continue;
+		}
+
+		const int32 Cluster = GetClusterOfTile(Item.Value);
+		const FCluster& ClusterData = Clusters[Cluster];
+		const int32 NodeIndex = FindNode(Cluster, Item.Value);
+		const int32 NumNodes = ClusterData.Nodes.Num();
+		for (int32 Other = 0; Other < NumNodes; ++Other)
+		{
+			const uint32 Cost = ClusterData.Costs[NodeIndex * NumNodes + Other];
+			if(Other != NodeIndex && Cost != GridHierarchy::Unreachable) Relax(Item.Value, ClusterData.Nodes[Other].Tile, Cost);
+		}
+		for (const int32 Partner : ClusterData.Nodes[NodeIndex].Partners)
+		{
+			if(Partner != INDEX_NONE) Relax(Item.Value, Partner, GridHierarchy::StraightCost);
+		}
+		if(Cluster == GoalCluster && GoalCosts[NodeIndex] != GridHierarchy::Unreachable)
+		{
+			Relax(Item.Value, GridHierarchy::GoalKey, GoalCosts[NodeIndex]);
+		}
+	}
+
+	if(!bFound) return false;
+
+	for (int32 Key = GridHierarchy::GoalKey; Key != INDEX_NONE; Key = States[Key].Parent)
+	{
+		// A start or goal that is also a node shows up twice, once under each key
+		const int32 Tile = GetTile(Key);
+		if(OutWaypoints.Num() == 0 || OutWaypoints.Last() != Tile) OutWaypoints.Add(Tile);
+	}
+	Algo::Reverse(OutWaypoints);
+	return true;
+}
+
+bool FGridHierarchy::RefineSegment(const FGridBitset& Walkable, const int32 From, const int32 To, TArray<int32>& OutTiles)
+{
+	if(From == To) return true;
+
+	const int32 Cluster = GetClusterOfTile(From);
+	if(Cluster != GetClusterOfTile(To))
+	{
+		// Segments leaving a cluster are the single step between two entrance nodes
+		const bool bAdjacent = FMath::Abs(From / NumColumns - To / NumColumns) + FMath::Abs(From % NumColumns - To % NumColumns) == 1;
+		if(!bAdjacent || !Walkable.Get(To)) return false;
+
+		OutTiles.Add(To);
+		return true;
+	}
+
+	// Only node to node segments are cached, start and goal segments differ every query
+	FCluster& ClusterData = Clusters[Cluster];
+	const bool bCacheable = FindNode(Cluster, From) != INDEX_NONE && FindNode(Cluster, To) != INDEX_NONE;
+	const uint64 SegmentKey = (static_cast<uint64>(From) << 32) | static_cast<uint32>(To);
+	if(bCacheable)
+	{
+		if(const TArray<int32>* Cached = ClusterData.Segments.Find(SegmentKey))
+		{
+			OutTiles.Append(*Cached);
+			return true;
+		}
+	}
+
+	// Search from the end so following the parents from the start walks toward it
+	SearchCluster(Walkable, Cluster, To, QuerySearch);
+	const FIntRect& Rect = QuerySearch.Rect;
+	FIntPoint Position(From / NumColumns, From % NumColumns);
+	if(QuerySearch.Distances[(Position.X - Rect.Min.X) * Rect.Height() + Position.Y - Rect.Min.Y] == GridHierarchy::Unreachable) return false;
+
+	const int32 FirstTile = OutTiles.Num();
+	for (int32 Tile = From; Tile != To;)
+	{
+		const uint8 Parent = QuerySearch.Parents[(Position.X - Rect.Min.X) * Rect.Height() + Position.Y - Rect.Min.Y];
+		Position += GridHierarchy::Steps[Parent];
+		Tile = Position.X * NumColumns + Position.Y;
+		OutTiles.Add(Tile);
+	}
+
+	if(bCacheable)
+	{
+		ClusterData.Segments.Add(SegmentKey, TArray<int32>(OutTiles.GetData() + FirstTile, OutTiles.Num() - FirstTile));
+	}
+	return true;
+}
+
+int32 FGridHierarchy::NumNodes() const
+{
+	int32 Count = 0;
+	for (const FCluster& Cluster : Clusters)
+	{
+		Count += Cluster.Nodes.Num();
+	}
+	return Count;
+}
+
+FIntRect FGridHierarchy::GetClusterRect(const int32 Cluster) const
+{
+	const int32 ClusterRow = Cluster / NumClusterColumns;
+	const int32 ClusterColumn = Cluster % NumClusterColumns;
+	return FIntRect(ClusterRow * ClusterSize, ClusterColumn * ClusterSize,
+		FMath::Min((ClusterRow + 1) * ClusterSize, NumRows), FMath::Min((ClusterColumn + 1) * ClusterSize, NumColumns));
+}
+
+/**
+ * @brief Find the entrances across the border between two adjacent clusters
+ * @param bRowBorder ClusterB is below ClusterA if true, on its right otherwise
+ */
+void FGridHierarchy::BuildBorder(const FGridBitset& Walkable, const int32 ClusterA, const int32 ClusterB, const bool bRowBorder, TArray<FIntPoint>& OutTransitions) const
+{
+	OutTransitions.Reset();
+	const FIntRect RectA = GetClusterRect(ClusterA);
+	const int32 SpanStart = bRowBorder ? RectA.Min.Y : RectA.Min.X;
+	const int32 SpanEnd = bRowBorder ? RectA.Max.Y : RectA.Max.X;
+
+	// Tile pair facing each other across the border at a position along it
+	const auto GetPair = [&](const int32 Along)
+	{
+		const int32 TileA = bRowBorder ? (RectA.Max.X - 1) * NumColumns + Along : Along * NumColumns + RectA.Max.Y - 1;
+		return FIntPoint(TileA, bRowBorder ? TileA + NumColumns : TileA + 1);
+	};
+
+	int32 RunStart = INDEX_NONE;
+	for (int32 Along = SpanStart; Along <= SpanEnd; ++Along)
+	{
+		const FIntPoint Pair = Along < SpanEnd ? GetPair(Along) : FIntPoint::ZeroValue;
+		const bool bOpen = Along < SpanEnd && Walkable.Get(Pair.X) && Walkable.Get(Pair.Y);
+		if(bOpen && RunStart == INDEX_NONE)
+		{
+			RunStart = Along;
+		}
+		else if(!bOpen && RunStart != INDEX_NONE)
+		{
+			const int32 RunLength = Along - RunStart;
+			if(RunLength <= GridHierarchy::MaxSingleEntranceWidth)
+			{
+				OutTransitions.Add(GetPair(RunStart + RunLength / 2));
+			}
+			else
+			{
+				OutTransitions.Add(GetPair(RunStart));
+				OutTransitions.Add(GetPair(Along - 1));
+			}
+			RunStart = INDEX_NONE;
+		}
+	}
+}
+
+/**
+ * @brief Rebuild the nodes of a cluster from its borders and the costs between them
+ */
+void FGridHierarchy::BuildCluster(const FGridBitset& Walkable, const int32 Cluster, FClusterSearch& Search)
+{
+	FCluster& ClusterData = Clusters[Cluster];
+	ClusterData.Nodes.Reset();
+	ClusterData.Segments.Reset();
+
+	const auto AddNode = [&](const int32 Tile, const int32 Partner)
+	{
+		int32 NodeIndex = FindNode(Cluster, Tile);
+		if(NodeIndex == INDEX_NONE)
+		{
+			NodeIndex = ClusterData.Nodes.AddDefaulted();
+			ClusterData.Nodes[NodeIndex].Tile = Tile;
+		}
+		int32* Partners = ClusterData.Nodes[NodeIndex].Partners;
+		Partners[Partners[0] == INDEX_NONE ? 0 : 1] = Partner;
+	};
+
+	// Transition pairs list the upper/left tile first
+	const int32 ClusterRow = Cluster / NumClusterColumns;
+	const int32 ClusterColumn = Cluster % NumClusterColumns;
+	if(ClusterRow > 0)
+	{
+		for (const FIntPoint& Pair : RowBorders[Cluster - NumClusterColumns]) AddNode(Pair.Y, Pair.X);
+	}
+	if(ClusterRow < NumClusterRows - 1)
+	{
+		for (const FIntPoint& Pair : RowBorders[Cluster]) AddNode(Pair.X, Pair.Y);
+	}
+	if(ClusterColumn > 0)
+	{
+		for (const FIntPoint& Pair : ColumnBorders[ClusterRow * (NumClusterColumns - 1) + ClusterColumn - 1]) AddNode(Pair.Y, Pair.X);
+	}
+	if(ClusterColumn < NumClusterColumns - 1)
+	{
+		for (const FIntPoint& Pair : ColumnBorders[ClusterRow * (NumClusterColumns - 1) + ClusterColumn]) AddNode(Pair.X, Pair.Y);
+	}
+
+	const int32 NumNodes = ClusterData.Nodes.Num();
+	ClusterData.Costs.Init(GridHierarchy::Unreachable, NumNodes * NumNodes);
+	for (int32 From = 0; From < NumNodes; ++From)
+	{
+		SearchCluster(Walkable, Cluster, ClusterData.Nodes[From].Tile, Search);
+		for (int32 To = 0; To < NumNodes; ++To)
+		{
+			const int32 Tile = ClusterData.Nodes[To].Tile;
+			ClusterData.Costs[From * NumNodes + To] = Search.Distances[(Tile / NumColumns - Search.Rect.Min.X) * Search.Rect.Height() + Tile % NumColumns - Search.Rect.Min.Y];
+		}
+	}
+	ClusterData.bDirty = false;
+}
+
+/**
+ * @brief Dijkstra from a tile over the tiles of its cluster only, Parents hold the step back toward the source
+ */
+void FGridHierarchy::SearchCluster(const FGridBitset& Walkable, const int32 Cluster, const int32 Source, FClusterSearch& Search) const
+{
+	const FIntRect Rect = GetClusterRect(Cluster);
+	const int32 RectRows = Rect.Width();
+	const int32 RectColumns = Rect.Height();
+	Search.Rect = Rect;
+	Search.Distances.Init(GridHierarchy::Unreachable, RectRows * RectColumns);
+	Search.Parents.Init(GridHierarchy::NoParent, RectRows * RectColumns);
+	Search.Queue.Reset();
+
+	const int32 SourceLocal = (Source / NumColumns - Rect.Min.X) * RectColumns + Source % NumColumns - Rect.Min.Y;
+	Search.Distances[SourceLocal] = 0;
+	Search.Queue.HeapPush(TPair<uint32, int32>(0, SourceLocal), GridHierarchy::HeapPredicate);
+
+	while (Search.Queue.Num() > 0)
+	{
+		TPair<uint32, int32> Item;
+		Search.Queue.HeapPop(Item, GridHierarchy::HeapPredicate, EAllowShrinking::No);
+		if(Item.Key != Search.Distances[Item.Value]) continue;
+
+		const int32 LocalRow = Item.Value / RectColumns;
+		const int32 LocalColumn = Item.Value % RectColumns;
+		for (int32 Direction = 0; Direction < 8; ++Direction)
+		{
+			const FIntPoint Step = GridHierarchy::Steps[Direction];
+			const int32 NeighborRow = LocalRow + Step.X;
+			const int32 NeighborColumn = LocalColumn + Step.Y;
+			if(NeighborRow < 0 || NeighborRow >= RectRows || NeighborColumn < 0 || NeighborColumn >= RectColumns) continue;
+
+			const int32 Row = Rect.Min.X + LocalRow;
+			const int32 Column = Rect.Min.Y + LocalColumn;
+			if(!Walkable.Get((Row + Step.X) * NumColumns + Column + Step.Y)) continue;
+
+			// No corner cutting, the two orthogonal tiles are inside the cluster whenever the diagonal one is
+			const bool bDiagonal = Direction >= 4;
+			if(bDiagonal && (!Walkable.Get((Row + Step.X) * NumColumns + Column) || !Walkable.Get(Row * NumColumns + Column + Step.Y))) continue;
+
+			const int32 NeighborLocal = NeighborRow * RectColumns + NeighborColumn;
+			const uint32 Distance = Item.Key + (bDiagonal ? GridHierarchy::DiagonalCost : GridHierarchy::StraightCost);
+			if(Distance >= Search.Distances[NeighborLocal]) continue;
+
+			Search.Distances[NeighborLocal] = Distance;
+			Search.Parents[NeighborLocal] = Direction ^ 1;
+			Search.Queue.HeapPush(TPair<uint32, int32>(Distance, NeighborLocal), GridHierarchy::HeapPredicate);
+		}
+	}
+}
+
+int32 FGridHierarchy::FindNode(const int32 Cluster, const int32 Tile) const
+{
+	return Clusters[Cluster].Nodes.IndexOfByPredicate([Tile](const FNode& Node) { return Node.Tile == Tile; });
+}
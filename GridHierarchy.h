@@ -0,0 +1,108 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FGridBitset;
+
+/**
+ * Hierarchical pathfinding (HPA*) layer over the walk bitset.
+ * The grid is split into square clusters, walkable runs across each cluster border become entrances with one node
+ * on each side, and every cluster caches the cost between its nodes. Long queries search that small abstract graph
+ * and the result is refined one segment at a time inside a single cluster, refined node to node segments are cached.
+ * Walk changes only dirty the clusters and borders they touch, those are rebuilt on the next query.
+ * Moves are 8-connected without cutting corners like FGridPathfinder, paths are close to but not always optimal.
+ */
+class FGridHierarchy
+{
+public:
+	void Init(int32 InNumRows, int32 InNumColumns, int32 InClusterSize);
+	void Empty();
+
+	FORCEINLINE bool IsInitialized() const { return Clusters.Num() > 0; }
+	FORCEINLINE int32 GetClusterSize() const { return ClusterSize; }
+
+	/**
+	 * @brief Dirty the clusters overlapping the rect and the borders it touches
+	 * @param Tiles Min row/column included, Max excluded
+	 */
+	void MarkRectDirty(const FIntRect& Tiles);
+
+	/** Rebuild the dirty borders then the dirty clusters, clusters in parallel */
+	void Update(const FGridBitset& Walkable);
+
+	/**
+	 * @brief Search the abstract graph between two tiles, Update must have been called since the last change
+	 * @param OutWaypoints Tile indices from start to goal (both included), consecutive ones are in the same cluster or adjacent
+	 * @return false if a tile is blocked or the goal can't be reached
+	 */
+	bool FindAbstractPath(const FGridBitset& Walkable, int32 Start, int32 Goal, TArray<int32>& OutWaypoints);
+
+	/**
+	 * @brief Tiles between two consecutive waypoints
+	 * @param OutTiles Appended with the tiles after From up to To included
+	 */
+	bool RefineSegment(const FGridBitset& Walkable, int32 From, int32 To, TArray<int32>& OutTiles);
+
+	FORCEINLINE int32 NumClusters() const { return Clusters.Num(); }
+	int32 NumNodes() const;
+
+private:
+	struct FNode
+	{
+		int32 Tile = INDEX_NONE;
+
+		// Node on the other side of each border the tile lies on, a corner tile can face two clusters
+		int32 Partners[2] = {INDEX_NONE, INDEX_NONE};
+	};
+
+	struct FCluster
+	{
+		TArray<FNode> Nodes;
+
+		// Nodes.Num() squared costs between nodes, Unreachable if they are not connected inside the cluster
+		TArray<uint32> Costs;
+
+		// Refined tiles between two nodes, keyed From << 32 | To
+		TMap<uint64, TArray<int32>> Segments;
+		bool bDirty = true;
+	};
+
+	/** Single source search restricted to a cluster, distances and parents are indexed local to the cluster */
+	struct FClusterSearch
+	{
+		FIntRect Rect;
+		TArray<uint32> Distances;
+		TArray<uint8> Parents;
+		TArray<TPair<uint32, int32>> Queue;
+	};
+
+	FORCEINLINE int32 GetClusterOfTile(const int32 Tile) const
+	{
+		return (Tile / NumColumns / ClusterSize) * NumClusterColumns + (Tile % NumColumns) / ClusterSize;
+	}
+
+	FIntRect GetClusterRect(int32 Cluster) const;
+	void BuildBorder(const FGridBitset& Walkable, int32 ClusterA, int32 ClusterB, bool bRowBorder, TArray<FIntPoint>& OutTransitions) const;
+	void BuildCluster(const FGridBitset& Walkable, int32 Cluster, FClusterSearch& Search);
+	void SearchCluster(const FGridBitset& Walkable, int32 Cluster, int32 Source, FClusterSearch& Search) const;
+	int32 FindNode(int32 Cluster, int32 Tile) const;
+
+	int32 NumRows = 0;
+	int32 NumColumns = 0;
+	int32 ClusterSize = 16;
+	int32 NumClusterRows = 0;
+	int32 NumClusterColumns = 0;
+
+	TArray<FCluster> Clusters;
+
+	// Entrance tile pairs of each border, the first tile is in the upper/left cluster
+	// Row borders are between clusters (r, c) and (r + 1, c), column borders between (r, c) and (r, c + 1)
+	TArray<TArray<FIntPoint>> RowBorders;
+	TArray<TArray<FIntPoint>> ColumnBorders;
+	TBitArray<> DirtyRowBorders;
+	TBitArray<> DirtyColumnBorders;
+
+	FClusterSearch QuerySearch;
+};
@@ -0,0 +1,179 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#include "GridLineOfSight.h"
+
+#include "Async/ParallelFor.h"
+#include "GridTileStorage.h"
+
+namespace GridLineOfSight
+{
+	// Pairs below this are traced on the calling thread
+	constexpr int32 MinBatchSizeForWorkers = 64;
+
+	// Row and column transform of each octant, maps the (depth, offset) scan of the first octant onto the others
+	const int32 OctantTransforms[8][4] = {
+		{1, 0, 0, 1}, {0, 1, 1, 0}, {0, -1, 1, 0}, {-1, 0, 0, 1},
+		{-1, 0, 0, -1}, {0, -1, -1, 0}, {0, 1, -1, 0}, {1, 0, 0, -1}
+	};
+
+	FORCEINLINE bool IsInside(const FGridTileStorage& Storage, const FIntPoint& Tile)
+	{
+		return Tile.X >= 0 && Tile.X < Storage.GetNumRows() && Tile.Y >= 0 && Tile.Y < Storage.GetNumColumns();
+	}
+
+	/** Bresenham from From to To, both inside the grid so every tile in between is too */
+	bool TraceLine(const FGridTileStorage& Storage, const FIntPoint& From, const FIntPoint& To, const FGridTileFilter& Transparent, const bool bTestTarget, FIntPoint& OutHit)
+	{
+		const int32 DeltaRows = FMath::Abs(To.X - From.X);
+		const int32 DeltaColumns = -FMath::Abs(To.Y - From.Y);
+		const int32 RowStep = From.X < To.X ? 1 : -1;
+		const int32 ColumnStep = From.Y < To.Y ? 1 : -1;
+		const int32 NumColumns = Storage.GetNumColumns();
+
+		int32 Error = DeltaRows + DeltaColumns;
+		FIntPoint Tile = From;
+		while (Tile != To)
+		{
+			const int32 DoubleError = 2 * Error;
+			if(DoubleError >= DeltaColumns)
+			{
+				Error += DeltaColumns;
+				Tile.X += RowStep;
+			}
+			if(DoubleError <= DeltaRows)
+			{
+				Error += DeltaRows;
+				Tile.Y += ColumnStep;
+			}
+
+			if(Tile == To && !bTestTarget) return false;
+			if(!FGridTileQuery::PassesFilter(Storage, Tile.X * NumColumns + Tile.Y, Transparent))
+			{
+				OutHit = Tile;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	struct FShadowcast
+	{
+		const FGridTileStorage& Storage;
+		const FGridTileFilter& Transparent;
+		const TFunctionRef<void(int32 Index)>& Visitor;
+		FIntPoint Origin;
+		int32 Radius;
+
+		// Octants share their edge tiles, seen tiles of the (2 * Radius + 1) square are only visited once
+		TBitArray<> Seen;
+		int32 NumVisited = 0;
+
+		FShadowcast(const FGridTileStorage& InStorage, const FGridTileFilter& InTransparent, const TFunctionRef<void(int32 Index)>& InVisitor, const FIntPoint& InOrigin, const int32 InRadius)
+			: Storage(InStorage), Transparent(InTransparent), Visitor(InVisitor), Origin(InOrigin), Radius(InRadius)
+		{
+			Seen.Init(false, FMath::Square(2 * Radius + 1));
+		}
+
+		FORCEINLINE bool IsBlocking(const FIntPoint& Tile) const
+		{
+			return !IsInside(Storage, Tile) || !FGridTileQuery::PassesFilter(Storage, Tile.X * Storage.GetNumColumns() + Tile.Y, Transparent);
+		}
+
+		void Visit(const FIntPoint& Tile)
+		{
+			if(!IsInside(Storage, Tile)) return;
+
+			const int32 LocalIndex = (Tile.X - Origin.X + Radius) * (2 * Radius + 1) + Tile.Y - Origin.Y + Radius;
+			if(Seen[LocalIndex]) return;
+
+			Seen[LocalIndex] = true;
+			Visitor(Tile.X * Storage.GetNumColumns() + Tile.Y);
+			++NumVisited;
+		}
+
+		/** Scan the octant rows from Depth outward between the two slopes, a blocker splits the light into a deeper scan */
+		void CastLight(const int32 Depth, float StartSlope, const float EndSlope, const int32 (&Transform)[4])
+		{
+			if(StartSlope < EndSlope) return;
+
+			const int32 RadiusSquared = Radius * Radius;
+			float NextStartSlope = StartSlope;
+			for (int32 Distance = Depth; Distance <= Radius; ++Distance)
+			{
+				bool bBlocked = false;
+				const int32 DeltaY = -Distance;
+				for (int32 DeltaX = -Distance; DeltaX <= 0; ++DeltaX)
+				{
+					const float LeftSlope = (DeltaX - 0.5f) / (DeltaY + 0.5f);
+					const float RightSlope = (DeltaX + 0.5f) / (DeltaY - 0.5f);
+					if(StartSlope < RightSlope) continue;
+					if(EndSlope > LeftSlope) break;
+
+					const FIntPoint Tile(Origin.X + DeltaX * Transform[0] + DeltaY * Transform[1], Origin.Y + DeltaX * Transform[2] + DeltaY * Transform[3]);
+					if(DeltaX * DeltaX + DeltaY * DeltaY <= RadiusSquared) Visit(Tile);
+
+					const bool bTileBlocks = IsBlocking(Tile);
+					if(bBlocked)
+					{
+						if(bTileBlocks)
+						{
+							NextStartSlope = RightSlope;
+							continue;
+						}
+						bBlocked = false;
+						StartSlope = NextStartSlope;
+					}
+					else if(bTileBlocks && Distance < Radius)
+					{
+						bBlocked = true;
+						CastLight(Distance + 1, StartSlope, LeftSlope, Transform);
+						NextStartSlope = RightSlope;
+					}
+				}
+				if(bBlocked) break;
+			}
+		}
+	};
+}
+
+bool FGridLineOfSight::Raycast(const FGridTileStorage& Storage, const FIntPoint& From, const FIntPoint& To, const FGridTileFilter& Transparent, FIntPoint& OutHit)
+{
+	OutHit = From;
+	if(!GridLineOfSight::IsInside(Storage, From) || !GridLineOfSight::IsInside(Storage, To)) return true;
+
+	return GridLineOfSight::TraceLine(Storage, From, To, Transparent, true, OutHit);
+}
+
+bool FGridLineOfSight::HasLineOfSight(const FGridTileStorage& Storage, const FIntPoint& A, const FIntPoint& B, const FGridTileFilter& Transparent)
+{
+	if(!GridLineOfSight::IsInside(Storage, A) || !GridLineOfSight::IsInside(Storage, B)) return false;
+
+	FIntPoint Hit;
+	const bool bAFirst = A.X < B.X || (A.X == B.X && A.Y <= B.Y);
+	return !GridLineOfSight::TraceLine(Storage, bAFirst ? A : B, bAFirst ? B : A, Transparent, false, Hit);
+}
+
+void FGridLineOfSight::HasLineOfSightBatch(const FGridTileStorage& Storage, const TConstArrayView<FIntPoint> Origins, const TConstArrayView<FIntPoint> Targets, const FGridTileFilter& Transparent, const TArrayView<bool> OutVisible)
+{
+	check(Origins.Num() == Targets.Num() && OutVisible.Num() >= Origins.Num());
+
+	// Paged reads move pages in and out of residency, they stay on the calling thread
+	const bool bSingleThread = Storage.IsPaged() || Origins.Num() < GridLineOfSight::MinBatchSizeForWorkers;
+	ParallelFor(Origins.Num(), [&Storage, &Origins, &Targets, &Transparent, &OutVisible](const int32 i)
+	{
+		OutVisible[i] = HasLineOfSight(Storage, Origins[i], Targets[i], Transparent);
+	}, bSingleThread);
+}
+
+int32 FGridLineOfSight::ForEachVisibleTile(const FGridTileStorage& Storage, const FIntPoint& Origin, const int32 Radius, const FGridTileFilter& Transparent, const TFunctionRef<void(int32 Index)> Visitor)
+{
+	if(Radius < 0 || !GridLineOfSight::IsInside(Storage, Origin)) return 0;
+
+	GridLineOfSight::FShadowcast Shadowcast(Storage, Transparent, Visitor, Origin, Radius);
+	Shadowcast.Visit(Origin);
+	for (const int32 (&Transform)[4] : GridLineOfSight::OctantTransforms)
+	{
+		Shadowcast.CastLight(1, 1.0f, 0.0f, Transform);
+	}
+	return Shadowcast.NumVisited;
+}
@@ -0,0 +1,43 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GridTileQuery.h"
+
+struct FGridTileStorage;
+
+/**
+ * Line of sight and field of view over the tile flags, no collision scene involved.
+ * Sight goes through the tiles that pass the transparency filter, every other tile blocks it.
+ * Rays step tile to tile with Bresenham, fields of view use recursive shadowcasting.
+ */
+class FGridLineOfSight
+{
+public:
+	/**
+	 * @brief Step from From toward To and stop on the first tile that blocks sight, From itself is not tested
+	 * @param OutHit First blocking tile, To included
+	 * @return true if a tile blocked the ray
+	 */
+	static bool Raycast(const FGridTileStorage& Storage, const FIntPoint& From, const FIntPoint& To, const FGridTileFilter& Transparent, FIntPoint& OutHit);
+
+	/**
+	 * @brief Check that no tile strictly between A and B blocks sight, the end tiles may block and still be seen.
+	 * The ray is always traced from the lower index so A sees B exactly when B sees A
+	 */
+	static bool HasLineOfSight(const FGridTileStorage& Storage, const FIntPoint& A, const FIntPoint& B, const FGridTileFilter& Transparent);
+
+	/**
+	 * @brief HasLineOfSight for every pair, spread over the workers on dense grids
+	 * @param OutVisible One entry per pair, must be as large as Origins
+	 */
+	static void HasLineOfSightBatch(const FGridTileStorage& Storage, TConstArrayView<FIntPoint> Origins, TConstArrayView<FIntPoint> Targets, const FGridTileFilter& Transparent, TArrayView<bool> OutVisible);
+
+	/**
+	 * @brief Visit every tile seen from Origin within Radius tiles (Euclidean), the origin and blocking tiles that are seen included.
+	 * Every tile is visited once
+	 * @return Number of tiles visited
+	 */
+	static int32 ForEachVisibleTile(const FGridTileStorage& Storage, const FIntPoint& Origin, int32 Radius, const FGridTileFilter& Transparent, TFunctionRef<void(int32 Index)> Visitor);
+};
@@ -1,643 +1,2557 @@
-﻿// Copyright Rekt Studios. All Rights Reserved.
-
-#include "GridManager.h"
-
-#include "Kismet/KismetMathLibrary.h"
-#include "ProceduralMeshComponent.h"
-// #include "CryptoArena/CryptoArenaGameModeBase.h"
-#include "Kismet/GameplayStatics.h"
-#include "OptimizedGrid/OptimizedGridGameMode.h"
-
-AGridManager::AGridManager()
-{
-	// Actor never participate in Tick
-	PrimaryActorTick.bCanEverTick = false;
-
-	// Creating Components
-	const TObjectPtr<USceneComponent> DefaultSceneComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Scene Component"));
-	RootComponent = DefaultSceneComponent;
-
-	LineMesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("Lines Mesh"));
-	LineMesh->SetupAttachment(RootComponent);
-	LineMesh->SetRelativeLocation(FVector(0.0f, 0.0f, 0.4f));
-	
-	SelectionMesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("Selection Mesh"));
-	SelectionMesh->SetupAttachment(RootComponent);
-	SelectionMesh->SetRelativeLocation(FVector(0.0f, 0.0f, 0.3f));
-
-	NoWalkMesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("No Walk Mesh"));
-	NoWalkMesh->SetupAttachment(RootComponent);
-	NoWalkMesh->SetRelativeLocation(FVector(0.0f, 0.0f, 0.2f));
-
-	NoSpawnMesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("No Spawn Mesh"));
-	NoSpawnMesh->SetupAttachment(RootComponent);
-	NoSpawnMesh->SetRelativeLocation(FVector(0.0f, 0.0f, 0.1f));
-	
-	// Setting up Defaults
-	NumRows = 10;
-	NumColumns = 10;
-	TileSize = 100.0f;
-	LineThickness = 10.0f;
-	LineOpacity = 1.0f;
-	SelectionOpacity = 0.35f;
-	LineColor = FLinearColor::Green;
-	SelectionColor = FLinearColor::White;
-
-	static ConstructorHelpers::FObjectFinder<UMaterialInterface> Material(TEXT("/Script/Engine.Material'/Game/Art/Materials/M_Grid.M_Grid'"));
-	
-	if(Material.Object != nullptr)
-	{
-		MaterialInterface = Cast<UMaterialInterface>(Material.Object);
-	}
-
-	bStartingModifiersInitialized = false;
-}
-
-void AGridManager::OnConstruction(const FTransform& Transform)
-{
-	Super::OnConstruction(Transform);
-
-	// Create material instances for the meshes
-	const TObjectPtr<UMaterialInstanceDynamic> LinesMaterial = CreateMaterialInstance(LineColor, LineOpacity);
-	const TObjectPtr<UMaterialInstanceDynamic> SelectionMaterial = CreateMaterialInstance(SelectionColor, SelectionOpacity);
-	const TObjectPtr<UMaterialInstanceDynamic> NoWalkMaterial = CreateMaterialInstance(NoWalkColor, NoWalkOpacity);
-	const TObjectPtr<UMaterialInstanceDynamic> NoSpawnMaterial = CreateMaterialInstance(NoSpawnColor, NoSpawnOpacity);
-
-	TArray<FVector> LinesVertices;
-	TArray<int> LinesTriangles;
-
-	// Create vertices and triangles for horizontal lines
-	for (int i = 0; i < NumRows + 1; ++i)
-	{
-		const float LineStart = TileSize * i;
-		const float LineEnd = GetGridWidth();
-		CreateLine(FVector(LineStart, 0.0f, 0.0f), FVector(LineStart, LineEnd, 0.0f), LineThickness, LinesVertices, LinesTriangles);
-	}
-
-	// Create vertices and triangles for vertical lines
-	for (int i = 0; i < NumColumns + 1; ++i)
-	{
-		const float LineStart = TileSize * i;
-		const float LineEnd = GetGridHeight();
-		CreateLine(FVector(0.0f, LineStart, 0.0f), FVector(LineEnd, LineStart, 0.0f), LineThickness, LinesVertices, LinesTriangles);
-	}
-
-	// Create the lines mesh from vertices and triangles and set material
-	CreateMeshSection(LineMesh, LinesVertices, LinesTriangles);
-	LineMesh->SetMaterial(0, LinesMaterial);
-
-	TArray<FVector> SelectionVertices;
-	TArray<int> SelectionTriangles;
-
-	// Create a selection tile mesh and set material
-	CreateLine(FVector(0.0f, TileSize/2, 0.0f), FVector(TileSize, TileSize/2, 0.0f), TileSize, SelectionVertices, SelectionTriangles);
-	CreateMeshSection(SelectionMesh, SelectionVertices, SelectionTriangles);
-	SelectionMesh->SetMaterial(0, SelectionMaterial);
-	SelectionMesh->SetVisibility(false);
-	
-	// Create modifiers mesh and set material
-	TArray<FVector> NoWalkVertices;
-	TArray<int> NoWalkTriangles;
-	for (const auto TileMod : NoWalkingStartingTiles)
-	{
-		bool bValid;
-		
-		FVector StartingLocation = TileToGridLocation(TileMod.Row, TileMod.Column, bValid, false) - GetActorLocation();
-		if(!bValid) continue;
-		
-		CreateLine(FVector(StartingLocation.X, StartingLocation.Y + TileSize/2.0f, 0.0f), FVector(StartingLocation.X + TileSize, StartingLocation.Y + TileSize/2.0f, 0.0f), TileSize, NoWalkVertices, NoWalkTriangles);
-	}
-	
-	CreateMeshSection(NoWalkMesh, NoWalkVertices, NoWalkTriangles);
-	NoWalkMesh->SetMaterial(0, NoWalkMaterial);
-	
-	TArray<FVector> NoSpawnVertices;
-	TArray<int> NoSpawnTriangles;
-	for (const auto TileMod : NoSpawningStartingTiles)
-	{
-		bool bValid;
-		
-		FVector StartingLocation = TileToGridLocation(TileMod.Row, TileMod.Column, bValid, false) - GetActorLocation();
-		if(!bValid) continue;
-		
-		CreateLine(FVector(StartingLocation.X, StartingLocation.Y + TileSize/2, 0.0f), FVector(StartingLocation.X + TileSize, StartingLocation.Y + TileSize/2, 0.0f), TileSize, NoSpawnVertices, NoSpawnTriangles);
-	}
-	
-	CreateMeshSection(NoSpawnMesh, NoSpawnVertices, NoSpawnTriangles);
-	NoSpawnMesh->SetMaterial(0, NoSpawnMaterial);
-}
-
-void AGridManager::BeginPlay()
-{
-	Super::BeginPlay();
-
-	// TODO Comment This if you're moving to new project
-	// Singleton Reference to the GameMode
-	if(AOptimizedGridGameMode* ArenaGameMode = Cast<AOptimizedGridGameMode>(GetWorld()->GetAuthGameMode()); ArenaGameMode != nullptr)
-	{
-		if(ArenaGameMode->GetGridManager() == nullptr)
-		{
-			ArenaGameMode->SetGridManager(this);
-		}
-		else
-		{
-			Destroy();
-		}
-	}
-
-	// Generate Tile Info Array if Tile Number Changes
-	GenerateTileInfo();
-	
-	// Set Modifiers States to Tiles Info if not initialized or tile number changes
-	InitializeStartingTilesModifiers();
-}
-
-/**
- * @brief Sets The Starting tiles info from the Modifiers arrays 
- */
-void AGridManager::InitializeStartingTilesModifiers()
-{
-	if(bStartingModifiersInitialized) return;
-	
-	for (const auto TileMod : NoSpawningStartingTiles)
-	{
-		FTileInfo TileInfo;
-		TileInfo.bCanSpawnOn = false;
-		SetTileInfoAtPosition(TileMod.Row, TileMod.Column, TileInfo);
-	}
-
-	for (const auto TileMod: NoWalkingStartingTiles)
-	{
-		FTileInfo TileInfo;
-		TileInfo.bCanWalkOn = false;
-		SetTileInfoAtPosition(TileMod.Row, TileMod.Column, TileInfo);
-	}
-
-	bStartingModifiersInitialized = true;
-}
-
-/**
- * @brief Creates a Material Instance From Color and Opacity
- * @return Material Instance Dynamic
- */
-TObjectPtr<UMaterialInstanceDynamic> AGridManager::CreateMaterialInstance(const FLinearColor Color, const float Opacity)
-{
-	const TObjectPtr<UMaterialInstanceDynamic> Material = UMaterialInstanceDynamic::Create(MaterialInterface, this);
-	Material->SetVectorParameterValue(FName("Color"), Color);
-	Material->SetScalarParameterValue(FName("Opacity"), Opacity);
-	return Material;
-}
-
-/**
- * @brief Function To Overload Create Mesh Section parameters to only vertices and triangles. Target: procedural mesh component
- */
-void AGridManager::CreateMeshSection(UProceduralMeshComponent* ProceduralMesh, const TArray<FVector>& Vertices, const TArray<int>& Triangles)
-{
-	const TArray<FVector> Normals;
-	const TArray<FVector2D> UVs;
-	const TArray<FColor> Colors;
-	const TArray<FProcMeshTangent> Tangents;
-	ProceduralMesh->CreateMeshSection(0, Vertices, Triangles, Normals, UVs, Colors, Tangents, false);
-}
-
-/**
- * @brief Create a line mesh vertices and triangles
- * @param Start Start location of the line
- * @param End End location of the line
- * @param Thickness Line thickness
- * @param Vertices Array Reference to append to
- * @param Triangles Array Reference to append to
- */
-void AGridManager::CreateLine(const FVector& Start, const FVector& End, const float Thickness, TArray<FVector>& Vertices, TArray<int>& Triangles)
-{
-	FVector Direction = End - Start;
-	Direction.Normalize();
-	const FVector ThicknessDirection = UKismetMathLibrary::Cross_VectorVector(Direction, FVector::UpVector);
-	const float HalfThickness = Thickness / 2;
-
-	const int VerticesCount = Vertices.Num();
-	TArray<int> NewTriangles;
-	NewTriangles.Add(VerticesCount+2);
-	NewTriangles.Add(VerticesCount+1);
-	NewTriangles.Add(VerticesCount+0);
-	NewTriangles.Add(VerticesCount+2);
-	NewTriangles.Add(VerticesCount+3);
-	NewTriangles.Add(VerticesCount+1);
-	Triangles.Append(NewTriangles);
-
-	TArray<FVector> NewVertices;
-	NewVertices.Add(Start + ThicknessDirection * HalfThickness);
-	NewVertices.Add(End + ThicknessDirection * HalfThickness);
-	NewVertices.Add(Start - ThicknessDirection * HalfThickness);
-	NewVertices.Add(End -	 ThicknessDirection * HalfThickness);
-	Vertices.Append(NewVertices);
-}
-
-bool AGridManager::GetTileInReferenceToTile(const int InRow, const int InColumn, const int RowOffset, const int ColOffset, FVector& OutLocation, FTileInfo& TileInfo, bool bConsiderRotation, FRotator Rotation)
-{
-	bool bValidTile;
-	const FVector TileLocation = TileToGridLocation(InRow, InColumn, bValidTile);
-	if(!bValidTile) return false;
-	
-	FVector Offset = FVector(TileSize * RowOffset, TileSize * ColOffset, 0.0f);
-	if(bConsiderRotation) Offset = UKismetMathLibrary::Quat_RotateVector(Rotation.Quaternion(), Offset);
-
-	int OutRow, OutColumn;
-	LocationToTile(Offset+TileLocation, OutRow, OutColumn, bValidTile);
-	if(!bValidTile) return false;
-
-	TileInfo = GetTileInfoAtPositionWithLocation(OutRow, OutColumn, OutLocation, bValidTile);
-	
-	return bValidTile;
-}
-
-bool AGridManager::GetTileInReferenceToLocation(const FVector Location, const int RowOffset, const int ColOffset, FVector& OutLocation, FTileInfo& TileInfo, bool bConsiderRotation, FRotator Rotation)
-{
-	int Row, Column;
-	bool bValid; 
-	LocationToTile(Location, Row, Column, bValid);
-	if(!bValid) return false;
-	
-	return GetTileInReferenceToTile(Row, Column, RowOffset, ColOffset, OutLocation, TileInfo, bConsiderRotation, Rotation);
-}
-
-/**
- * @brief Function for checking if Row and Column are in the Grid Range
- * @return Boolean
- */
-bool AGridManager::IsValidTile(const int Row, const int Column) const
-{
-	return Row >= 0 && Row < NumRows && Column >= 0 && Column < NumColumns;
-}
-
-/**
- * @brief Function for checking if Row and Column are in the Grid Range and tile is walkable
- * @return Boolean
- */
-bool AGridManager::IsValidWalkTile(const int Row, const int Column) const
-{
-	bool bValid;
-	return IsValidTile(Row, Column) && GetTileInfoAtPositionCopy(Row, Column, bValid).bCanWalkOn;
-}
-
-/**
- * @brief Function for checking if Row and Column are in the Grid Range and tile is spawn free
- * @return Boolean
- */
-bool AGridManager::IsValidSpawnTile(int Row, int Column) const
-{
-	bool bValid;
-	return IsValidTile(Row, Column) && GetTileInfoAtPositionCopy(Row, Column, bValid).bCanSpawnOn;
-}
-
-/**
- * @brief Mapping from world location to tile row and column
- * @param Location World Location
- * @param RowOut Tile row Mapped
- * @param ColumnOut Tile column Mapped
- * @param bValid Location is in Grid Range
- */
-void AGridManager::LocationToTile(const FVector Location, int& RowOut, int& ColumnOut, bool& bValid) const
-{
-	const FVector ActorLocation = GetActorLocation();
-	RowOut = UKismetMathLibrary::FFloor((Location.X-ActorLocation.X)/GetGridWidth()*NumColumns);
-	ColumnOut = UKismetMathLibrary::FFloor((Location.Y-ActorLocation.Y)/GetGridHeight()*NumRows);
-	bValid = IsValidTile(RowOut, ColumnOut);
-}
-
-bool AGridManager::TakeTileSpace(AActor* Actor, bool bAffectWalkable)
-{
-	int Row, Column;
-	bool bValid;
-	LocationToTile(Actor->GetActorLocation(), Row, Column, bValid);
-
-	if(!bValid)
-	{
-		return false;
-	}
-
-	FTileInfo TileInfo = GetTileInfoAtPositionCopy(Row, Column, bValid);
-
-	if(TileInfo.Position.X < 0 || TileInfo.Position.Y < 0)
-	{
-		return false;
-	}
-
-	TileInfo.bCanSpawnOn = false;
-	TileInfo.bCanWalkOn = bAffectWalkable? false : TileInfo.bCanWalkOn;
-	TileInfo.ActorOnTile = Actor;
-	return SetTileInfoAtPosition(Row, Column, TileInfo);
-}
-
-FVector AGridManager::LocationToGridLocation(FVector Location, bool& bValid)
-{
-	int Row, Column;
-	LocationToTile(Location, Row, Column, bValid);
-	return TileToGridLocation(Row, Column, bValid);
-}
-
-AActor* AGridManager::SpawnActorOnGrid(const TSubclassOf<AActor> ActorClass, const int Row, const int Column, bool& bSpawned, const FTransform SpawnTransform, const bool bCenter, const bool bAffectWalkable)
-{
-	if (!IsValid(ActorClass))
-	{
-		UE_LOG(LogTemp, Warning, TEXT("%s() Invalid Actor Spawn Class"), *FString(__FUNCTION__))
-		return nullptr;
-	}
-	
-	if (const UWorld* Level = GetWorld(); IsValid(Level))
-	{
-		bool bTileValid;
-		const FVector SpawnLocation = TileToSpawnGridLocation(Row, Column, bTileValid, bCenter, SpawnTransform.GetLocation());
-
-		if(!bTileValid)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("%s() Tile (%d, %d) is Invalid"), *FString(__FUNCTION__), Row, Column);
-			bSpawned = false;
-			return nullptr;
-		}
-
-		FTransform ActorSpawnTransform;
-		ActorSpawnTransform.SetLocation(SpawnLocation);
-		ActorSpawnTransform.SetRotation(SpawnTransform.GetRotation());
-		ActorSpawnTransform.SetScale3D(SpawnTransform.GetScale3D());
-
-		AActor* SpawnedActor = UGameplayStatics::BeginDeferredActorSpawnFromClass(this, ActorClass, SpawnTransform, ESpawnActorCollisionHandlingMethod::AlwaysSpawn, nullptr, ESpawnActorScaleMethod::OverrideRootScale);
-		if(SpawnedActor != nullptr)
-		{
-			SpawnedActor->FinishSpawning(ActorSpawnTransform);
-			bSpawned = true;
-			bool bValid;
-			FTileInfo TileInfo = GetTileInfoAtPositionCopy(Row, Column, bValid);
-			TileInfo.bCanSpawnOn = false;
-			TileInfo.bCanWalkOn = bAffectWalkable? false : TileInfo.bCanWalkOn;
-			TileInfo.ActorOnTile = SpawnedActor;
-			SetTileInfoAtPosition(Row, Column, TileInfo);
-		}
-		return SpawnedActor;
-	}
-
-	UE_LOG(LogTemp, Warning, TEXT("%s() No Level To Spawn"), *FString(__FUNCTION__));
-	return nullptr;
-}
-
-/**
- * @brief Mapping from grid row and column to world location
- * @param Row Tile row position
- * @param Column Tile column position
- * @param bValid Row and column are in grid range
- * @param bCenter Get the center location of the tile or the bottom left corner if false 
- * @param Offset Offset vector to Add to the end location
- * @return Tile Location (center/corner) + offset
- */
-FVector AGridManager::TileToGridLocation(const int Row, const int Column, bool& bValid, const bool bCenter, const FVector Offset) const
-{
-	const FVector ActorLocation = GetActorLocation();
-	
-	bValid = IsValidTile(Row, Column);
-	FVector GridLocation;
-	GridLocation.X = bCenter? Row * TileSize + ActorLocation.X + (TileSize / 2) : Row * TileSize + ActorLocation.X;
-	GridLocation.Y = bCenter? Column * TileSize + ActorLocation.Y +(TileSize / 2) : Column * TileSize + ActorLocation.Y;
-	GridLocation = GridLocation + Offset;
-	return GridLocation;
-}
-
-/**
- * @brief Mapping from grid row and column to world location
- * @param Row Tile row position
- * @param Column Tile column position
- * @param bValid Row and column are in grid range and tile is walkable
- * @param bCenter Get the center location of the tile or the bottom left corner if false 
- * @param Offset Offset vector to Add to the end location
- * @return Tile Location (center/corner) + offset
- */
-FVector AGridManager::TileToWalkGridLocation(const int Row, const int Column, bool& bValid, const bool bCenter, const FVector Offset) const
-{
-	const FVector ActorLocation = GetActorLocation();
-	
-	bValid = IsValidWalkTile(Row, Column);
-	FVector GridLocation;
-	GridLocation.X = bCenter? Row * TileSize + ActorLocation.X + (TileSize / 2) : Row * TileSize + ActorLocation.X;
-	GridLocation.Y = bCenter? Column * TileSize + ActorLocation.Y +(TileSize / 2) : Column * TileSize + ActorLocation.Y;
-	GridLocation = GridLocation + Offset;
-	return GridLocation;
-}
-
-/**
- * @brief Mapping from grid row and column to world location
- * @param Row Tile row position
- * @param Column Tile column position
- * @param bValid Row and column are in grid range and tile is spawn free
- * @param bCenter Get the center location of the tile or the bottom left corner if false 
- * @param Offset Offset vector to Add to the end location
- * @return Tile Location (center/corner) + offset
- */
-FVector AGridManager::TileToSpawnGridLocation(const int Row, const int Column, bool& bValid, const bool bCenter, const FVector Offset) const
-{
-	const FVector ActorLocation = GetActorLocation();
-	
-	bValid = IsValidSpawnTile(Row, Column);
-	FVector GridLocation;
-	GridLocation.X = bCenter? Row * TileSize + ActorLocation.X + (TileSize / 2) : Row * TileSize + ActorLocation.X;
-	GridLocation.Y = bCenter? Column * TileSize + ActorLocation.Y +(TileSize / 2) : Column * TileSize + ActorLocation.Y;
-	GridLocation = GridLocation + Offset;
-	return GridLocation;
-}
-
-/**
- * @brief Set selected tile mesh to location of the tile
- * @param Row Selected tile row
- * @param Column Selected tile column
- */
-void AGridManager::SetSelectedTile(const int Row, const int Column) const
-{
-	bool bValid;
-	const FVector Location = TileToGridLocation(Row, Column, bValid, false);
-	
-	if(bValid)
-	{
-		SelectionMesh->SetWorldLocation(FVector(Location.X, Location.Y, SelectionMesh->GetComponentLocation().Z));
-	}
-
-	SelectionMesh->SetVisibility(bValid);
-}
-
-/**
- * @return true if tiles info array is equal to the number of tiles
- */
-bool AGridManager::IsGridInfoInitialized() const
-{
-	return TilesInfo.Num() == NumColumns * NumRows;
-}
-
-/**
- * @brief Clear then Populate Tiles Info Array if grid info array is not the right size (already initialized)
- */
-void AGridManager::GenerateTileInfo()
-{
-	if(IsGridInfoInitialized()) return;
-	
-	// Fill tiles info array
-	bStartingModifiersInitialized = false;
-	TilesInfo.Empty();
-	for (int i = 0; i < NumRows; ++i)
-	{
-		for (int j = 0; j < NumColumns; ++j)
-		{
-			TilesInfo.Add(FTileInfo(i, j));
-		}
-	}
-}
-
-/**
- * @brief Get Tile info at Index
- * @param Index index in array
- * @return FTileInfo(-1, -1) if index out of range or array not initialized
- */
-FTileInfo AGridManager::GetTileInfoAtIndexCopy(const int Index) const
-{
-	if(!IsGridInfoInitialized())
-	{
-		UE_LOG(LogTemp, Error, TEXT("%s() Tiles info array not initialized"), *FString(__FUNCTION__));
-		return FTileInfo(-1, -1);
-	}
-	
-	if(Index < 0 || Index > TilesInfo.Num()-1)
-	{
-		UE_LOG(LogTemp, Error, TEXT("%s() Index out of bound"), *FString(__FUNCTION__));
-		return FTileInfo(-1, -1);
-	}
-
-	return TilesInfo[Index];
-}
-
-/**
- * @brief Set Tile Info at Index
- * @param Index index in array
- * @param TileInfoIn Tile Info to Set
- * @return false if index out of range or array not initialized
- */
-bool AGridManager::SetTileInfoAtIndex(const int Index, const FTileInfo TileInfoIn)
-{
-	if(!IsGridInfoInitialized())
-	{
-		UE_LOG(LogTemp, Error, TEXT("%s() Tiles info array not initialized"), *FString(__FUNCTION__));
-		return false;
-	}
-	
-	if(Index < 0 || Index > TilesInfo.Num()-1)
-	{
-		UE_LOG(LogTemp, Error, TEXT("%s() Index out of bound"), *FString(__FUNCTION__));
-		return false;
-	}
-
-	TilesInfo[Index].bCanWalkOn = TileInfoIn.bCanWalkOn;
-	TilesInfo[Index].bCanSpawnOn = TileInfoIn.bCanSpawnOn;
-	TilesInfo[Index].ActorOnTile = TileInfoIn.ActorOnTile;
-	return true;
-}
-
-/**
- * @brief Get Tile Info of position Row, Column Complexity O(1)
- * @param Row starting 0
- * @param Column starting 0
- * @return FTileInfo(-1, -1) if position out of range or array not initialized
- */
-FTileInfo AGridManager::GetTileInfoAtPositionCopy(const int Row, const int Column, bool& bValid) const
-{
-	if(!IsGridInfoInitialized())
-	{
-		UE_LOG(LogTemp, Error, TEXT("%s() Tiles info array not initialized in"), *FString(__FUNCTION__));
-		bValid = false;
-		return FTileInfo(-1, -1);
-	}
-	
-	if(!IsValidTile(Row, Column))
-	{
-		UE_LOG(LogTemp, Error, TEXT("%s() Position out of grid range"), *FString(__FUNCTION__));
-		bValid = false;
-		return FTileInfo(-1, -1);
-	}
-	
-	const int Index = Row * NumColumns + Column;
-	bValid = true;
-	return TilesInfo[Index];
-}
-
-FTileInfo AGridManager::GetTileInfoAtPositionWithLocation(const int Row, const int Column, FVector& TileLocation,  bool& bValid) const
-{
-	TileLocation = TileToGridLocation(Row, Column, bValid);
-	return GetTileInfoAtPositionCopy(Row, Column, bValid);
-}
-
-/**
- * @brief Set the Tile Info of position Row, Column Complexity O(1)
- * @param Row starting 0
- * @param Column starting 0
- * @param TileInfoIn Tile Info to Set 
- * @return false if position out of range or array not initialized
- */
-bool AGridManager::SetTileInfoAtPosition(const int Row, const int Column, const FTileInfo TileInfoIn)
-{
-	if(!IsGridInfoInitialized())
-	{
-		UE_LOG(LogTemp, Error, TEXT("%s() Tiles info array not initialized"), *FString(__FUNCTION__));
-		return false;
-	}
-	
-	if(!IsValidTile(Row, Column))
-	{
-		UE_LOG(LogTemp, Error, TEXT("%s() Position out of grid range"), *FString(__FUNCTION__));
-		return false;
-	}
-	
-	const int Index = Row * NumRows + Column;
-	TilesInfo[Index].bCanWalkOn = TileInfoIn.bCanWalkOn;
-	TilesInfo[Index].bCanSpawnOn = TileInfoIn.bCanSpawnOn;
-	TilesInfo[Index].ActorOnTile = TileInfoIn.ActorOnTile;
-	return true;
-}
-
-void AGridManager::GetGridRowsAndColumns(int& Row, int& Column) const
-{
-	Row = NumRows;
-	Column = NumColumns;
-}
-
-TArray<FTileInfo> AGridManager::GetNeighboringTiles(const int Row, const int Column, const int NeighboringRows, const int NeighboringColumns)
-{
-	TArray<FTileInfo> Neighbors;
-	for (int i = Row - NeighboringRows; i <= Row + NeighboringRows; i++)
-	{
-		for (int j = Column - NeighboringColumns; j <= Column + NeighboringColumns; j++)
-		{
-			bool bValid;
-			const FTileInfo WalkableTile = GetTileInfoAtPositionCopy(i, j, bValid);
-
-			if (WalkableTile.bCanWalkOn)
-			{
-				FTileInfo TileInfo = FTileInfo(i, j);
-				Neighbors.Add(TileInfo);
-			}
-			
-		}
-	}
-	return Neighbors;
-}
-
-void AGridManager::DisplayDebugInfoOnTile(const FVector& Location) const
-{
-	static const auto CVarGrid = IConsoleManager::Get().FindConsoleVariable(TEXT("ShowDebugGrid"));
-
-	if(CVarGrid->GetInt() != 0)
-	{
-		int Row, Column;
-		bool bValid;
-		LocationToTile(Location, Row, Column, bValid);
-		if(bValid)
-		{
-			const FVector TileLocation = TileToGridLocation(Row, Column, bValid, true, FVector(0, 0, 10.0f));
-			const FTileInfo TileInfo = GetTileInfoAtPositionCopy(Row, Column,bValid);
-			DrawDebugString(GetWorld(), TileLocation, FString::Printf(TEXT("X: %d \nY: %d \nWalkable %s \nSpawnable %s \n%s"), TileInfo.Position.X, TileInfo.Position.Y, TileInfo.bCanWalkOn ? *FString("True") : *FString("False"), TileInfo.bCanSpawnOn ? *FString("True") : *FString("False"), *GetNameSafe(TileInfo.ActorOnTile)), nullptr, FColor::White, 4.f);
-		}
-	}
-}
+// Copyright Rekt Studios. All Rights Reserved.
+
+#include "GridManager.h"
+
+#include "GridStateFile.h"
+#include "GridStats.h"
+#include "Engine/Texture2D.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Net/UnrealNetwork.h"
+#include "ProceduralMeshComponent.h"
+#include "TextureResource.h"
+// #include "CryptoArena/CryptoArenaGameModeBase.h"
+#include "Kismet/GameplayStatics.h"
+#include "OptimizedGrid/OptimizedGridGameMode.h"
+
+namespace GridSurfaceParameters
+{
+	static const FName TileState(TEXT("TileState"));
+	static const FName TileSize(TEXT("TileSize"));
+	static const FName LineThickness(TEXT("LineThickness"));
+	static const FName GridRows(TEXT("GridRows"));
+	static const FName GridColumns(TEXT("GridColumns"));
+	static const FName LineColor(TEXT("LineColor"));
+	static const FName LineOpacity(TEXT("LineOpacity"));
+	static const FName SelectionColor(TEXT("SelectionColor"));
+	static const FName SelectionOpacity(TEXT("SelectionOpacity"));
+	static const FName SelectedTile(TEXT("SelectedTile"));
+	static const FName NoWalkColor(TEXT("NoWalkColor"));
+	static const FName NoWalkOpacity(TEXT("NoWalkOpacity"));
+	static const FName NoSpawnColor(TEXT("NoSpawnColor"));
+	static const FName NoSpawnOpacity(TEXT("NoSpawnOpacity"));
+}
+
+static TAutoConsoleVariable<bool> CVarGridLogConstructionTime(
+	TEXT("Grid.LogConstructionTime"),
+	false,
+	TEXT("Log the time spent building the grid meshes in OnConstruction"));
+
+AGridManager::AGridManager()
+{
+	// Actor only ticks while deferred grid work is pending
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
+	// Tile writes of the server reach every client wherever their pawns are
+	bReplicates = true;
+	bAlwaysRelevant = true;
+
+	// Creating Components
+	const TObjectPtr<USceneComponent> DefaultSceneComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Scene Component"));
+	RootComponent = DefaultSceneComponent;
+
+	LineMesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("Lines Mesh"));
+	LineMesh->SetupAttachment(RootComponent);
+	LineMesh->SetRelativeLocation(FVector(0.0f, 0.0f, 0.4f));
+	
+	SelectionMesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("Selection Mesh"));
+	SelectionMesh->SetupAttachment(RootComponent);
+	SelectionMesh->SetRelativeLocation(FVector(0.0f, 0.0f, 0.3f));
+
+	NoWalkMesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("No Walk Mesh"));
+	NoWalkMesh->SetupAttachment(RootComponent);
+	NoWalkMesh->SetRelativeLocation(FVector(0.0f, 0.0f, 0.2f));
+
+	NoSpawnMesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("No Spawn Mesh"));
+	NoSpawnMesh->SetupAttachment(RootComponent);
+	NoSpawnMesh->SetRelativeLocation(FVector(0.0f, 0.0f, 0.1f));
+
+	SurfaceMesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("Surface Mesh"));
+	SurfaceMesh->SetupAttachment(RootComponent);
+	SurfaceMesh->SetRelativeLocation(FVector(0.0f, 0.0f, 0.4f));
+	
+	// Setting up Defaults
+	NumRows = 10;
+	NumColumns = 10;
+	TileSize = 100.0f;
+	LineThickness = 10.0f;
+	LineOpacity = 1.0f;
+	SelectionOpacity = 0.35f;
+	LineColor = FLinearColor::Green;
+	SelectionColor = FLinearColor::White;
+	RenderMode = EGridRenderMode::LineMesh;
+
+	static ConstructorHelpers::FObjectFinder<UMaterialInterface> Material(TEXT("/Script/Engine.Material'/Game/Art/Materials/M_Grid.M_Grid'"));
+	
+	if(Material.Object != nullptr)
+	{
+		MaterialInterface = Cast<UMaterialInterface>(Material.Object);
+	}
+
+	LineChunkSize = 64;
+	OverlayChunkSize = 32;
+	MaxPathQueriesPerFrame = 64;
+	SightBlockingValue = 0.0f;
+	HierarchicalClusterSize = 16;
+	HierarchicalPathMinDistance = 128;
+	bPagedTiles = false;
+	TilePageSize = 64;
+	MaxResidentTilePages = 4096;
+	StreamingRadius = 0;
+	PagedPathMargin = 32;
+	bReplicateTiles = true;
+	GenerationSeed = 0;
+
+	bStartingModifiersInitialized = false;
+}
+
+void AGridManager::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+	GRID_STAT_SCOPE(Construction);
+	GRID_STAT_TILES(Construction, NumRows * NumColumns);
+
+	const double ConstructionStartTime = FPlatformTime::Seconds();
+
+	// Create material instances for the meshes
+	LinesMaterial = CreateMaterialInstance(LineColor, LineOpacity);
+	const TObjectPtr<UMaterialInstanceDynamic> SelectionMaterial = CreateMaterialInstance(SelectionColor, SelectionOpacity);
+	NoWalkOverlayMaterial = CreateMaterialInstance(NoWalkColor, NoWalkOpacity);
+	NoSpawnOverlayMaterial = CreateMaterialInstance(NoSpawnColor, NoSpawnOpacity);
+
+	SelectionMesh->SetVisibility(false);
+
+	if(RenderMode == EGridRenderMode::Material)
+	{
+		// Lines, selection and modifiers are all drawn by the surface material
+		ClearLineChunks();
+		SelectionMesh->ClearAllMeshSections();
+		NoWalkMesh->ClearAllMeshSections();
+		NoSpawnMesh->ClearAllMeshSections();
+		BuildSurface();
+	}
+	else
+	{
+		SurfaceMesh->ClearAllMeshSections();
+		TileStateTexture = nullptr;
+		TileStateTexels.Empty();
+
+		// Create the lines mesh chunks that changed and set material
+		UpdateLineChunks();
+
+		// Create a selection tile mesh and set material
+		MeshBuilder.Reset(1);
+		MeshBuilder.AddLine(FVector(0.0f, TileSize/2, 0.0f), FVector(TileSize, TileSize/2, 0.0f), TileSize);
+		CreateMeshSection(SelectionMesh, MeshBuilder.Vertices, MeshBuilder.Triangles);
+		SelectionMesh->SetMaterial(0, SelectionMaterial);
+
+		// Create modifiers meshes, one section per overlay chunk. Paged grids are too large for overlays
+		if(!bPagedTiles)
+		{
+			RebuildOverlays();
+		}
+	}
+
+	if(CVarGridLogConstructionTime.GetValueOnGameThread())
+	{
+		UE_LOG(LogTemp, Log, TEXT("%s() %dx%d grid built in %.3f ms"), *FString(__FUNCTION__), NumRows, NumColumns, (FPlatformTime::Seconds() - ConstructionStartTime) * 1000.0);
+	}
+}
+
+void AGridManager::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+	ReplicatedTiles.Owner = this;
+}
+
+void AGridManager::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	DOREPLIFETIME(AGridManager, ReplicatedTiles);
+}
+
+void AGridManager::BeginPlay()
+{
+	Super::BeginPlay();
+	FGridStats::RegisterFrameHook();
+
+	// TODO Comment This if you're moving to new project
+	// Singleton Reference to the GameMode
+	if(AOptimizedGridGameMode* ArenaGameMode = Cast<AOptimizedGridGameMode>(GetWorld()->GetAuthGameMode()); ArenaGameMode != nullptr)
+	{
+		if(ArenaGameMode->GetGridManager() == nullptr)
+		{
+			ArenaGameMode->SetGridManager(this);
+		}
+		else
+		{
+			Destroy();
+		}
+	}
+
+	// Line chunk components are transient, recreate them if the level was loaded or duplicated
+	if(RenderMode == EGridRenderMode::LineMesh)
+	{
+		UpdateLineChunks();
+	}
+
+	// Generate Tile Info Array if Tile Number Changes
+	GenerateTileInfo();
+	
+	// Set Modifiers States to Tiles Info if not initialized or tile number changes
+	InitializeStartingTilesModifiers();
+
+	// Clients built the same starting tiles, the server only sends what is written from now on
+	if(bReplicateTiles && !TileStorage.IsPaged())
+	{
+		if(GetNetMode() == NM_ListenServer || GetNetMode() == NM_DedicatedServer)
+		{
+			ReplicatedTiles.StartTracking(TileStorage.Num());
+		}
+		else if(GetNetMode() == NM_Client)
+		{
+			ApplyReplicatedChunks();
+		}
+	}
+
+	// Tile state texture is transient and now mirrors the tiles info instead of the starting modifiers
+	if(RenderMode == EGridRenderMode::Material)
+	{
+		BuildSurface();
+	}
+
+	if(IsStreamingAroundPlayer())
+	{
+		SetActorTickEnabled(true);
+	}
+}
+
+void AGridManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Worker tasks reference the scheduler, wait for them before the actor goes away
+	PathQueryScheduler.Reset();
+	FlowFields.Reset();
+	TileDeltas.Reset();
+
+	// Readers still holding the snapshots keep them alive until they release them
+	TileSnapshots.Reset();
+
+	// By key, actors already destroyed still leave their tile
+	TMap<TObjectKey<AActor>, FGridTrackedActor> RemainingActors = MoveTemp(TrackedActors);
+	TrackedActors.Reset();
+	for (const TPair<TObjectKey<AActor>, FGridTrackedActor>& Pair : RemainingActors)
+	{
+		ReleaseTrackedActor(Pair.Value.Actor.Get(), Pair.Key, Pair.Value);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AGridManager::Tick(const float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if(IsStreamingAroundPlayer())
+	{
+		if(const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0); PlayerPawn != nullptr)
+		{
+			StreamTilesAround(PlayerPawn->GetActorLocation(), StreamingRadius);
+		}
+	}
+
+	PathQueryScheduler.Tick(TileStorage, MaxPathQueriesPerFrame, TileStorage.GetAttributes().FindLayer(PathCostLayer), PagedPathMargin);
+	FlowFields.Tick(TileStorage);
+
+	// Flushed after the path callbacks so the tiles they write go out this tick
+	FlushTileDeltas();
+	if(ReplicatedTiles.HasDirtyChunks()) ReplicatedTiles.Flush(TileStorage);
+	RebuildDirtyOverlayChunks();
+	UploadDirtyTileStateTexels();
+
+	// Published last so the version holds every write of this tick, retried next tick while readers pin every slot
+	if(TileSnapshots.IsValid() && TileSnapshots->HasChanges()) TileSnapshots->Publish(TileStorage);
+
+	// Change listeners may have written tiles during the flush, the tick stays on until those are flushed too
+	if(!HasDeferredWork())
+	{
+		SetActorTickEnabled(false);
+	}
+}
+
+bool AGridManager::IsStreamingAroundPlayer() const
+{
+	return TileStorage.IsPaged() && StreamingRadius > 0;
+}
+
+/**
+ * @brief Everything the tick still has to flush or finish, the tick turns itself off once none is left
+ */
+bool AGridManager::HasDeferredWork() const
+{
+	return IsStreamingAroundPlayer()
+		|| PathQueryScheduler.HasPendingWork()
+		|| FlowFields.HasPendingWork(TileStorage)
+		|| TileDeltas.HasChanges()
+		|| ReplicatedTiles.HasDirtyChunks()
+		|| DirtyOverlayChunks.Num() > 0
+		|| DirtyTileStateTexels.Num() > 0 || bTileStateTextureDirty
+		|| (TileSnapshots.IsValid() && TileSnapshots->HasChanges());
+}
+
+/**
+ * @brief Write the walk and spawn flags and the attribute layers to a binary file
+ * @param bRunLength Store the flags as runs, much smaller when blocked tiles come in large areas
+ */
+bool AGridManager::ExportGridState(const FString& FilePath, const bool bRunLength) const
+{
+	if(!IsGridInfoInitialized())
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s() Grid info is not initialized"), *FString(__FUNCTION__));
+		return false;
+	}
+	return FGridStateFile::Save(TileStorage, FilePath, bRunLength);
+}
+
+/**
+ * @brief Replace the tile flags and attribute layers with a file written by ExportGridState for a grid of the same size
+ */
+bool AGridManager::ImportGridState(const FString& FilePath)
+{
+	if(!IsGridInfoInitialized())
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s() Grid info is not initialized"), *FString(__FUNCTION__));
+		return false;
+	}
+
+	// Release the claims first so the restored flags are not overwritten with the ones they remembered
+	for (const TPair<int, FGridTileClaim>& Pair : TileClaims)
+	{
+		TileStorage.SetCanWalkOn(Pair.Key, Pair.Value.bWasWalkable);
+		TileStorage.SetCanSpawnOn(Pair.Key, Pair.Value.bWasSpawnable);
+	}
+	TileClaims.Reset();
+
+	const bool bLoaded = FGridStateFile::Load(TileStorage, FilePath);
+	ReplaceTrackedActors();
+
+	// The released and claimed tiles were written around the change path, a failed load still released them
+	RecordAllTilesChanged(EGridTileField::Walkable | EGridTileField::Spawnable | EGridTileField::Occupant);
+	OnTilesFlagsChanged(FIntRect(0, 0, NumRows, NumColumns));
+	return bLoaded;
+}
+
+/**
+ * @brief Bring the tile pages around a location back into memory ahead of use on a paged grid
+ */
+void AGridManager::StreamTilesAround(const FVector Location, const int RadiusTiles)
+{
+	if(!TileStorage.IsPaged()) return;
+
+	int Row, Column;
+	bool bValid;
+	LocationToTile(Location, Row, Column, bValid);
+	TileStorage.GetPages().StreamIn(FIntRect(Row - RadiusTiles, Column - RadiusTiles, Row + RadiusTiles + 1, Column + RadiusTiles + 1));
+}
+
+/**
+ * @brief Sets The Starting tiles info from the Modifiers arrays, each array is applied as one masked batch
+ */
+void AGridManager::InitializeStartingTilesModifiers()
+{
+	if(bStartingModifiersInitialized) return;
+
+	// Whole grid masks would defeat paging, modifiers are few so they are written one by one
+	if(TileStorage.IsPaged())
+	{
+		if(GenerationRules.Num() > 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s() Generation rules are not applied on paged grids"), *FString(__FUNCTION__));
+		}
+		for (const auto TileMod : NoWalkingStartingTiles)
+		{
+			if(IsValidTile(TileMod.Row, TileMod.Column)) TileStorage.SetCanWalkOn(GetTileIndex(TileMod.Row, TileMod.Column), false);
+		}
+		for (const auto TileMod : NoSpawningStartingTiles)
+		{
+			if(IsValidTile(TileMod.Row, TileMod.Column)) TileStorage.SetCanSpawnOn(GetTileIndex(TileMod.Row, TileMod.Column), false);
+		}
+		bStartingModifiersInitialized = true;
+		return;
+	}
+
+	FGridBitset StartingWalkable;
+	FGridBitset StartingSpawnable;
+	GetStartingModifierBits(StartingWalkable, StartingSpawnable);
+
+	// Modifier bits are cleared on modified tiles, flip them to get the masks
+	StartingWalkable.Flip();
+	StartingSpawnable.Flip();
+	SetTilesFromMask(StartingSpawnable, EGridTileField::Spawnable, true, false);
+	SetTilesFromMask(StartingWalkable, EGridTileField::Walkable, false, true);
+
+	bStartingModifiersInitialized = true;
+}
+
+/**
+ * @brief Creates a Material Instance From Color and Opacity
+ * @return Material Instance Dynamic
+ */
+TObjectPtr<UMaterialInstanceDynamic> AGridManager::CreateMaterialInstance(const FLinearColor Color, const float Opacity)
+{
+	const TObjectPtr<UMaterialInstanceDynamic> Material = UMaterialInstanceDynamic::Create(MaterialInterface, this);
+	Material->SetVectorParameterValue(FName("Color"), Color);
+	Material->SetScalarParameterValue(FName("Opacity"), Opacity);
+	return Material;
+}
+
+/**
+ * @brief Function To Overload Create Mesh Section parameters to only vertices and triangles. Target: procedural mesh component
+ */
+void AGridManager::CreateMeshSection(UProceduralMeshComponent* ProceduralMesh, const TArray<FVector>& Vertices, const TArray<int>& Triangles, const int SectionIndex)
+{
+	const TArray<FVector> Normals;
+	const TArray<FVector2D> UVs;
+	const TArray<FColor> Colors;
+	const TArray<FProcMeshTangent> Tangents;
+	ProceduralMesh->CreateMeshSection(SectionIndex, Vertices, Triangles, Normals, UVs, Colors, Tangents, false);
+}
+
+/**
+ * @brief Make sure there is one line mesh component per line chunk and rebuild the chunks whose parameters changed
+ */
+void AGridManager::UpdateLineChunks()
+{
+	const int NumChunks = FMath::Max(GetNumLineChunkRows() * GetNumLineChunkColumns(), 1);
+
+	// First chunk is always drawn by the line mesh
+	if(LineChunkMeshes.Num() == 0 || LineChunkMeshes[0] != LineMesh)
+	{
+		LineChunkMeshes.Reset();
+		LineChunkMeshes.Add(LineMesh);
+		LineChunkKeys.Reset();
+	}
+
+	while (LineChunkMeshes.Num() > NumChunks)
+	{
+		if(UProceduralMeshComponent* ExtraChunkMesh = LineChunkMeshes.Pop(); IsValid(ExtraChunkMesh))
+		{
+			ExtraChunkMesh->DestroyComponent();
+		}
+	}
+	LineChunkKeys.SetNum(LineChunkMeshes.Num());
+
+	for (int ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+	{
+		if(!LineChunkMeshes.IsValidIndex(ChunkIndex) || !IsValid(LineChunkMeshes[ChunkIndex]))
+		{
+			LineChunkMeshes.SetNum(FMath::Max(LineChunkMeshes.Num(), ChunkIndex + 1));
+			LineChunkKeys.SetNum(LineChunkMeshes.Num());
+			LineChunkMeshes[ChunkIndex] = CreateLineChunkMesh();
+			LineChunkKeys[ChunkIndex] = FGridLineChunkKey();
+		}
+
+		if(const FGridLineChunkKey Key = MakeLineChunkKey(ChunkIndex); !(LineChunkKeys[ChunkIndex] == Key))
+		{
+			BuildLineChunk(LineChunkMeshes[ChunkIndex], Key);
+			LineChunkKeys[ChunkIndex] = Key;
+		}
+
+		if(LinesMaterial != nullptr)
+		{
+			LineChunkMeshes[ChunkIndex]->SetMaterial(0, LinesMaterial);
+		}
+	}
+}
+
+/**
+ * @brief Tiles and parameters a line chunk should currently be built with
+ */
+FGridLineChunkKey AGridManager::MakeLineChunkKey(const int ChunkIndex) const
+{
+	const int FirstRow = (ChunkIndex / FMath::Max(GetNumLineChunkColumns(), 1)) * LineChunkSize;
+	const int FirstColumn = (ChunkIndex % FMath::Max(GetNumLineChunkColumns(), 1)) * LineChunkSize;
+
+	FGridLineChunkKey Key;
+	Key.Tiles = FIntRect(FirstRow, FirstColumn, FMath::Min(FirstRow + LineChunkSize, NumRows), FMath::Min(FirstColumn + LineChunkSize, NumColumns));
+	Key.TileSize = TileSize;
+	Key.LineThickness = LineThickness;
+	Key.bClosingRowLine = Key.Tiles.Max.X == NumRows;
+	Key.bClosingColumnLine = Key.Tiles.Max.Y == NumColumns;
+	return Key;
+}
+
+/**
+ * @brief Build the lines of one chunk, lines on the shared border of two chunks are drawn by the chunk after it
+ */
+void AGridManager::BuildLineChunk(UProceduralMeshComponent* ChunkMesh, const FGridLineChunkKey& Key)
+{
+	const float StartX = Key.Tiles.Min.X * Key.TileSize;
+	const float EndX = Key.Tiles.Max.X * Key.TileSize;
+	const float StartY = Key.Tiles.Min.Y * Key.TileSize;
+	const float EndY = Key.Tiles.Max.Y * Key.TileSize;
+
+	const int LastHorizontalLine = EndY > StartY ? (Key.bClosingRowLine ? Key.Tiles.Max.X : Key.Tiles.Max.X - 1) : Key.Tiles.Min.X - 1;
+	const int LastVerticalLine = EndX > StartX ? (Key.bClosingColumnLine ? Key.Tiles.Max.Y : Key.Tiles.Max.Y - 1) : Key.Tiles.Min.Y - 1;
+	MeshBuilder.Reset((LastHorizontalLine - Key.Tiles.Min.X + 1) + (LastVerticalLine - Key.Tiles.Min.Y + 1));
+
+	// Create vertices and triangles for horizontal lines
+	for (int i = Key.Tiles.Min.X; i <= LastHorizontalLine; ++i)
+	{
+		const float LineStart = Key.TileSize * i;
+		MeshBuilder.AddLine(FVector(LineStart, StartY, 0.0f), FVector(LineStart, EndY, 0.0f), Key.LineThickness);
+	}
+
+	// Create vertices and triangles for vertical lines
+	for (int i = Key.Tiles.Min.Y; i <= LastVerticalLine; ++i)
+	{
+		const float LineStart = Key.TileSize * i;
+		MeshBuilder.AddLine(FVector(StartX, LineStart, 0.0f), FVector(EndX, LineStart, 0.0f), Key.LineThickness);
+	}
+
+	if(MeshBuilder.IsEmpty())
+	{
+		ChunkMesh->ClearMeshSection(0);
+		return;
+	}
+
+	CreateMeshSection(ChunkMesh, MeshBuilder.Vertices, MeshBuilder.Triangles);
+}
+
+/**
+ * @brief Create and register a transient line mesh component placed like the line mesh
+ */
+UProceduralMeshComponent* AGridManager::CreateLineChunkMesh()
+{
+	UProceduralMeshComponent* ChunkMesh = NewObject<UProceduralMeshComponent>(this, MakeUniqueObjectName(this, UProceduralMeshComponent::StaticClass(), TEXT("Lines Mesh Chunk")), RF_Transient);
+	ChunkMesh->SetupAttachment(RootComponent);
+	ChunkMesh->SetRelativeLocation(LineMesh->GetRelativeLocation());
+	ChunkMesh->RegisterComponent();
+	return ChunkMesh;
+}
+
+/**
+ * @brief Remove the line chunk components and the line mesh geometry
+ */
+void AGridManager::ClearLineChunks()
+{
+	for (int ChunkIndex = 1; ChunkIndex < LineChunkMeshes.Num(); ++ChunkIndex)
+	{
+		if(IsValid(LineChunkMeshes[ChunkIndex]))
+		{
+			LineChunkMeshes[ChunkIndex]->DestroyComponent();
+		}
+	}
+	LineChunkMeshes.Reset();
+	LineChunkKeys.Reset();
+	LineMesh->ClearAllMeshSections();
+}
+
+/**
+ * @brief Build the surface quad covering the grid and its material, build cost does not depend on the number of tiles
+ */
+void AGridManager::BuildSurface()
+{
+	// UVs run from 0 to 1 along the rows (U) and the columns (V)
+	MeshBuilder.Reset(1);
+	MeshBuilder.AddLine(FVector(0.0f, GetGridWidth()/2, 0.0f), FVector(GetGridHeight(), GetGridWidth()/2, 0.0f), GetGridWidth());
+	const TArray<FVector2D> UVs = { FVector2D(0.0f, 0.0f), FVector2D(1.0f, 0.0f), FVector2D(0.0f, 1.0f), FVector2D(1.0f, 1.0f) };
+	SurfaceMesh->CreateMeshSection(0, MeshBuilder.Vertices, MeshBuilder.Triangles, TArray<FVector>(), UVs, TArray<FColor>(), TArray<FProcMeshTangent>(), false);
+
+	if(SurfaceMaterialInterface == nullptr)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s() No surface material set for the Material render mode"), *FString(__FUNCTION__));
+		return;
+	}
+
+	SurfaceMaterial = UMaterialInstanceDynamic::Create(SurfaceMaterialInterface, this);
+	SurfaceMaterial->SetScalarParameterValue(GridSurfaceParameters::TileSize, TileSize);
+	SurfaceMaterial->SetScalarParameterValue(GridSurfaceParameters::LineThickness, LineThickness);
+	SurfaceMaterial->SetScalarParameterValue(GridSurfaceParameters::GridRows, NumRows);
+	SurfaceMaterial->SetScalarParameterValue(GridSurfaceParameters::GridColumns, NumColumns);
+	SurfaceMaterial->SetVectorParameterValue(GridSurfaceParameters::LineColor, LineColor);
+	SurfaceMaterial->SetScalarParameterValue(GridSurfaceParameters::LineOpacity, LineOpacity);
+	SurfaceMaterial->SetVectorParameterValue(GridSurfaceParameters::SelectionColor, SelectionColor);
+	SurfaceMaterial->SetScalarParameterValue(GridSurfaceParameters::SelectionOpacity, SelectionOpacity);
+	SurfaceMaterial->SetVectorParameterValue(GridSurfaceParameters::SelectedTile, FLinearColor(0.0f, 0.0f, 0.0f, 0.0f));
+	SurfaceMaterial->SetVectorParameterValue(GridSurfaceParameters::NoWalkColor, NoWalkColor);
+	SurfaceMaterial->SetScalarParameterValue(GridSurfaceParameters::NoWalkOpacity, NoWalkOpacity);
+	SurfaceMaterial->SetVectorParameterValue(GridSurfaceParameters::NoSpawnColor, NoSpawnColor);
+	SurfaceMaterial->SetScalarParameterValue(GridSurfaceParameters::NoSpawnOpacity, NoSpawnOpacity);
+	SurfaceMesh->SetMaterial(0, SurfaceMaterial);
+
+	RebuildTileStateTexture();
+}
+
+/**
+ * @brief Recreate the tile state texture from the tiles info, or from the starting modifiers before it is generated
+ */
+void AGridManager::RebuildTileStateTexture()
+{
+	DirtyTileStateTexels.Reset();
+	bTileStateTextureDirty = false;
+	if(NumRows <= 0 || NumColumns <= 0 || bPagedTiles) return;
+
+	const int MaxDimension = static_cast<int>(GetMax2DTextureDimension());
+	if(NumRows > MaxDimension || NumColumns > MaxDimension)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s() %dx%d grid is larger than the max texture size %d"), *FString(__FUNCTION__), NumRows, NumColumns, MaxDimension);
+		return;
+	}
+
+	FGridBitset PreviewWalkable;
+	FGridBitset PreviewSpawnable;
+	if(!IsGridInfoInitialized())
+	{
+		GetStartingModifierBits(PreviewWalkable, PreviewSpawnable);
+	}
+	const FGridBitset& Walkable = IsGridInfoInitialized() ? TileStorage.GetWalkableBits() : PreviewWalkable;
+	const FGridBitset& Spawnable = IsGridInfoInitialized() ? TileStorage.GetSpawnableBits() : PreviewSpawnable;
+
+	TileStateTexels.SetNumUninitialized(NumRows * NumColumns * 2);
+	for (int Index = 0; Index < NumRows * NumColumns; ++Index)
+	{
+		WriteTileStateTexel(Index, Walkable.Get(Index), Spawnable.Get(Index));
+	}
+
+	TileStateTexture = UTexture2D::CreateTransient(NumColumns, NumRows, PF_R8G8);
+	TileStateTexture->Filter = TF_Nearest;
+	TileStateTexture->SRGB = false;
+	TileStateTexture->AddressX = TA_Clamp;
+	TileStateTexture->AddressY = TA_Clamp;
+
+	FTexture2DMipMap& Mip = TileStateTexture->GetPlatformData()->Mips[0];
+	void* MipData = Mip.BulkData.Lock(LOCK_READ_WRITE);
+	FMemory::Memcpy(MipData, TileStateTexels.GetData(), TileStateTexels.Num());
+	Mip.BulkData.Unlock();
+	TileStateTexture->UpdateResource();
+
+	if(SurfaceMaterial != nullptr)
+	{
+		SurfaceMaterial->SetTextureParameterValue(GridSurfaceParameters::TileState, TileStateTexture);
+	}
+}
+
+void AGridManager::WriteTileStateTexel(const int Index, const bool bCanWalkOn, const bool bCanSpawnOn)
+{
+	TileStateTexels[Index * 2] = bCanWalkOn ? 0 : 255;
+	TileStateTexels[Index * 2 + 1] = bCanSpawnOn ? 0 : 255;
+}
+
+/**
+ * @brief Mirror the tile flags into its texel, the texel is uploaded on the next tick
+ */
+void AGridManager::MarkTileStateTexelDirty(const int Index)
+{
+	if(TileStateTexture == nullptr || !TileStateTexels.IsValidIndex(Index * 2 + 1)) return;
+
+	WriteTileStateTexel(Index, TileStorage.CanWalkOn(Index), TileStorage.CanSpawnOn(Index));
+	DirtyTileStateTexels.Add(Index);
+	SetActorTickEnabled(true);
+}
+
+/**
+ * @brief Mirror the flags of every tile of the rect into the texels, large rects upload the whole texture on the next tick
+ */
+void AGridManager::MarkTileStateRectDirty(const FIntRect& Tiles)
+{
+	if(TileStateTexture == nullptr) return;
+
+	const bool bUploadAll = Tiles.Area() * 4 > NumRows * NumColumns;
+	for (int Row = Tiles.Min.X; Row < Tiles.Max.X; ++Row)
+	{
+		for (int Column = Tiles.Min.Y; Column < Tiles.Max.Y; ++Column)
+		{
+			const int Index = GetTileIndex(Row, Column);
+			WriteTileStateTexel(Index, TileStorage.CanWalkOn(Index), TileStorage.CanSpawnOn(Index));
+			if(!bUploadAll) DirtyTileStateTexels.Add(Index);
+		}
+	}
+
+	bTileStateTextureDirty |= bUploadAll;
+	SetActorTickEnabled(true);
+}
+
+/**
+ * @brief Upload the texels changed since the last call, one texel region each, or the whole texture for large batches
+ */
+void AGridManager::UploadDirtyTileStateTexels()
+{
+	if((DirtyTileStateTexels.Num() == 0 && !bTileStateTextureDirty) || TileStateTexture == nullptr)
+	{
+		DirtyTileStateTexels.Reset();
+		bTileStateTextureDirty = false;
+		return;
+	}
+
+	// Render thread reads the regions and texels later, they are copied and freed by the cleanup callback
+	const auto CleanupUpload = [](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+	{
+		delete[] SrcData;
+		delete[] Regions;
+	};
+
+	if(bTileStateTextureDirty || DirtyTileStateTexels.Num() * 4 > NumRows * NumColumns)
+	{
+		uint8* TexelData = new uint8[TileStateTexels.Num()];
+		FMemory::Memcpy(TexelData, TileStateTexels.GetData(), TileStateTexels.Num());
+		FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D[1];
+		Region[0] = FUpdateTextureRegion2D(0, 0, 0, 0, NumColumns, NumRows);
+		TileStateTexture->UpdateTextureRegions(0, 1, Region, NumColumns * 2, 2, TexelData, CleanupUpload);
+	}
+	else
+	{
+		const int NumTexels = DirtyTileStateTexels.Num();
+		uint8* TexelData = new uint8[NumTexels * 2];
+		FUpdateTextureRegion2D* Regions = new FUpdateTextureRegion2D[NumTexels];
+		for (int i = 0; i < NumTexels; ++i)
+		{
+			const int Index = DirtyTileStateTexels[i];
+			const FIntPoint Position = TileStorage.IndexToPosition(Index);
+			TexelData[i * 2] = TileStateTexels[Index * 2];
+			TexelData[i * 2 + 1] = TileStateTexels[Index * 2 + 1];
+			Regions[i] = FUpdateTextureRegion2D(Position.Y, Position.X, i, 0, 1, 1);
+		}
+		TileStateTexture->UpdateTextureRegions(0, NumTexels, Regions, NumTexels * 2, 2, TexelData, CleanupUpload);
+	}
+
+	DirtyTileStateTexels.Reset();
+	bTileStateTextureDirty = false;
+}
+
+/**
+ * @brief Walk and spawn bits of the starting modifiers and generation rules, used to preview them before the tiles info is generated
+ */
+void AGridManager::GetStartingModifierBits(FGridBitset& OutWalkable, FGridBitset& OutSpawnable) const
+{
+	OutWalkable.Init(NumRows * NumColumns, true);
+	OutSpawnable.Init(NumRows * NumColumns, true);
+
+	for (const auto TileMod : NoWalkingStartingTiles)
+	{
+		if(IsValidTile(TileMod.Row, TileMod.Column)) OutWalkable.Set(GetTileIndex(TileMod.Row, TileMod.Column), false);
+	}
+
+	for (const auto TileMod : NoSpawningStartingTiles)
+	{
+		if(IsValidTile(TileMod.Row, TileMod.Column)) OutSpawnable.Set(GetTileIndex(TileMod.Row, TileMod.Column), false);
+	}
+
+	if(GenerationRules.Num() == 0) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_GridGeneration);
+	TRACE_CPUPROFILER_EVENT_SCOPE(Grid_Generation);
+	const double GenerationStartTime = FPlatformTime::Seconds();
+
+	FGridGenerationContext Context;
+	Context.FromBits(NumRows, NumColumns, OutWalkable, OutSpawnable);
+	Context.ApplyRules(GenerationRules, GenerationSeed);
+	Context.ToBits(OutWalkable, OutSpawnable);
+
+	if(CVarGridLogConstructionTime.GetValueOnGameThread())
+	{
+		UE_LOG(LogTemp, Log, TEXT("%s() %dx%d layout generated in %.3f ms"), *FString(__FUNCTION__), NumRows, NumColumns, (FPlatformTime::Seconds() - GenerationStartTime) * 1000.0);
+	}
+}
+
+/**
+ * @brief Rebuild every overlay chunk. Overlays show the tiles info once it is generated, the starting modifiers otherwise
+ */
+void AGridManager::RebuildOverlays()
+{
+	NoWalkMesh->ClearAllMeshSections();
+	NoSpawnMesh->ClearAllMeshSections();
+
+	const int NumChunks = GetNumOverlayChunkRows() * GetNumOverlayChunkColumns();
+	DirtyOverlayChunkFlags.Init(false, NumChunks);
+	DirtyOverlayChunks.Reset();
+
+	if(IsGridInfoInitialized())
+	{
+		for (int ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+		{
+			BuildOverlayChunk(NoWalkMesh, NoWalkOverlayMaterial, ChunkIndex, TileStorage.GetWalkableBits());
+			BuildOverlayChunk(NoSpawnMesh, NoSpawnOverlayMaterial, ChunkIndex, TileStorage.GetSpawnableBits());
+		}
+		return;
+	}
+
+	// Editor preview, without generation rules only chunks holding a starting modifier have anything to show
+	FGridBitset PreviewWalkable;
+	FGridBitset PreviewSpawnable;
+	GetStartingModifierBits(PreviewWalkable, PreviewSpawnable);
+
+	// Rules may block tiles in any chunk
+	if(GenerationRules.Num() > 0)
+	{
+		for (int ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+		{
+			BuildOverlayChunk(NoWalkMesh, NoWalkOverlayMaterial, ChunkIndex, PreviewWalkable);
+			BuildOverlayChunk(NoSpawnMesh, NoSpawnOverlayMaterial, ChunkIndex, PreviewSpawnable);
+		}
+		return;
+	}
+
+	TBitArray<> WalkChunks(false, NumChunks);
+	TBitArray<> SpawnChunks(false, NumChunks);
+	for (const auto TileMod : NoWalkingStartingTiles)
+	{
+		if(!IsValidTile(TileMod.Row, TileMod.Column)) continue;
+		WalkChunks[(TileMod.Row / OverlayChunkSize) * GetNumOverlayChunkColumns() + TileMod.Column / OverlayChunkSize] = true;
+	}
+
+	for (const auto TileMod : NoSpawningStartingTiles)
+	{
+		if(!IsValidTile(TileMod.Row, TileMod.Column)) continue;
+		SpawnChunks[(TileMod.Row / OverlayChunkSize) * GetNumOverlayChunkColumns() + TileMod.Column / OverlayChunkSize] = true;
+	}
+
+	for (TConstSetBitIterator<> It(WalkChunks); It; ++It)
+	{
+		BuildOverlayChunk(NoWalkMesh, NoWalkOverlayMaterial, It.GetIndex(), PreviewWalkable);
+	}
+
+	for (TConstSetBitIterator<> It(SpawnChunks); It; ++It)
+	{
+		BuildOverlayChunk(NoSpawnMesh, NoSpawnOverlayMaterial, It.GetIndex(), PreviewSpawnable);
+	}
+}
+
+/**
+ * @brief Build the overlay mesh section of one chunk with a quad on every tile not set in AllowedTiles
+ * @param ChunkIndex Chunk and mesh section index
+ * @param AllowedTiles Tiles without a quad, indexed like the tiles info
+ */
+void AGridManager::BuildOverlayChunk(UProceduralMeshComponent* OverlayMesh, UMaterialInterface* Material, const int ChunkIndex, const FGridBitset& AllowedTiles)
+{
+	const int FirstRow = (ChunkIndex / GetNumOverlayChunkColumns()) * OverlayChunkSize;
+	const int FirstColumn = (ChunkIndex % GetNumOverlayChunkColumns()) * OverlayChunkSize;
+	const int EndRow = FMath::Min(FirstRow + OverlayChunkSize, NumRows);
+	const int EndColumn = FMath::Min(FirstColumn + OverlayChunkSize, NumColumns);
+
+	// Worst case is every tile of the chunk, the builder keeps that capacity for the next chunks
+	MeshBuilder.Reset((EndRow - FirstRow) * (EndColumn - FirstColumn));
+	for (int Row = FirstRow; Row < EndRow; ++Row)
+	{
+		for (int Column = FirstColumn; Column < EndColumn; ++Column)
+		{
+			if(AllowedTiles.Get(GetTileIndex(Row, Column))) continue;
+
+			const float TileX = Row * TileSize;
+			const float TileCenterY = Column * TileSize + TileSize/2.0f;
+			MeshBuilder.AddLine(FVector(TileX, TileCenterY, 0.0f), FVector(TileX + TileSize, TileCenterY, 0.0f), TileSize);
+		}
+	}
+
+	if(MeshBuilder.IsEmpty())
+	{
+		OverlayMesh->ClearMeshSection(ChunkIndex);
+		return;
+	}
+
+	CreateMeshSection(OverlayMesh, MeshBuilder.Vertices, MeshBuilder.Triangles, ChunkIndex);
+	OverlayMesh->SetMaterial(ChunkIndex, Material);
+}
+
+/**
+ * @brief Queue the overlay chunk holding the tile for a rebuild on the next tick
+ */
+void AGridManager::MarkOverlayTileDirty(const int Index)
+{
+	const FIntPoint Position = TileStorage.IndexToPosition(Index);
+	const int ChunkIndex = (Position.X / OverlayChunkSize) * GetNumOverlayChunkColumns() + Position.Y / OverlayChunkSize;
+	if(!DirtyOverlayChunkFlags.IsValidIndex(ChunkIndex) || DirtyOverlayChunkFlags[ChunkIndex]) return;
+
+	DirtyOverlayChunkFlags[ChunkIndex] = true;
+	DirtyOverlayChunks.Add(ChunkIndex);
+	SetActorTickEnabled(true);
+}
+
+/**
+ * @brief Queue every overlay chunk overlapping the rect for a rebuild on the next tick
+ */
+void AGridManager::MarkOverlayRectDirty(const FIntRect& Tiles)
+{
+	for (int ChunkRow = Tiles.Min.X / OverlayChunkSize; ChunkRow <= (Tiles.Max.X - 1) / OverlayChunkSize; ++ChunkRow)
+	{
+		for (int ChunkColumn = Tiles.Min.Y / OverlayChunkSize; ChunkColumn <= (Tiles.Max.Y - 1) / OverlayChunkSize; ++ChunkColumn)
+		{
+			MarkOverlayTileDirty(GetTileIndex(ChunkRow * OverlayChunkSize, ChunkColumn * OverlayChunkSize));
+		}
+	}
+}
+
+/**
+ * @brief Rebuild the overlay chunks whose tiles changed since the last call
+ */
+void AGridManager::RebuildDirtyOverlayChunks()
+{
+	for (const int ChunkIndex : DirtyOverlayChunks)
+	{
+		BuildOverlayChunk(NoWalkMesh, NoWalkOverlayMaterial, ChunkIndex, TileStorage.GetWalkableBits());
+		BuildOverlayChunk(NoSpawnMesh, NoSpawnOverlayMaterial, ChunkIndex, TileStorage.GetSpawnableBits());
+		DirtyOverlayChunkFlags[ChunkIndex] = false;
+	}
+	DirtyOverlayChunks.Reset();
+}
+
+/**
+ * @brief Create a line mesh vertices and triangles
+ * @param Start Start location of the line
+ * @param End End location of the line
+ * @param Thickness Line thickness
+ * @param Vertices Array Reference to append to
+ * @param Triangles Array Reference to append to
+ */
+void AGridManager::CreateLine(const FVector& Start, const FVector& End, const float Thickness, TArray<FVector>& Vertices, TArray<int>& Triangles)
+{
+	FGridMeshBuilder::AppendLine(Start, End, Thickness, Vertices, Triangles);
+}
+
+bool AGridManager::GetTileInReferenceToTile(const int InRow, const int InColumn, const int RowOffset, const int ColOffset, FVector& OutLocation, FTileInfo& TileInfo, bool bConsiderRotation, FRotator Rotation)
+{
+	bool bValidTile;
+	const FVector TileLocation = TileToGridLocation(InRow, InColumn, bValidTile);
+	if(!bValidTile) return false;
+	
+	FVector Offset = FVector(TileSize * RowOffset, TileSize * ColOffset, 0.0f);
+	if(bConsiderRotation) Offset = UKismetMathLibrary::Quat_RotateVector(Rotation.Quaternion(), Offset);
+
+	int OutRow, OutColumn;
+	LocationToTile(Offset+TileLocation, OutRow, OutColumn, bValidTile);
+	if(!bValidTile) return false;
+
+	TileInfo = GetTileInfoAtPositionWithLocation(OutRow, OutColumn, OutLocation, bValidTile);
+	
+	return bValidTile;
+}
+
+bool AGridManager::GetTileInReferenceToLocation(const FVector Location, const int RowOffset, const int ColOffset, FVector& OutLocation, FTileInfo& TileInfo, bool bConsiderRotation, FRotator Rotation)
+{
+	int Row, Column;
+	bool bValid; 
+	LocationToTile(Location, Row, Column, bValid);
+	if(!bValid) return false;
+	
+	return GetTileInReferenceToTile(Row, Column, RowOffset, ColOffset, OutLocation, TileInfo, bConsiderRotation, Rotation);
+}
+
+/**
+ * @brief Function for checking if Row and Column are in the Grid Range
+ * @return Boolean
+ */
+bool AGridManager::IsValidTile(const int Row, const int Column) const
+{
+	return Row >= 0 && Row < NumRows && Column >= 0 && Column < NumColumns;
+}
+
+/**
+ * @brief Function for checking if Row and Column are in the Grid Range and tile is walkable.
+ * Tiles count as walkable until the tiles info is generated
+ * @return Boolean
+ */
+bool AGridManager::IsValidWalkTile(const int Row, const int Column) const
+{
+	return IsValidTile(Row, Column) && (!IsGridInfoInitialized() || TileStorage.CanWalkOn(GetTileIndex(Row, Column)));
+}
+
+/**
+ * @brief Function for checking if Row and Column are in the Grid Range and tile is spawn free.
+ * Tiles count as spawn free until the tiles info is generated
+ * @return Boolean
+ */
+bool AGridManager::IsValidSpawnTile(int Row, int Column) const
+{
+	return IsValidTile(Row, Column) && (!IsGridInfoInitialized() || TileStorage.CanSpawnOn(GetTileIndex(Row, Column)));
+}
+
+/**
+ * @brief Mapping from world location to tile row and column
+ * @param Location World Location
+ * @param RowOut Tile row Mapped
+ * @param ColumnOut Tile column Mapped
+ * @param bValid Location is in Grid Range
+ */
+void AGridManager::LocationToTile(const FVector Location, int& RowOut, int& ColumnOut, bool& bValid) const
+{
+	GRID_STAT_SCOPE(CoordinateConversion);
+	GRID_STAT_TILES(CoordinateConversion, 1);
+	const FVector ActorLocation = GetActorLocation();
+	RowOut = UKismetMathLibrary::FFloor((Location.X-ActorLocation.X)/GetGridWidth()*NumColumns);
+	ColumnOut = UKismetMathLibrary::FFloor((Location.Y-ActorLocation.Y)/GetGridHeight()*NumRows);
+	bValid = IsValidTile(RowOut, ColumnOut);
+}
+
+bool AGridManager::TakeTileSpace(AActor* Actor, bool bAffectWalkable)
+{
+	GRID_STAT_SCOPE(Spawn);
+	int Row, Column;
+	bool bValid;
+	LocationToTile(Actor->GetActorLocation(), Row, Column, bValid);
+
+	if(!bValid || !IsGridInfoInitialized())
+	{
+		GRID_STAT_ERROR(Spawn);
+		return false;
+	}
+
+	const int Index = GetTileIndex(Row, Column);
+	SetTileFlags(Index, bAffectWalkable ? false : TileStorage.CanWalkOn(Index), false);
+	TileStorage.AddActorToTile(Index, Actor);
+	RecordTileChange(Index, EGridTileField::Occupant);
+	GRID_STAT_TILES(Spawn, 1);
+	return true;
+}
+
+/**
+ * @brief Add a dense attribute plane to the tiles info, kept until the grid is resized
+ * @return Layer index to pass to the attribute functions, INDEX_NONE if the name is used by a layer of another type
+ */
+int AGridManager::AddAttributeLayer(const FName Name, const EGridAttributeType Type, const float DefaultValue)
+{
+	if(!IsGridInfoInitialized() || TileStorage.IsPaged())
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s() Tiles info array not initialized or paged"), *FString(__FUNCTION__));
+		return INDEX_NONE;
+	}
+	return TileStorage.GetAttributes().AddLayer(Name, Type, DefaultValue);
+}
+
+/**
+ * @brief Look the layer index up once and keep it, the other attribute functions take the index
+ */
+int AGridManager::FindAttributeLayer(const FName Name) const
+{
+	return TileStorage.GetAttributes().FindLayer(Name);
+}
+
+float AGridManager::GetTileAttribute(const int Layer, const int Row, const int Column) const
+{
+	if(!IsGridInfoInitialized() || !TileStorage.GetAttributes().IsValidLayer(Layer) || !IsValidTile(Row, Column)) return 0.0f;
+	return TileStorage.GetAttributes().GetValue(Layer, GetTileIndex(Row, Column));
+}
+
+/**
+ * @param Value Rounded and clamped for integer layers
+ */
+bool AGridManager::SetTileAttribute(const int Layer, const int Row, const int Column, const float Value)
+{
+	if(!IsGridInfoInitialized() || !TileStorage.GetAttributes().IsValidLayer(Layer) || !IsValidTile(Row, Column)) return false;
+	TileStorage.GetAttributes().SetValue(Layer, GetTileIndex(Row, Column), Value);
+	return true;
+}
+
+/**
+ * @brief Fill a rect of a layer, both corners included. The rect is clipped to the grid
+ */
+bool AGridManager::FillAttributeRect(const int Layer, const int StartRow, const int StartColumn, const int EndRow, const int EndColumn, const float Value)
+{
+	if(!IsGridInfoInitialized() || !TileStorage.GetAttributes().IsValidLayer(Layer)) return false;
+
+	const FIntRect Tiles(FMath::Max(FMath::Min(StartRow, EndRow), 0), FMath::Max(FMath::Min(StartColumn, EndColumn), 0),
+		FMath::Min(FMath::Max(StartRow, EndRow) + 1, NumRows), FMath::Min(FMath::Max(StartColumn, EndColumn) + 1, NumColumns));
+	if(Tiles.Min.X >= Tiles.Max.X || Tiles.Min.Y >= Tiles.Max.Y) return false;
+
+	for (int Row = Tiles.Min.X; Row < Tiles.Max.X; ++Row)
+	{
+		TileStorage.GetAttributes().FillRange(Layer, GetTileIndex(Row, Tiles.Min.Y), Tiles.Height(), Value);
+	}
+	return true;
+}
+
+bool AGridManager::FillAttributeLayer(const int Layer, const float Value)
+{
+	if(!IsGridInfoInitialized() || !TileStorage.GetAttributes().IsValidLayer(Layer)) return false;
+	TileStorage.GetAttributes().Fill(Layer, Value);
+	return true;
+}
+
+FGridCoordinateMapper AGridManager::MakeCoordinateMapper() const
+{
+	FGridCoordinateMapper Mapper;
+	Mapper.Origin = GetActorLocation();
+	Mapper.TileSize = TileSize;
+	Mapper.NumRows = NumRows;
+	Mapper.NumColumns = NumColumns;
+	return Mapper;
+}
+
+/**
+ * @brief Batch LocationToTile, the grid origin and tile size are read once for the whole array
+ * @param OutValid Tile at the same index is in grid range
+ */
+void AGridManager::LocationsToTiles(const TArray<FVector>& Locations, TArray<FIntPoint>& OutTiles, TArray<bool>& OutValid) const
+{
+	GRID_STAT_SCOPE(CoordinateConversion);
+	GRID_STAT_TILES(CoordinateConversion, Locations.Num());
+	GRID_STAT_ALLOCATION(CoordinateConversion);
+	FGridBitset ValidBits;
+	OutTiles.SetNumUninitialized(Locations.Num());
+	MakeCoordinateMapper().LocationsToTiles(Locations, OutTiles, ValidBits);
+
+	OutValid.SetNumUninitialized(Locations.Num());
+	for (int i = 0; i < Locations.Num(); ++i)
+	{
+		OutValid[i] = ValidBits.Get(i);
+	}
+}
+
+/**
+ * @brief Batch TileToGridLocation, the grid origin and tile size are read once for the whole array
+ * @param OutValid Tile at the same index is in grid range
+ */
+void AGridManager::TilesToGridLocations(const TArray<FIntPoint>& Tiles, TArray<FVector>& OutLocations, TArray<bool>& OutValid, const bool bCenter, const FVector Offset) const
+{
+	GRID_STAT_SCOPE(CoordinateConversion);
+	GRID_STAT_TILES(CoordinateConversion, Tiles.Num());
+	GRID_STAT_ALLOCATION(CoordinateConversion);
+	FGridBitset ValidBits;
+	OutLocations.SetNumUninitialized(Tiles.Num());
+	MakeCoordinateMapper().TilesToLocations(Tiles, OutLocations, ValidBits, bCenter, Offset);
+
+	OutValid.SetNumUninitialized(Tiles.Num());
+	for (int i = 0; i < Tiles.Num(); ++i)
+	{
+		OutValid[i] = ValidBits.Get(i);
+	}
+}
+
+/**
+ * @brief Remove the actor from every tile it occupies, the tile flags are left as they are
+ * @return false if the actor was not on a tile
+ */
+bool AGridManager::ReleaseTileSpace(AActor* Actor)
+{
+	GRID_STAT_SCOPE(Spawn);
+	if(!IsGridInfoInitialized()) return false;
+
+	TArray<int32> Tiles;
+	if(TileStorage.GetOccupancy().GetTiles(Actor, Tiles) == 0) return false;
+
+	TileStorage.RemoveActor(Actor);
+	for (const int32 Index : Tiles)
+	{
+		RecordTileChange(Index, EGridTileField::Occupant);
+	}
+	GRID_STAT_TILES(Spawn, Tiles.Num());
+	return true;
+}
+
+/**
+ * @brief Keep the actor on the tile under it as it moves. Its root component transform updates are hooked
+ * and the tile is only recomputed when the actor leaves the cell it was in, OnActorTileChanged fires on each crossing.
+ * The tile is made not spawnable while occupied, its flags are restored once the last registered actor leaves
+ * @param bAffectWalkable Also make the occupied tile not walkable
+ * @return false if the actor has no root component or the tiles info is not initialized
+ */
+bool AGridManager::RegisterMovableActor(AActor* Actor, const bool bAffectWalkable)
+{
+	if(!IsValid(Actor) || Actor->GetRootComponent() == nullptr || !IsGridInfoInitialized()) return false;
+	if(TrackedActors.Contains(Actor)) return true;
+
+	FGridTrackedActor& Tracked = TrackedActors.Add(Actor);
+	Tracked.Actor = Actor;
+	Tracked.Root = Actor->GetRootComponent();
+	Tracked.bAffectWalkable = bAffectWalkable;
+	Tracked.TransformUpdatedHandle = Tracked.Root->TransformUpdated.AddUObject(this, &AGridManager::HandleTrackedTransformUpdated);
+	Actor->OnDestroyed.AddUniqueDynamic(this, &AGridManager::HandleTrackedActorDestroyed);
+
+	UpdateTrackedActorTile(Actor, Tracked, Actor->GetActorLocation(), false);
+	return true;
+}
+
+/**
+ * @brief Stop following the actor, it leaves the occupancy index and its tile flags are restored
+ * @return false if the actor was not registered
+ */
+bool AGridManager::UnregisterMovableActor(AActor* Actor)
+{
+	FGridTrackedActor Tracked;
+	if(!TrackedActors.RemoveAndCopyValue(Actor, Tracked)) return false;
+
+	ReleaseTrackedActor(Actor, Actor, Tracked);
+	return true;
+}
+
+/**
+ * @brief Unhook an actor already removed from TrackedActors, release its claim and take it off its tile
+ * @param Actor nullptr once destroyed, the tile is then left through the key
+ */
+void AGridManager::ReleaseTrackedActor(AActor* Actor, const TObjectKey<AActor> Key, const FGridTrackedActor& Tracked)
+{
+	if(USceneComponent* Root = Tracked.Root.Get())
+	{
+		Root->TransformUpdated.Remove(Tracked.TransformUpdatedHandle);
+	}
+	if(Actor != nullptr)
+	{
+		Actor->OnDestroyed.RemoveDynamic(this, &AGridManager::HandleTrackedActorDestroyed);
+	}
+
+	if(Tracked.Tile != INDEX_NONE)
+	{
+		ReleaseTileClaim(Tracked.Tile, Tracked.bAffectWalkable);
+		TileStorage.RemoveActorFromTile(Tracked.Tile, Key);
+		RecordTileChange(Tracked.Tile, EGridTileField::Occupant);
+	}
+}
+
+void AGridManager::HandleTrackedActorDestroyed(AActor* DestroyedActor)
+{
+	UnregisterMovableActor(DestroyedActor);
+}
+
+void AGridManager::HandleTrackedTransformUpdated(USceneComponent* Component, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	AActor* Actor = Component->GetOwner();
+	FGridTrackedActor* Tracked = TrackedActors.Find(Actor);
+	if(Tracked == nullptr) return;
+
+	// Still inside the same cell, the common case of every transform update
+	const FVector Location = Component->GetComponentLocation();
+	if(Location.X >= Tracked->CellMin.X && Location.X < Tracked->CellMax.X && Location.Y >= Tracked->CellMin.Y && Location.Y < Tracked->CellMax.Y)
+	{
+		return;
+	}
+
+	UpdateTrackedActorTile(Actor, *Tracked, Location, true);
+}
+
+/**
+ * @brief Move the tracked actor claim and occupancy to the tile under Location
+ * @param bBroadcast Fire OnActorTileChanged if the tile changed
+ */
+void AGridManager::UpdateTrackedActorTile(AActor* Actor, FGridTrackedActor& Tracked, const FVector& Location, const bool bBroadcast)
+{
+	int Row, Column;
+	bool bValid;
+	LocationToTile(Location, Row, Column, bValid);
+
+	// Cells outside the grid are cached too so actors walking off grid do not recompute on every update
+	const FVector GridLocation = GetActorLocation();
+	Tracked.CellMin = FVector2D(GridLocation.X + Row * TileSize, GridLocation.Y + Column * TileSize);
+	Tracked.CellMax = Tracked.CellMin + FVector2D(TileSize, TileSize);
+
+	const int OldTile = Tracked.Tile;
+	const int NewTile = bValid ? GetTileIndex(Row, Column) : INDEX_NONE;
+	if(NewTile == OldTile) return;
+
+	const bool bAffectWalkable = Tracked.bAffectWalkable;
+	Tracked.Tile = NewTile;
+	if(OldTile != INDEX_NONE)
+	{
+		// Only the tracked tile is left, other tiles the actor took stay occupied
+		ReleaseTileClaim(OldTile, bAffectWalkable);
+		TileStorage.RemoveActorFromTile(OldTile, Actor);
+		RecordTileChange(OldTile, EGridTileField::Occupant);
+	}
+	if(NewTile != INDEX_NONE)
+	{
+		ClaimTile(NewTile, bAffectWalkable);
+		TileStorage.AddActorToTile(NewTile, Actor);
+		RecordTileChange(NewTile, EGridTileField::Occupant);
+	}
+
+	// Listeners may unregister actors, Tracked must not be used past this point
+	if(bBroadcast)
+	{
+		const FIntPoint OldPosition = OldTile != INDEX_NONE ? TileStorage.IndexToPosition(OldTile) : FIntPoint(INDEX_NONE);
+		const FIntPoint NewPosition = NewTile != INDEX_NONE ? TileStorage.IndexToPosition(NewTile) : FIntPoint(INDEX_NONE);
+		OnActorTileChanged.Broadcast(Actor, OldPosition, NewPosition);
+	}
+}
+
+/**
+ * @brief Count a tracked actor on the tile, the first claim remembers the flags to restore
+ */
+void AGridManager::ClaimTile(const int Index, const bool bBlockWalk)
+{
+	FGridTileClaim& Claim = TileClaims.FindOrAdd(Index);
+	if(Claim.Claims == 0)
+	{
+		Claim.bWasWalkable = TileStorage.CanWalkOn(Index);
+		Claim.bWasSpawnable = TileStorage.CanSpawnOn(Index);
+	}
+
+	++Claim.Claims;
+	if(bBlockWalk) ++Claim.WalkBlockers;
+	SetTileFlags(Index, Claim.WalkBlockers > 0 ? false : TileStorage.CanWalkOn(Index), false);
+}
+
+/**
+ * @brief Remove a tracked actor from the tile count, flags come back once nothing holds them anymore
+ */
+void AGridManager::ReleaseTileClaim(const int Index, const bool bBlockWalk)
+{
+	FGridTileClaim* Claim = TileClaims.Find(Index);
+	if(Claim == nullptr) return;
+
+	--Claim->Claims;
+	if(bBlockWalk) --Claim->WalkBlockers;
+
+	if(Claim->Claims <= 0)
+	{
+		SetTileFlags(Index, Claim->bWasWalkable, Claim->bWasSpawnable);
+		TileClaims.Remove(Index);
+	}
+	else if(bBlockWalk && Claim->WalkBlockers == 0)
+	{
+		SetTileFlags(Index, Claim->bWasWalkable, false);
+	}
+}
+
+/**
+ * @brief Tile the actor took with TakeTileSpace or was spawned on, the last one it was put on if it covers several
+ * @return false if the actor is not on a tile
+ */
+bool AGridManager::GetActorTile(const AActor* Actor, int& Row, int& Column) const
+{
+	const int Index = IsGridInfoInitialized() ? TileStorage.GetOccupancy().GetTile(Actor) : INDEX_NONE;
+	if(Index == INDEX_NONE) return false;
+
+	const FIntPoint Position = TileStorage.IndexToPosition(Index);
+	Row = Position.X;
+	Column = Position.Y;
+	return true;
+}
+
+/**
+ * @param OutActors Reset then filled, its allocation is reused
+ * @return Number of actors found
+ */
+int AGridManager::GetActorsOnTile(const int Row, const int Column, TArray<AActor*>& OutActors) const
+{
+	OutActors.Reset();
+	if(!IsGridInfoInitialized() || !IsValidTile(Row, Column)) return 0;
+	return TileStorage.GetOccupancy().GetActorsOnTile(GetTileIndex(Row, Column), OutActors);
+}
+
+/**
+ * @brief Actors of every tile in the rect, both corners included. Actors covering several of the tiles are found once per tile
+ * @param OutActors Reset then filled, its allocation is reused
+ * @return Number of actors found
+ */
+int AGridManager::GetActorsInRect(const int StartRow, const int StartColumn, const int EndRow, const int EndColumn, TArray<AActor*>& OutActors) const
+{
+	OutActors.Reset();
+	if(!IsGridInfoInitialized()) return 0;
+
+	const FIntRect Tiles(FMath::Min(StartRow, EndRow), FMath::Min(StartColumn, EndColumn), FMath::Max(StartRow, EndRow) + 1, FMath::Max(StartColumn, EndColumn) + 1);
+	return TileStorage.GetOccupancy().QueryRect(Tiles, OutActors);
+}
+
+/**
+ * @brief Actors of every tile whose center is within Radius tiles of the tile
+ * @param OutActors Reset then filled, its allocation is reused
+ * @return Number of actors found
+ */
+int AGridManager::GetActorsInRadius(const int Row, const int Column, const int Radius, TArray<AActor*>& OutActors) const
+{
+	OutActors.Reset();
+	if(!IsGridInfoInitialized()) return 0;
+	return TileStorage.GetOccupancy().QueryRadius(FIntPoint(Row, Column), Radius, OutActors);
+}
+
+/**
+ * @brief Closest actor to the tile, ties are broken by ring order
+ * @param ActorClass Only actors of this class are considered, any actor if null
+ * @return nullptr if no actor is within MaxRadius tiles
+ */
+AActor* AGridManager::FindNearestActor(const int Row, const int Column, const int MaxRadius, int& OutRow, int& OutColumn, const TSubclassOf<AActor> ActorClass) const
+{
+	if(!IsGridInfoInitialized()) return nullptr;
+
+	FIntPoint NearestTile;
+	AActor* Nearest = TileStorage.GetOccupancy().FindNearest(FIntPoint(Row, Column), MaxRadius, NearestTile, [&ActorClass](const AActor* Actor)
+	{
+		return ActorClass == nullptr || Actor->IsA(ActorClass);
+	});
+
+	if(Nearest != nullptr)
+	{
+		OutRow = NearestTile.X;
+		OutColumn = NearestTile.Y;
+	}
+	return Nearest;
+}
+
+FVector AGridManager::LocationToGridLocation(FVector Location, bool& bValid)
+{
+	int Row, Column;
+	LocationToTile(Location, Row, Column, bValid);
+	return TileToGridLocation(Row, Column, bValid);
+}
+
+AActor* AGridManager::SpawnActorOnGrid(const TSubclassOf<AActor> ActorClass, const int Row, const int Column, bool& bSpawned, const FTransform SpawnTransform, const bool bCenter, const bool bAffectWalkable)
+{
+	GRID_STAT_SCOPE(Spawn);
+	if (!IsValid(ActorClass))
+	{
+		GRID_STAT_ERROR(Spawn);
+		UE_LOG(LogTemp, Warning, TEXT("%s() Invalid Actor Spawn Class"), *FString(__FUNCTION__))
+		return nullptr;
+	}
+	
+	if (const UWorld* Level = GetWorld(); IsValid(Level))
+	{
+		bool bTileValid;
+		const FVector SpawnLocation = TileToSpawnGridLocation(Row, Column, bTileValid, bCenter, SpawnTransform.GetLocation());
+
+		if(!bTileValid)
+		{
+			GRID_STAT_ERROR(Spawn);
+			UE_LOG(LogTemp, Warning, TEXT("%s() Tile (%d, %d) is Invalid"), *FString(__FUNCTION__), Row, Column);
+			bSpawned = false;
+			return nullptr;
+		}
+
+		FTransform ActorSpawnTransform;
+		ActorSpawnTransform.SetLocation(SpawnLocation);
+		ActorSpawnTransform.SetRotation(SpawnTransform.GetRotation());
+		ActorSpawnTransform.SetScale3D(SpawnTransform.GetScale3D());
+
+		AActor* SpawnedActor = UGameplayStatics::BeginDeferredActorSpawnFromClass(this, ActorClass, SpawnTransform, ESpawnActorCollisionHandlingMethod::AlwaysSpawn, nullptr, ESpawnActorScaleMethod::OverrideRootScale);
+		if(SpawnedActor != nullptr)
+		{
+			SpawnedActor->FinishSpawning(ActorSpawnTransform);
+			bSpawned = true;
+			if(IsGridInfoInitialized())
+			{
+				const int Index = GetTileIndex(Row, Column);
+				SetTileFlags(Index, bAffectWalkable ? false : TileStorage.CanWalkOn(Index), false);
+				TileStorage.AddActorToTile(Index, SpawnedActor);
+				RecordTileChange(Index, EGridTileField::Occupant);
+				GRID_STAT_TILES(Spawn, 1);
+			}
+		}
+		return SpawnedActor;
+	}
+
+	GRID_STAT_ERROR(Spawn);
+	UE_LOG(LogTemp, Warning, TEXT("%s() No Level To Spawn"), *FString(__FUNCTION__));
+	return nullptr;
+}
+
+/**
+ * @brief Mapping from grid row and column to world location
+ * @param Row Tile row position
+ * @param Column Tile column position
+ * @param bValid Row and column are in grid range
+ * @param bCenter Get the center location of the tile or the bottom left corner if false 
+ * @param Offset Offset vector to Add to the end location
+ * @return Tile Location (center/corner) + offset
+ */
+FVector AGridManager::TileToGridLocation(const int Row, const int Column, bool& bValid, const bool bCenter, const FVector Offset) const
+{
+	GRID_STAT_SCOPE(CoordinateConversion);
+	GRID_STAT_TILES(CoordinateConversion, 1);
+	const FVector ActorLocation = GetActorLocation();
+	
+	bValid = IsValidTile(Row, Column);
+	FVector GridLocation = FVector::ZeroVector;
+	GridLocation.X = bCenter? Row * TileSize + ActorLocation.X + (TileSize / 2) : Row * TileSize + ActorLocation.X;
+	GridLocation.Y = bCenter? Column * TileSize + ActorLocation.Y +(TileSize / 2) : Column * TileSize + ActorLocation.Y;
+	GridLocation = GridLocation + Offset;
+	return GridLocation;
+}
+
+/**
+ * @brief Mapping from grid row and column to world location
+ * @param Row Tile row position
+ * @param Column Tile column position
+ * @param bValid Row and column are in grid range and tile is walkable
+ * @param bCenter Get the center location of the tile or the bottom left corner if false 
+ * @param Offset Offset vector to Add to the end location
+ * @return Tile Location (center/corner) + offset
+ */
+FVector AGridManager::TileToWalkGridLocation(const int Row, const int Column, bool& bValid, const bool bCenter, const FVector Offset) const
+{
+	GRID_STAT_SCOPE(CoordinateConversion);
+	GRID_STAT_TILES(CoordinateConversion, 1);
+	const FVector ActorLocation = GetActorLocation();
+	
+	bValid = IsValidWalkTile(Row, Column);
+	FVector GridLocation;
+	GridLocation.X = bCenter? Row * TileSize + ActorLocation.X + (TileSize / 2) : Row * TileSize + ActorLocation.X;
+	GridLocation.Y = bCenter? Column * TileSize + ActorLocation.Y +(TileSize / 2) : Column * TileSize + ActorLocation.Y;
+	GridLocation = GridLocation + Offset;
+	return GridLocation;
+}
+
+/**
+ * @brief Mapping from grid row and column to world location
+ * @param Row Tile row position
+ * @param Column Tile column position
+ * @param bValid Row and column are in grid range and tile is spawn free
+ * @param bCenter Get the center location of the tile or the bottom left corner if false 
+ * @param Offset Offset vector to Add to the end location
+ * @return Tile Location (center/corner) + offset
+ */
+FVector AGridManager::TileToSpawnGridLocation(const int Row, const int Column, bool& bValid, const bool bCenter, const FVector Offset) const
+{
+	GRID_STAT_SCOPE(CoordinateConversion);
+	GRID_STAT_TILES(CoordinateConversion, 1);
+	const FVector ActorLocation = GetActorLocation();
+	
+	bValid = IsValidSpawnTile(Row, Column);
+	FVector GridLocation;
+	GridLocation.X = bCenter? Row * TileSize + ActorLocation.X + (TileSize / 2) : Row * TileSize + ActorLocation.X;
+	GridLocation.Y = bCenter? Column * TileSize + ActorLocation.Y +(TileSize / 2) : Column * TileSize + ActorLocation.Y;
+	GridLocation = GridLocation + Offset;
+	return GridLocation;
+}
+
+/**
+ * @brief Set selected tile mesh to location of the tile
+ * @param Row Selected tile row
+ * @param Column Selected tile column
+ */
+void AGridManager::SetSelectedTile(const int Row, const int Column) const
+{
+	bool bValid;
+	const FVector Location = TileToGridLocation(Row, Column, bValid, false);
+
+	if(RenderMode == EGridRenderMode::Material)
+	{
+		// Z tells the surface material if a tile is selected at all
+		if(SurfaceMaterial != nullptr)
+		{
+			SurfaceMaterial->SetVectorParameterValue(GridSurfaceParameters::SelectedTile, FLinearColor(Row, Column, bValid ? 1.0f : 0.0f, 0.0f));
+		}
+		return;
+	}
+	
+	if(bValid)
+	{
+		SelectionMesh->SetWorldLocation(FVector(Location.X, Location.Y, SelectionMesh->GetComponentLocation().Z));
+	}
+
+	SelectionMesh->SetVisibility(bValid);
+}
+
+/**
+ * @return true if tiles info array is equal to the number of tiles
+ */
+bool AGridManager::IsGridInfoInitialized() const
+{
+	return TileStorage.GetNumRows() == NumRows && TileStorage.GetNumColumns() == NumColumns;
+}
+
+/**
+ * @brief Allocate the tile storage if it does not match the grid size (already initialized)
+ */
+void AGridManager::GenerateTileInfo()
+{
+	if(IsGridInfoInitialized()) return;
+	
+	// Fill tiles info storage
+	bStartingModifiersInitialized = false;
+	if(bPagedTiles)
+	{
+		// Only the page table is allocated, pages come with the first writes
+		TileStorage.InitPaged(NumRows, NumColumns, TilePageSize, MaxResidentTilePages);
+		Hierarchy.Empty();
+		if(AttributeLayers.Num() > 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s() Attribute layers are not allocated on paged grids"), *FString(__FUNCTION__));
+		}
+	}
+	else
+	{
+		TileStorage.Init(NumRows, NumColumns);
+		Hierarchy.Init(NumRows, NumColumns, HierarchicalClusterSize);
+		for (const FGridAttributeLayerDesc& LayerDesc : AttributeLayers)
+		{
+			if(TileStorage.GetAttributes().AddLayer(LayerDesc.Name, LayerDesc.Type, LayerDesc.DefaultValue) == INDEX_NONE)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("%s() Attribute layer %s declared twice with different types"), *FString(__FUNCTION__), *LayerDesc.Name.ToString());
+			}
+		}
+	}
+
+	TileDeltas.Init(NumRows * NumColumns, bPagedTiles);
+	if(TileSnapshots.IsValid())
+	{
+		if(bPagedTiles)
+		{
+			TileSnapshots.Reset();
+		}
+		else
+		{
+			TileSnapshots->Init(NumRows, NumColumns);
+		}
+	}
+	RecordAllTilesChanged(EGridTileField::Walkable | EGridTileField::Spawnable | EGridTileField::Occupant);
+
+	// Claims were made against the old tiles, place the tracked actors again
+	RegionLabels.Invalidate();
+	ReplaceTrackedActors();
+}
+
+/**
+ * @brief Drop the tile claims and place the tracked actors again on the current tile flags
+ */
+void AGridManager::ReplaceTrackedActors()
+{
+	TileClaims.Reset();
+	for (TPair<TObjectKey<AActor>, FGridTrackedActor>& Pair : TrackedActors)
+	{
+		// Imports keep the occupancy, the old tile is left first. Regenerated storage has no entry to remove
+		if(Pair.Value.Tile != INDEX_NONE) TileStorage.RemoveActorFromTile(Pair.Value.Tile, Pair.Key);
+		Pair.Value.Tile = INDEX_NONE;
+		if(AActor* Actor = Pair.Value.Actor.Get())
+		{
+			UpdateTrackedActorTile(Actor, Pair.Value, Actor->GetActorLocation(), false);
+		}
+	}
+}
+
+/**
+ * @brief Build a tile info view of the tile storage at Index, the index must be valid
+ */
+FTileInfo AGridManager::MakeTileInfo(const int Index) const
+{
+	FTileInfo TileInfo(TileStorage.CanSpawnOn(Index), TileStorage.CanWalkOn(Index), TileStorage.GetActorOnTile(Index));
+	TileInfo.Position = TileStorage.IndexToPosition(Index);
+	return TileInfo;
+}
+
+/**
+ * @brief Write the flags and the actor of a tile info view back to the tile storage at Index, the index must be valid
+ */
+void AGridManager::ApplyTileInfo(const int Index, const FTileInfo& TileInfoIn)
+{
+	SetTileFlags(Index, TileInfoIn.bCanWalkOn, TileInfoIn.bCanSpawnOn);
+	if(TileStorage.GetActorOnTile(Index) != TileInfoIn.ActorOnTile) RecordTileChange(Index, EGridTileField::Occupant);
+	TileStorage.SetActorOnTile(Index, TileInfoIn.ActorOnTile);
+}
+
+/**
+ * @brief Write the walk and spawn flags of a tile, state derived from them is only updated if a flag changed
+ */
+void AGridManager::SetTileFlags(const int Index, const bool bCanWalkOn, const bool bCanSpawnOn)
+{
+	const bool bWalkChanged = TileStorage.CanWalkOn(Index) != bCanWalkOn;
+	const bool bSpawnChanged = TileStorage.CanSpawnOn(Index) != bCanSpawnOn;
+	if(!bWalkChanged && !bSpawnChanged) return;
+
+	RecordTileChange(Index, (bWalkChanged ? EGridTileField::Walkable : EGridTileField::None) | (bSpawnChanged ? EGridTileField::Spawnable : EGridTileField::None));
+
+	TileStorage.SetCanSpawnOn(Index, bCanSpawnOn);
+	if(bWalkChanged)
+	{
+		// Only walk writes bump the walk version, spawn changes leave the snapshots and fields alone
+		TileStorage.SetCanWalkOn(Index, bCanWalkOn);
+		if(RegionLabels.IsBuilt()) RegionLabels.OnWalkableChanged(TileStorage.GetWalkableBits(), Index);
+		FlowFields.OnWalkableChanged(TileStorage, Index);
+		const FIntPoint Position = TileStorage.IndexToPosition(Index);
+		Hierarchy.MarkRectDirty(FIntRect(Position, Position + FIntPoint(1, 1)));
+	}
+	OnTileFlagsChanged(Index);
+}
+
+/**
+ * @brief Called once after a batch that may have changed the walk or spawn flags of tiles inside a rect
+ * @param Tiles Min row/column included, Max excluded
+ */
+void AGridManager::OnTilesFlagsChanged(const FIntRect& Tiles)
+{
+	if(Tiles.IsEmpty() || TileStorage.IsPaged()) return;
+
+	// Batches may flip any number of tiles, the regions are labeled again on the next query
+	RegionLabels.Invalidate();
+	Hierarchy.MarkRectDirty(Tiles);
+
+	// Flow fields notice the walk version changed and rebuild on the next tick
+	if(FlowFields.HasFields()) SetActorTickEnabled(true);
+
+	if(RenderMode == EGridRenderMode::Material)
+	{
+		MarkTileStateRectDirty(Tiles);
+	}
+	else
+	{
+		MarkOverlayRectDirty(Tiles);
+	}
+}
+
+/**
+ * @brief Called after the walk or spawn flag of a tile changed
+ */
+void AGridManager::OnTileFlagsChanged(const int Index)
+{
+	// Paged grids have no overlay or tile state texture to keep up to date
+	if(TileStorage.IsPaged()) return;
+
+	if(RenderMode == EGridRenderMode::Material)
+	{
+		MarkTileStateTexelDirty(Index);
+	}
+	else
+	{
+		MarkOverlayTileDirty(Index);
+	}
+}
+
+bool AGridManager::IsRecordingTileChanges() const
+{
+	return OnTilesChanged.IsBound() || OnTilesChangedNative.IsBound() || ReplicatedTiles.IsTracking() || TileSnapshots.IsValid();
+}
+
+/**
+ * @brief Add the fields to the tile entry of this frame deltas and dirty the replicated and snapshot chunks of the tile.
+ * Nothing is kept while no listener is bound and the tiles are neither replicated nor snapshot
+ */
+void AGridManager::RecordTileChange(const int Index, const EGridTileField Fields)
+{
+	if(Fields == EGridTileField::None) return;
+
+	// The first change of the frame wakes the tick that flushes them
+	if(TileSnapshots.IsValid())
+	{
+		if(!TileSnapshots->HasChanges()) SetActorTickEnabled(true);
+		TileSnapshots->MarkTileDirty(Index);
+	}
+
+	if(ReplicatedTiles.IsTracking() && EnumHasAnyFlags(Fields, EGridTileField::Walkable | EGridTileField::Spawnable))
+	{
+		if(!ReplicatedTiles.HasDirtyChunks()) SetActorTickEnabled(true);
+		ReplicatedTiles.MarkTileDirty(Index);
+	}
+
+	if(!OnTilesChanged.IsBound() && !OnTilesChangedNative.IsBound()) return;
+
+	if(!TileDeltas.HasChanges()) SetActorTickEnabled(true);
+	TileDeltas.Record(Index, static_cast<uint8>(Fields));
+}
+
+void AGridManager::RecordAllTilesChanged(const EGridTileField Fields)
+{
+	if(Fields == EGridTileField::None) return;
+
+	if(TileSnapshots.IsValid())
+	{
+		if(!TileSnapshots->HasChanges()) SetActorTickEnabled(true);
+		TileSnapshots->MarkAllDirty();
+	}
+
+	if(ReplicatedTiles.IsTracking() && EnumHasAnyFlags(Fields, EGridTileField::Walkable | EGridTileField::Spawnable))
+	{
+		if(!ReplicatedTiles.HasDirtyChunks()) SetActorTickEnabled(true);
+		ReplicatedTiles.MarkAllDirty();
+	}
+
+	if(!OnTilesChanged.IsBound() && !OnTilesChangedNative.IsBound()) return;
+
+	if(!TileDeltas.HasChanges()) SetActorTickEnabled(true);
+	TileDeltas.RecordAll(static_cast<uint8>(Fields));
+}
+
+/**
+ * @brief Broadcast the tiles changed since the last flush once, then clear them
+ */
+void AGridManager::FlushTileDeltas()
+{
+	if(!TileDeltas.HasChanges()) return;
+
+	// Taken out before broadcasting, tiles written by the listeners are reported on the next flush
+	uint8 AllTilesFields = 0;
+	TileDeltas.Flush(FlushedTileIndices, FlushedTileFields, AllTilesFields);
+	OnTilesChangedNative.Broadcast(FlushedTileIndices, FlushedTileFields, AllTilesFields);
+	OnTilesChanged.Broadcast(FlushedTileIndices, FlushedTileFields, AllTilesFields);
+}
+
+TSharedPtr<FGridTileSnapshots, ESPMode::ThreadSafe> AGridManager::GetTileSnapshots()
+{
+	check(IsInGameThread());
+	if(!IsGridInfoInitialized() || TileStorage.IsPaged()) return nullptr;
+
+	// Readers may pin right away, the first version is published now instead of on the next tick
+	if(!TileSnapshots.IsValid())
+	{
+		TileSnapshots = MakeShared<FGridTileSnapshots, ESPMode::ThreadSafe>();
+		TileSnapshots->Init(NumRows, NumColumns);
+		TileSnapshots->Publish(TileStorage);
+	}
+	return TileSnapshots;
+}
+
+/**
+ * @brief Patch the walk and spawn flags of the tiles of a chunk received from the server.
+ * A few changed tiles go through the per tile write, more are copied a word at a time like the batch writes
+ */
+void AGridManager::ApplyReplicatedChunk(const int32 ChunkIndex, const TArray<uint8>& Payload)
+{
+	// Chunks received before BeginPlay built the tiles are applied by it
+	if(!IsGridInfoInitialized() || !bStartingModifiersInitialized || TileStorage.IsPaged()) return;
+	GRID_STAT_SCOPE(SetTileInfo);
+
+	const int32 TotalWords = TileStorage.GetWalkableBits().NumWords();
+	const int32 FirstWord = ChunkIndex * FGridReplicatedChunks::ChunkWords;
+	const int32 NumWords = FMath::Min(FGridReplicatedChunks::ChunkWords, TotalWords - FirstWord);
+	if(ChunkIndex < 0 || NumWords <= 0 || !FGridReplicatedChunks::DecodeChunk(Payload, NumWords, ReceivedWalkWords, ReceivedSpawnWords))
+	{
+		GRID_STAT_ERROR(SetTileInfo);
+		UE_LOG(LogTemp, Error, TEXT("%s() Replicated chunk %d does not match the grid size"), *FString(__FUNCTION__), ChunkIndex);
+		return;
+	}
+
+	const uint64* Walkable = TileStorage.GetWalkableBits().GetWords() + FirstWord;
+	const uint64* Spawnable = TileStorage.GetSpawnableBits().GetWords() + FirstWord;
+	int32 NumChanged = 0;
+	for (int32 Word = 0; Word < NumWords; ++Word)
+	{
+		NumChanged += FMath::CountBits((Walkable[Word] ^ ReceivedWalkWords[Word]) | (Spawnable[Word] ^ ReceivedSpawnWords[Word]));
+	}
+	if(NumChanged == 0) return;
+	GRID_STAT_TILES(SetTileInfo, NumChanged);
+
+	const bool bPerTile = NumChanged <= FGridReplicatedChunks::MaxPerTilePatch;
+	for (int32 Word = 0; Word < NumWords; ++Word)
+	{
+		uint64 Changed = (Walkable[Word] ^ ReceivedWalkWords[Word]) | (Spawnable[Word] ^ ReceivedSpawnWords[Word]);
+		while (Changed != 0)
+		{
+			const int32 Bit = static_cast<int32>(FMath::CountTrailingZeros64(Changed));
+			const int Index = ((FirstWord + Word) << 6) + Bit;
+			Changed &= Changed - 1;
+			if(Index >= TileStorage.Num()) break;
+
+			const bool bCanWalkOn = (ReceivedWalkWords[Word] >> Bit) & 1ull;
+			const bool bCanSpawnOn = (ReceivedSpawnWords[Word] >> Bit) & 1ull;
+			if(bPerTile)
+			{
+				SetTileFlags(Index, bCanWalkOn, bCanSpawnOn);
+			}
+			else
+			{
+				RecordTileChange(Index, (TileStorage.CanWalkOn(Index) != bCanWalkOn ? EGridTileField::Walkable : EGridTileField::None) |
+					(TileStorage.CanSpawnOn(Index) != bCanSpawnOn ? EGridTileField::Spawnable : EGridTileField::None));
+			}
+		}
+	}
+	if(bPerTile) return;
+
+	TileStorage.SetFlagWords(FirstWord, NumWords, ReceivedWalkWords.GetData(), ReceivedSpawnWords.GetData());
+	const int LastIndex = FMath::Min((FirstWord + NumWords) << 6, TileStorage.Num()) - 1;
+	OnTilesFlagsChanged(FIntRect((FirstWord << 6) / NumColumns, 0, LastIndex / NumColumns + 1, NumColumns));
+}
+
+/**
+ * @brief Apply every chunk received so far, for the chunks that arrived before the tiles were built
+ */
+void AGridManager::ApplyReplicatedChunks()
+{
+	for (const FGridReplicatedChunk& Chunk : ReplicatedTiles.Items)
+	{
+		ApplyReplicatedChunk(Chunk.ChunkIndex, Chunk.Payload);
+	}
+}
+
+/**
+ * @brief Get Tile info at Index
+ * @param Index index in array
+ * @return FTileInfo(-1, -1) if index out of range or array not initialized
+ */
+FTileInfo AGridManager::GetTileInfoAtIndexCopy(const int Index) const
+{
+	GRID_STAT_SCOPE(GetTileInfo);
+	if(!IsGridInfoInitialized())
+	{
+		GRID_STAT_ERROR(GetTileInfo);
+		UE_LOG(LogTemp, Error, TEXT("%s() Tiles info array not initialized"), *FString(__FUNCTION__));
+		return FTileInfo(-1, -1);
+	}
+	
+	if(Index < 0 || Index > TileStorage.Num()-1)
+	{
+		GRID_STAT_ERROR(GetTileInfo);
+		UE_LOG(LogTemp, Error, TEXT("%s() Index out of bound"), *FString(__FUNCTION__));
+		return FTileInfo(-1, -1);
+	}
+
+	GRID_STAT_TILES(GetTileInfo, 1);
+	return MakeTileInfo(Index);
+}
+
+/**
+ * @brief Set Tile Info at Index
+ * @param Index index in array
+ * @param TileInfoIn Tile Info to Set
+ * @return false if index out of range or array not initialized
+ */
+bool AGridManager::SetTileInfoAtIndex(const int Index, const FTileInfo TileInfoIn)
+{
+	GRID_STAT_SCOPE(SetTileInfo);
+	if(!IsGridInfoInitialized())
+	{
+		GRID_STAT_ERROR(SetTileInfo);
+		UE_LOG(LogTemp, Error, TEXT("%s() Tiles info array not initialized"), *FString(__FUNCTION__));
+		return false;
+	}
+	
+	if(Index < 0 || Index > TileStorage.Num()-1)
+	{
+		GRID_STAT_ERROR(SetTileInfo);
+		UE_LOG(LogTemp, Error, TEXT("%s() Index out of bound"), *FString(__FUNCTION__));
+		return false;
+	}
+
+	GRID_STAT_TILES(SetTileInfo, 1);
+	ApplyTileInfo(Index, TileInfoIn);
+	return true;
+}
+
+/**
+ * @brief Get Tile Info of position Row, Column Complexity O(1)
+ * @param Row starting 0
+ * @param Column starting 0
+ * @return FTileInfo(-1, -1) if position out of range or array not initialized
+ */
+FTileInfo AGridManager::GetTileInfoAtPositionCopy(const int Row, const int Column, bool& bValid) const
+{
+	GRID_STAT_SCOPE(GetTileInfo);
+	if(!IsGridInfoInitialized())
+	{
+		GRID_STAT_ERROR(GetTileInfo);
+		UE_LOG(LogTemp, Error, TEXT("%s() Tiles info array not initialized in"), *FString(__FUNCTION__));
+		bValid = false;
+		return FTileInfo(-1, -1);
+	}
+	
+	if(!IsValidTile(Row, Column))
+	{
+		GRID_STAT_ERROR(GetTileInfo);
+		UE_LOG(LogTemp, Error, TEXT("%s() Position out of grid range"), *FString(__FUNCTION__));
+		bValid = false;
+		return FTileInfo(-1, -1);
+	}
+	
+	GRID_STAT_TILES(GetTileInfo, 1);
+	bValid = true;
+	return MakeTileInfo(GetTileIndex(Row, Column));
+}
+
+FTileInfo AGridManager::GetTileInfoAtPositionWithLocation(const int Row, const int Column, FVector& TileLocation,  bool& bValid) const
+{
+	TileLocation = TileToGridLocation(Row, Column, bValid);
+	return GetTileInfoAtPositionCopy(Row, Column, bValid);
+}
+
+/**
+ * @brief Set the Tile Info of position Row, Column Complexity O(1)
+ * @param Row starting 0
+ * @param Column starting 0
+ * @param TileInfoIn Tile Info to Set 
+ * @return false if position out of range or array not initialized
+ */
+bool AGridManager::SetTileInfoAtPosition(const int Row, const int Column, const FTileInfo TileInfoIn)
+{
+	GRID_STAT_SCOPE(SetTileInfo);
+	if(!IsGridInfoInitialized())
+	{
+		GRID_STAT_ERROR(SetTileInfo);
+		UE_LOG(LogTemp, Error, TEXT("%s() Tiles info array not initialized"), *FString(__FUNCTION__));
+		return false;
+	}
+	
+	if(!IsValidTile(Row, Column))
+	{
+		GRID_STAT_ERROR(SetTileInfo);
+		UE_LOG(LogTemp, Error, TEXT("%s() Position out of grid range"), *FString(__FUNCTION__));
+		return false;
+	}
+	
+	GRID_STAT_TILES(SetTileInfo, 1);
+	ApplyTileInfo(GetTileIndex(Row, Column), TileInfoIn);
+	return true;
+}
+
+/**
+ * @brief Set the state of every tile of a rect in one pass, downstream state is updated once for the whole rect
+ * @param EndRow Last row, included. The rect is clipped to the grid
+ * @param EndColumn Last column, included
+ * @param Fields EGridTileField flags of the fields to write, other fields are left untouched
+ * @return false if the array is not initialized or the rect is outside the grid
+ */
+bool AGridManager::SetTilesInRect(const int StartRow, const int StartColumn, const int EndRow, const int EndColumn, const int32 Fields, const bool bCanWalkOn, const bool bCanSpawnOn, AActor* Actor)
+{
+	GRID_STAT_SCOPE(SetTileInfo);
+	if(!IsGridInfoInitialized())
+	{
+		GRID_STAT_ERROR(SetTileInfo);
+		UE_LOG(LogTemp, Error, TEXT("%s() Tiles info array not initialized"), *FString(__FUNCTION__));
+		return false;
+	}
+
+	const FIntRect Tiles(FMath::Max(FMath::Min(StartRow, EndRow), 0), FMath::Max(FMath::Min(StartColumn, EndColumn), 0),
+		FMath::Min(FMath::Max(StartRow, EndRow) + 1, NumRows), FMath::Min(FMath::Max(StartColumn, EndColumn) + 1, NumColumns));
+	if(Tiles.Min.X >= Tiles.Max.X || Tiles.Min.Y >= Tiles.Max.Y) return false;
+
+	GRID_STAT_TILES(SetTileInfo, Tiles.Area());
+	const EGridTileField FieldFlags = static_cast<EGridTileField>(Fields);
+	for (int Row = Tiles.Min.X; Row < Tiles.Max.X; ++Row)
+	{
+		const int RowStart = GetTileIndex(Row, Tiles.Min.Y);
+		// Rows run along X, so the columns of one row span the rect height
+		if(EnumHasAnyFlags(FieldFlags, EGridTileField::Walkable)) TileStorage.SetCanWalkOnRange(RowStart, Tiles.Height(), bCanWalkOn);
+		if(EnumHasAnyFlags(FieldFlags, EGridTileField::Spawnable)) TileStorage.SetCanSpawnOnRange(RowStart, Tiles.Height(), bCanSpawnOn);
+		if(EnumHasAnyFlags(FieldFlags, EGridTileField::Occupant))
+		{
+			for (int Index = RowStart; Index < RowStart + Tiles.Height(); ++Index)
+			{
+				TileStorage.SetActorOnTile(Index, Actor);
+			}
+		}
+	}
+
+	// Every written tile is listed, comparing them would cost more than the writes
+	if(IsRecordingTileChanges())
+	{
+		for (int Row = Tiles.Min.X; Row < Tiles.Max.X; ++Row)
+		{
+			for (int Column = Tiles.Min.Y; Column < Tiles.Max.Y; ++Column)
+			{
+				RecordTileChange(GetTileIndex(Row, Column), FieldFlags);
+			}
+		}
+	}
+
+	if(EnumHasAnyFlags(FieldFlags, EGridTileField::Walkable | EGridTileField::Spawnable))
+	{
+		OnTilesFlagsChanged(Tiles);
+	}
+	return true;
+}
+
+/**
+ * @brief Set the state of a list of tiles in one pass, downstream state is updated once for all of them
+ * @param Fields EGridTileField flags of the fields to write, other fields are left untouched
+ * @return false if the array is not initialized or an index is out of bound, valid indices are still written
+ */
+bool AGridManager::SetTilesAtIndices(const TArray<int>& Indices, const int32 Fields, const bool bCanWalkOn, const bool bCanSpawnOn, AActor* Actor)
+{
+	GRID_STAT_SCOPE(SetTileInfo);
+	if(!IsGridInfoInitialized())
+	{
+		GRID_STAT_ERROR(SetTileInfo);
+		UE_LOG(LogTemp, Error, TEXT("%s() Tiles info array not initialized"), *FString(__FUNCTION__));
+		return false;
+	}
+
+	const EGridTileField FieldFlags = static_cast<EGridTileField>(Fields);
+	FIntRect ChangedTiles(NumRows, NumColumns, 0, 0);
+	int InvalidIndices = 0;
+	for (const int Index : Indices)
+	{
+		if(Index < 0 || Index >= TileStorage.Num())
+		{
+			++InvalidIndices;
+			continue;
+		}
+
+		if(EnumHasAnyFlags(FieldFlags, EGridTileField::Walkable)) TileStorage.SetCanWalkOn(Index, bCanWalkOn);
+		if(EnumHasAnyFlags(FieldFlags, EGridTileField::Spawnable)) TileStorage.SetCanSpawnOn(Index, bCanSpawnOn);
+		if(EnumHasAnyFlags(FieldFlags, EGridTileField::Occupant)) TileStorage.SetActorOnTile(Index, Actor);
+		ChangedTiles.Include(TileStorage.IndexToPosition(Index));
+		RecordTileChange(Index, FieldFlags);
+	}
+
+	if(EnumHasAnyFlags(FieldFlags, EGridTileField::Walkable | EGridTileField::Spawnable) && ChangedTiles.Min.X <= ChangedTiles.Max.X)
+	{
+		OnTilesFlagsChanged(FIntRect(ChangedTiles.Min, ChangedTiles.Max + FIntPoint(1, 1)));
+	}
+
+	GRID_STAT_TILES(SetTileInfo, Indices.Num() - InvalidIndices);
+	if(InvalidIndices > 0)
+	{
+		GRID_STAT_ERROR(SetTileInfo);
+		UE_LOG(LogTemp, Error, TEXT("%s() %d indices out of bound"), *FString(__FUNCTION__), InvalidIndices);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Set the state of every tile set in Mask, flags are written a whole word at a time
+ * @param Mask One bit per tile, indexed like the tiles info
+ * @param Fields Fields to write, other fields are left untouched
+ * @return false if the array is not initialized or the mask does not match the grid size
+ */
+bool AGridManager::SetTilesFromMask(const FGridBitset& Mask, const EGridTileField Fields, const bool bCanWalkOn, const bool bCanSpawnOn, AActor* Actor)
+{
+	GRID_STAT_SCOPE(SetTileInfo);
+	if(!IsGridInfoInitialized() || Mask.Num() != TileStorage.Num())
+	{
+		GRID_STAT_ERROR(SetTileInfo);
+		UE_LOG(LogTemp, Error, TEXT("%s() Tiles info array not initialized or mask size mismatch"), *FString(__FUNCTION__));
+		return false;
+	}
+
+	const int FirstIndex = Mask.FindFirstSetBit();
+	if(FirstIndex == INDEX_NONE) return true;
+
+	GRID_STAT_TILES(SetTileInfo, Mask.CountSetBits());
+
+	if(EnumHasAnyFlags(Fields, EGridTileField::Walkable)) TileStorage.SetCanWalkOnMasked(Mask, bCanWalkOn);
+	if(EnumHasAnyFlags(Fields, EGridTileField::Spawnable)) TileStorage.SetCanSpawnOnMasked(Mask, bCanSpawnOn);
+	if(EnumHasAnyFlags(Fields, EGridTileField::Occupant))
+	{
+		for (int Index = FirstIndex; Index < Mask.Num(); ++Index)
+		{
+			if(Mask.Get(Index)) TileStorage.SetActorOnTile(Index, Actor);
+		}
+	}
+
+	if(IsRecordingTileChanges())
+	{
+		for (int Index = FirstIndex; Index < Mask.Num(); ++Index)
+		{
+			if(Mask.Get(Index)) RecordTileChange(Index, Fields);
+		}
+	}
+
+	// Rows spanned by the mask, whole rows are cheaper to find than the exact columns
+	if(EnumHasAnyFlags(Fields, EGridTileField::Walkable | EGridTileField::Spawnable))
+	{
+		OnTilesFlagsChanged(FIntRect(FirstIndex / NumColumns, 0, Mask.FindLastSetBit() / NumColumns + 1, NumColumns));
+	}
+	return true;
+}
+
+void AGridManager::GetGridRowsAndColumns(int& Row, int& Column) const
+{
+	Row = NumRows;
+	Column = NumColumns;
+}
+
+TArray<FTileInfo> AGridManager::GetNeighboringTiles(const int Row, const int Column, const int NeighboringRows, const int NeighboringColumns)
+{
+	GRID_STAT_SCOPE(Neighbors);
+	TArray<FTileInfo> Neighbors;
+	if(!IsGridInfoInitialized()) return Neighbors;
+
+	const FIntRect Tiles = FGridTileQuery::ClipRect(TileStorage, FIntRect(Row - NeighboringRows, Column - NeighboringColumns, Row + NeighboringRows + 1, Column + NeighboringColumns + 1));
+	Neighbors.Reserve(Tiles.Area());
+	GRID_STAT_ALLOCATION(Neighbors);
+	FGridTileQuery::ForEachTileInRect(TileStorage, Tiles, FGridTileFilter(FGridTileFilter::Walkable), [this, &Neighbors](const int32 Index)
+	{
+		const FIntPoint Position = TileStorage.IndexToPosition(Index);
+		Neighbors.Add(FTileInfo(Position.X, Position.Y));
+	});
+	GRID_STAT_TILES(Neighbors, Tiles.Area());
+	return Neighbors;
+}
+
+int AGridManager::GetTilesInRect(const int StartRow, const int StartColumn, const int EndRow, const int EndColumn, const int32 RequiredFields, const int32 ExcludedFields, TArray<FIntPoint>& OutTiles) const
+{
+	GRID_STAT_SCOPE(Neighbors);
+	OutTiles.Reset();
+	if(!IsGridInfoInitialized()) return 0;
+
+	const FIntRect Tiles(FMath::Min(StartRow, EndRow), FMath::Min(StartColumn, EndColumn), FMath::Max(StartRow, EndRow) + 1, FMath::Max(StartColumn, EndColumn) + 1);
+	GRID_STAT_TILES(Neighbors, FGridTileQuery::ClipRect(TileStorage, Tiles).Area());
+	return FGridTileQuery::ForEachTileInRect(TileStorage, Tiles, FGridTileFilter(static_cast<uint8>(RequiredFields), static_cast<uint8>(ExcludedFields)), [this, &OutTiles](const int32 Index)
+	{
+		OutTiles.Add(TileStorage.IndexToPosition(Index));
+	});
+}
+
+int AGridManager::GetAdjacentTiles(const int Row, const int Column, const bool bEightConnected, const int32 RequiredFields, const int32 ExcludedFields, TArray<FIntPoint>& OutTiles) const
+{
+	GRID_STAT_SCOPE(Neighbors);
+	OutTiles.Reset();
+	if(!IsGridInfoInitialized() || !IsValidTile(Row, Column)) return 0;
+
+	const EGridConnectivity Connectivity = bEightConnected ? EGridConnectivity::Eight : EGridConnectivity::Four;
+	GRID_STAT_TILES(Neighbors, bEightConnected ? 8 : 4);
+	return FGridTileQuery::ForEachNeighbor(TileStorage, GetTileIndex(Row, Column), Connectivity, FGridTileFilter(static_cast<uint8>(RequiredFields), static_cast<uint8>(ExcludedFields)), [this, &OutTiles](const int32 Index)
+	{
+		OutTiles.Add(TileStorage.IndexToPosition(Index));
+	});
+}
+
+bool AGridManager::HasLineOfSight(const int FromRow, const int FromColumn, const int ToRow, const int ToColumn, const int32 RequiredFields, const int32 ExcludedFields) const
+{
+	if(!IsGridInfoInitialized()) return false;
+	return FGridLineOfSight::HasLineOfSight(TileStorage, FIntPoint(FromRow, FromColumn), FIntPoint(ToRow, ToColumn), MakeSightFilter(RequiredFields, ExcludedFields));
+}
+
+bool AGridManager::RaycastTiles(const int FromRow, const int FromColumn, const int ToRow, const int ToColumn, const int32 RequiredFields, const int32 ExcludedFields, FIntPoint& OutHitTile) const
+{
+	OutHitTile = FIntPoint(FromRow, FromColumn);
+	if(!IsGridInfoInitialized()) return true;
+	return FGridLineOfSight::Raycast(TileStorage, FIntPoint(FromRow, FromColumn), FIntPoint(ToRow, ToColumn), MakeSightFilter(RequiredFields, ExcludedFields), OutHitTile);
+}
+
+void AGridManager::HasLineOfSightBatch(const TArray<FIntPoint>& Origins, const TArray<FIntPoint>& Targets, const int32 RequiredFields, const int32 ExcludedFields, TArray<bool>& OutVisible) const
+{
+	OutVisible.Init(false, Origins.Num());
+	if(Origins.Num() != Targets.Num())
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s() %d origins for %d targets"), *FString(__FUNCTION__), Origins.Num(), Targets.Num());
+		return;
+	}
+	if(!IsGridInfoInitialized()) return;
+
+	FGridLineOfSight::HasLineOfSightBatch(TileStorage, Origins, Targets, MakeSightFilter(RequiredFields, ExcludedFields), OutVisible);
+}
+
+int AGridManager::GetVisibleTiles(const int Row, const int Column, const int Radius, const int32 RequiredFields, const int32 ExcludedFields, TArray<FIntPoint>& OutTiles) const
+{
+	OutTiles.Reset();
+	if(!IsGridInfoInitialized()) return 0;
+
+	return FGridLineOfSight::ForEachVisibleTile(TileStorage, FIntPoint(Row, Column), Radius, MakeSightFilter(RequiredFields, ExcludedFields), [this, &OutTiles](const int32 Index)
+	{
+		OutTiles.Add(TileStorage.IndexToPosition(Index));
+	});
+}
+
+/**
+ * @brief Filter of the tiles sight goes through, the blocking layer is skipped on paged grids which have no planes
+ */
+FGridTileFilter AGridManager::MakeSightFilter(const int32 RequiredFields, const int32 ExcludedFields) const
+{
+	FGridTileFilter Filter(static_cast<uint8>(RequiredFields), static_cast<uint8>(ExcludedFields));
+	const int32 Layer = TileStorage.IsPaged() ? INDEX_NONE : TileStorage.GetAttributes().FindLayer(SightBlockingLayer);
+	if(Layer != INDEX_NONE)
+	{
+		Filter.AttributeLayer = Layer;
+		Filter.MinAttribute = -MAX_flt;
+		Filter.MaxAttribute = SightBlockingValue;
+	}
+	return Filter;
+}
+
+/**
+ * @brief Find a walkable path between two tiles, diagonal moves never cut corners. Tiles at least
+ * HierarchicalPathMinDistance apart on a grid without path cost layer get a near optimal path through the cluster
+ * graph, refined whole before returning. Other queries get the shortest path from jump point search, or from A* over
+ * the path cost layer when it is set
+ * @param OutTiles Every tile of the path from start to goal (both included)
+ * @param OutLocations Center world location of every tile in OutTiles
+ * @return false if the grid is not initialized, a tile is not walkable or the goal can't be reached
+ */
+bool AGridManager::FindPath(const int StartRow, const int StartColumn, const int GoalRow, const int GoalColumn, TArray<FIntPoint>& OutTiles, TArray<FVector>& OutLocations)
+{
+	OutLocations.Reset();
+	if(!IsGridInfoInitialized())
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s() Tiles info array not initialized"), *FString(__FUNCTION__));
+		OutTiles.Reset();
+		return false;
+	}
+
+	const FIntPoint Start(StartRow, StartColumn);
+	const FIntPoint Goal(GoalRow, GoalColumn);
+	if(TileStorage.IsPaged())
+	{
+		// Search a window copied out of the pages around start and goal
+		const TSharedRef<FGridWalkSnapshot, ESPMode::ThreadSafe> Window = FGridPathQueryScheduler::MakeWindowSnapshot(TileStorage, Start, Goal, PagedPathMargin);
+		if(!Pathfinder.FindPath(Window->Walkable, Window->NumRows, Window->NumColumns, Start - Window->Origin, Goal - Window->Origin, OutTiles))
+		{
+			return false;
+		}
+		for (FIntPoint& Tile : OutTiles)
+		{
+			Tile += Window->Origin;
+		}
+	}
+	else
+	{
+		// Labels already built answer unreachable goals without searching the whole start region
+		if(RegionLabels.IsBuilt() && IsValidTile(StartRow, StartColumn) && IsValidTile(GoalRow, GoalColumn)
+			&& !RegionLabels.AreConnected(GetTileIndex(StartRow, StartColumn), GetTileIndex(GoalRow, GoalColumn)))
+		{
+			OutTiles.Reset();
+			return false;
+		}
+
+		const FGridAttributeLayers& Attributes = TileStorage.GetAttributes();
+		const int CostLayer = Attributes.FindLayer(PathCostLayer);
+		const FIntPoint Delta = Goal - Start;
+		if(CostLayer == INDEX_NONE && HierarchicalPathMinDistance > 0 && FMath::Max(FMath::Abs(Delta.X), FMath::Abs(Delta.Y)) >= HierarchicalPathMinDistance
+			&& IsValidTile(StartRow, StartColumn) && IsValidTile(GoalRow, GoalColumn))
+		{
+			// Far apart tiles search the cluster graph then only the tiles along it
+			if(!FindHierarchicalPath(GetTileIndex(StartRow, StartColumn), GetTileIndex(GoalRow, GoalColumn), OutTiles))
+			{
+				return false;
+			}
+		}
+		else
+		{
+			const FGridAttributePlaneView Costs = CostLayer != INDEX_NONE ? Attributes.GetPlaneView(CostLayer) : FGridAttributePlaneView();
+			if(!Pathfinder.FindPathWeighted(TileStorage.GetWalkableBits(), Costs, NumRows, NumColumns, Start, Goal, OutTiles))
+			{
+				return false;
+			}
+		}
+	}
+
+	OutLocations.Reserve(OutTiles.Num());
+	for (const FIntPoint& Tile : OutTiles)
+	{
+		bool bValid;
+		OutLocations.Add(TileToWalkGridLocation(Tile.X, Tile.Y, bValid));
+	}
+	return true;
+}
+
+/**
+ * @brief Queue a path query solved on worker threads, OnComplete is called on the game thread on a later tick
+ * @return Request id, INDEX_NONE if the grid is not initialized
+ */
+int32 AGridManager::RequestPathAsync(const int StartRow, const int StartColumn, const int GoalRow, const int GoalColumn, FOnGridPathQueryComplete OnComplete)
+{
+	return EnqueuePathQuery(FIntPoint(StartRow, StartColumn), FIntPoint(GoalRow, GoalColumn), false, [this, OnComplete](const int32 RequestId, const bool bSuccess, const TArray<FIntPoint>& Path)
+	{
+		TArray<FVector> Locations;
+		Locations.Reserve(Path.Num());
+		for (const FIntPoint& Tile : Path)
+		{
+			bool bValid;
+			Locations.Add(TileToGridLocation(Tile.X, Tile.Y, bValid));
+		}
+		OnComplete.ExecuteIfBound(RequestId, bSuccess, Path, Locations);
+	});
+}
+
+/**
+ * @brief Queue a query checking if the goal can be reached from the start, OnComplete is called on the game thread on a later tick
+ * @return Request id, INDEX_NONE if the grid is not initialized
+ */
+int32 AGridManager::RequestReachabilityAsync(const int StartRow, const int StartColumn, const int GoalRow, const int GoalColumn, FOnGridReachabilityQueryComplete OnComplete)
+{
+	return EnqueuePathQuery(FIntPoint(StartRow, StartColumn), FIntPoint(GoalRow, GoalColumn), true, [OnComplete](const int32 RequestId, const bool bSuccess, const TArray<FIntPoint>&)
+	{
+		OnComplete.ExecuteIfBound(RequestId, bSuccess);
+	});
+}
+
+bool AGridManager::FindAbstractPath(const int StartRow, const int StartColumn, const int GoalRow, const int GoalColumn, TArray<FIntPoint>& OutWaypoints)
+{
+	OutWaypoints.Reset();
+	if(!IsGridInfoInitialized() || !Hierarchy.IsInitialized())
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s() Tiles info array not initialized or paged"), *FString(__FUNCTION__));
+		return false;
+	}
+	if(!IsValidTile(StartRow, StartColumn) || !IsValidTile(GoalRow, GoalColumn)) return false;
+
+	TArray<int32> Waypoints;
+	Hierarchy.Update(TileStorage.GetWalkableBits());
+	if(!Hierarchy.FindAbstractPath(TileStorage.GetWalkableBits(), GetTileIndex(StartRow, StartColumn), GetTileIndex(GoalRow, GoalColumn), Waypoints))
+	{
+		return false;
+	}
+
+	OutWaypoints.Reserve(Waypoints.Num());
+	for (const int32 Waypoint : Waypoints)
+	{
+		OutWaypoints.Add(TileStorage.IndexToPosition(Waypoint));
+	}
+	return true;
+}
+
+bool AGridManager::RefinePathSegment(const int FromRow, const int FromColumn, const int ToRow, const int ToColumn, TArray<FIntPoint>& OutTiles)
+{
+	OutTiles.Reset();
+	if(!IsGridInfoInitialized() || !Hierarchy.IsInitialized())
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s() Tiles info array not initialized or paged"), *FString(__FUNCTION__));
+		return false;
+	}
+	if(!IsValidTile(FromRow, FromColumn) || !IsValidTile(ToRow, ToColumn)) return false;
+
+	TArray<int32> Tiles;
+	Hierarchy.Update(TileStorage.GetWalkableBits());
+	if(!Hierarchy.RefineSegment(TileStorage.GetWalkableBits(), GetTileIndex(FromRow, FromColumn), GetTileIndex(ToRow, ToColumn), Tiles))
+	{
+		return false;
+	}
+
+	OutTiles.Reserve(Tiles.Num());
+	for (const int32 Tile : Tiles)
+	{
+		OutTiles.Add(TileStorage.IndexToPosition(Tile));
+	}
+	return true;
+}
+
+bool AGridManager::AreConnected(const int RowA, const int ColumnA, const int RowB, const int ColumnB) const
+{
+	if(!EnsureRegionLabels() || !IsValidTile(RowA, ColumnA) || !IsValidTile(RowB, ColumnB)) return false;
+	return RegionLabels.AreConnected(GetTileIndex(RowA, ColumnA), GetTileIndex(RowB, ColumnB));
+}
+
+int AGridManager::GetRegionId(const int Row, const int Column) const
+{
+	if(!EnsureRegionLabels() || !IsValidTile(Row, Column)) return INDEX_NONE;
+	return RegionLabels.GetRegionId(GetTileIndex(Row, Column));
+}
+
+int32 AGridManager::AcquireFlowField(const TArray<FIntPoint>& GoalTiles)
+{
+	if(!IsGridInfoInitialized() || TileStorage.IsPaged())
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s() Tiles info array not initialized or paged"), *FString(__FUNCTION__));
+		return INDEX_NONE;
+	}
+
+	TArray<int32> Goals;
+	Goals.Reserve(GoalTiles.Num());
+	for (const FIntPoint& Tile : GoalTiles)
+	{
+		if(IsValidTile(Tile.X, Tile.Y)) Goals.Add(GetTileIndex(Tile.X, Tile.Y));
+	}
+
+	if(Goals.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s() No goal tile inside the grid"), *FString(__FUNCTION__));
+		return INDEX_NONE;
+	}
+
+	SetActorTickEnabled(true);
+	return FlowFields.Acquire(MoveTemp(Goals));
+}
+
+bool AGridManager::ReleaseFlowField(const int32 FieldId)
+{
+	return FlowFields.Release(FieldId);
+}
+
+bool AGridManager::IsFlowFieldReady(const int32 FieldId) const
+{
+	return FlowFields.Find(FieldId) != nullptr;
+}
+
+bool AGridManager::GetFlowDirection(const int32 FieldId, const int Row, const int Column, FVector& OutDirection) const
+{
+	OutDirection = FVector::ZeroVector;
+	const FGridFlowField* Field = FlowFields.Find(FieldId);
+	if(Field == nullptr || !IsValidTile(Row, Column)) return false;
+
+	const int Index = GetTileIndex(Row, Column);
+	if(Field->GetDistance(Index) == FGridFlowField::Unreachable) return false;
+
+	// Rows run along X and columns along Y
+	const FIntPoint Step = Field->GetStep(Index);
+	OutDirection = FVector(Step.X, Step.Y, 0.0f).GetSafeNormal();
+	return true;
+}
+
+bool AGridManager::GetFlowDirectionAtLocation(const int32 FieldId, const FVector Location, FVector& OutDirection) const
+{
+	int Row, Column;
+	bool bValid;
+	LocationToTile(Location, Row, Column, bValid);
+	if(!bValid)
+	{
+		OutDirection = FVector::ZeroVector;
+		return false;
+	}
+	return GetFlowDirection(FieldId, Row, Column, OutDirection);
+}
+
+float AGridManager::GetFlowDistance(const int32 FieldId, const int Row, const int Column) const
+{
+	const FGridFlowField* Field = FlowFields.Find(FieldId);
+	if(Field == nullptr || !IsValidTile(Row, Column)) return -1.0f;
+
+	const uint32 Distance = Field->GetDistance(GetTileIndex(Row, Column));
+	return Distance != FGridFlowField::Unreachable ? static_cast<float>(Distance) / FGridFlowField::StraightCost : -1.0f;
+}
+
+/**
+ * @brief Search the cluster graph between two walkable tiles then refine every segment of it into tiles.
+ * FindPath returns every tile so the segments are refined up front, FindAbstractPath and RefinePathSegment refine them on demand
+ * @param OutTiles Every tile of the path from start to goal (both included)
+ */
+bool AGridManager::FindHierarchicalPath(const int32 Start, const int32 Goal, TArray<FIntPoint>& OutTiles)
+{
+	OutTiles.Reset();
+	if(!Hierarchy.IsInitialized()) return false;
+
+	const FGridBitset& Walkable = TileStorage.GetWalkableBits();
+	TArray<int32> Waypoints;
+	Hierarchy.Update(Walkable);
+	if(!Hierarchy.FindAbstractPath(Walkable, Start, Goal, Waypoints)) return false;
+
+	TArray<int32> Tiles;
+	Tiles.Add(Start);
+	for (int32 i = 1; i < Waypoints.Num(); ++i)
+	{
+		if(!Hierarchy.RefineSegment(Walkable, Waypoints[i - 1], Waypoints[i], Tiles)) return false;
+	}
+
+	OutTiles.Reserve(Tiles.Num());
+	for (const int32 Tile : Tiles)
+	{
+		OutTiles.Add(TileStorage.IndexToPosition(Tile));
+	}
+	return true;
+}
+
+/**
+ * @brief Label the walkable regions if no label is up to date
+ * @return false if the grid is not initialized or paged, paged grids have no whole grid bitset to label
+ */
+bool AGridManager::EnsureRegionLabels() const
+{
+	if(!IsGridInfoInitialized() || TileStorage.IsPaged())
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s() Tiles info array not initialized or paged"), *FString(__FUNCTION__));
+		return false;
+	}
+
+	if(!RegionLabels.IsBuilt())
+	{
+		RegionLabels.Build(TileStorage.GetWalkableBits(), NumRows, NumColumns);
+	}
+	return true;
+}
+
+/**
+ * @brief Cancel a queued or running async query, its callback will not be called
+ */
+bool AGridManager::CancelPathQuery(const int32 RequestId)
+{
+	return PathQueryScheduler.Cancel(RequestId);
+}
+
+/**
+ * @brief Native form of the async queries. Queries are solved in batches of MaxPathQueriesPerFrame against
+ * a snapshot of the walk state taken at dispatch, tile changes made meanwhile only affect later batches
+ * @return Request id, INDEX_NONE if the grid is not initialized
+ */
+int32 AGridManager::EnqueuePathQuery(const FIntPoint Start, const FIntPoint Goal, const bool bReachabilityOnly, FGridPathQueryScheduler::FOnQueryComplete&& OnComplete)
+{
+	if(!IsGridInfoInitialized())
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s() Tiles info array not initialized"), *FString(__FUNCTION__));
+		return INDEX_NONE;
+	}
+
+	const int32 RequestId = PathQueryScheduler.Enqueue(Start, Goal, bReachabilityOnly, MoveTemp(OnComplete));
+	SetActorTickEnabled(true);
+	return RequestId;
+}
+
+void AGridManager::DisplayDebugInfoOnTile(const FVector& Location) const
+{
+	static const auto CVarGrid = IConsoleManager::Get().FindConsoleVariable(TEXT("ShowDebugGrid"));
+
+	if(CVarGrid->GetInt() != 0)
+	{
+		int Row, Column;
+		bool bValid;
+		LocationToTile(Location, Row, Column, bValid);
+		if(bValid)
+		{
+			const FVector TileLocation = TileToGridLocation(Row, Column, bValid, true, FVector(0, 0, 10.0f));
+			const FTileInfo TileInfo = GetTileInfoAtPositionCopy(Row, Column,bValid);
+			DrawDebugString(GetWorld(), TileLocation, FString::Printf(TEXT("X: %d \nY: %d \nWalkable %s \nSpawnable %s \n%s"), TileInfo.Position.X, TileInfo.Position.Y, TileInfo.bCanWalkOn ? *FString("True") : *FString("False"), TileInfo.bCanSpawnOn ? *FString("True") : *FString("False"), *GetNameSafe(TileInfo.ActorOnTile)), nullptr, FColor::White, 4.f);
+		}
+	}
+}
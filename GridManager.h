@@ -1,231 +1,751 @@
-﻿// Copyright Rekt Studios. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "GameFramework/Actor.h"
-
-#include "GridManager.generated.h"
-
-class UProceduralMeshComponent;
-
-USTRUCT(BlueprintType)
-struct FTileMod
-{
-	GENERATED_BODY()
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin=0))
-	int Row;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin=0))
-	int Column;
-
-	FTileMod(): Row(-1), Column(-1)
-	{
-	}
-
-	explicit FTileMod(int const NewRow, int const NewColumn): Row(NewRow), Column(NewColumn)
-	{
-	}
-};
-
-USTRUCT(BlueprintType)
-struct FTileInfo
-{
-	GENERATED_BODY()
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
-	FIntPoint Position;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	bool bCanSpawnOn;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	bool bCanWalkOn;
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
-	TObjectPtr<AActor> ActorOnTile;
-
-	FTileInfo(): Position(FIntPoint(-1,-1)), bCanSpawnOn(true), bCanWalkOn(true)
-	{
-	}
-
-	FTileInfo(int const Row, int const Column): bCanSpawnOn(true), bCanWalkOn(true)
-	{
-		Position.X = Row;
-		Position.Y = Column;
-	}
-
-	FTileInfo(const bool bNewCanSpawn, const bool bNewCanWalk): Position(FIntPoint(-1,-1))
-	{
-		bCanWalkOn = bNewCanWalk;
-		bCanSpawnOn = bNewCanSpawn;
-	}
-
-	FTileInfo(const bool bNewCanSpawn, const bool bNewCanWalk, AActor* NewActorOnTile)
-	{
-		bCanWalkOn = bNewCanWalk;
-		bCanSpawnOn = bNewCanSpawn;
-		ActorOnTile = NewActorOnTile;
-	}
-};
-
-UCLASS(meta=(PrioritizeCategories = "GridManager"))
-class AGridManager : public AActor
-{
-	GENERATED_BODY()
-	
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess))
-	TObjectPtr<UProceduralMeshComponent> LineMesh;
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess))
-	TObjectPtr<UProceduralMeshComponent> SelectionMesh;
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess))
-	TObjectPtr<UProceduralMeshComponent> NoWalkMesh;
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess))
-	TObjectPtr<UProceduralMeshComponent> NoSpawnMesh;
-	
-	
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Generation", meta=(AllowPrivateAccess))
-	int NumRows;
-	
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Generation", meta=(AllowPrivateAccess))
-	int NumColumns;
-	
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Generation", meta=(AllowPrivateAccess))
-	float TileSize;
-
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Generation", meta=(AllowPrivateAccess))
-	float LineThickness;
-
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Generation", meta=(AllowPrivateAccess))
-	float LineOpacity;
-	
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Generation", meta=(AllowPrivateAccess))
-	float SelectionOpacity;
-
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Generation", meta=(AllowPrivateAccess))
-	FLinearColor LineColor;
-
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Generation", meta=(AllowPrivateAccess))
-	FLinearColor SelectionColor;
-
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="GridManager|Generation", meta=(AllowPrivateAccess))
-	TObjectPtr<UMaterialInterface> MaterialInterface;
-	
-
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Modifiers", meta=(AllowPrivateAccess))
-	float NoWalkOpacity;
-	
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Modifiers", meta=(AllowPrivateAccess))
-	float NoSpawnOpacity;
-
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Modifiers", meta=(AllowPrivateAccess))
-	FLinearColor NoWalkColor;
-
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Modifiers", meta=(AllowPrivateAccess))
-	FLinearColor NoSpawnColor;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="GridManager|Modifiers", meta=(AllowPrivateAccess))
-	TArray<FTileMod> NoSpawningStartingTiles;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="GridManager|Modifiers", meta=(AllowPrivateAccess))
-	TArray<FTileMod> NoWalkingStartingTiles;
-
-	TArray<FTileInfo> TilesInfo;
-
-	bool bStartingModifiersInitialized;
-	
-public:	
-	AGridManager();
-
-protected:
-	virtual void OnConstruction(const FTransform& Transform) override;
-	virtual void BeginPlay() override;
-
-	void GenerateTileInfo();
-	void InitializeStartingTilesModifiers();
-	TObjectPtr<UMaterialInstanceDynamic> CreateMaterialInstance(FLinearColor Color, float Opacity);
-
-	static void CreateMeshSection(UProceduralMeshComponent* ProceduralMesh, const TArray<FVector>& Vertices, const TArray<int>& Triangles);
-	static void CreateLine(const FVector& Start, const FVector& End, float Thickness, TArray<FVector>& Vertices, TArray<int>& Triangles);
-	
-public:
-	UFUNCTION(BlueprintCallable, Category="GridManager")
-	bool GetTileInReferenceToTile(int InRow, int InColumn, int RowOffset, int ColOffset, FVector& OutLocation, FTileInfo& TileInfo, bool bConsiderRotation = false, FRotator Rotation = FRotator::ZeroRotator);
-
-	UFUNCTION(BlueprintCallable, Category="GridManager")
-	bool GetTileInReferenceToLocation(FVector Location, int RowOffset, int ColOffset, FVector& OutLocation, FTileInfo& TileInfo, bool bConsiderRotation = false, FRotator Rotation = FRotator::ZeroRotator);
-	
-	UFUNCTION(BlueprintCallable, Category="GridManager")
-	bool IsValidTile(int Row, int Column) const;
-
-	UFUNCTION(BlueprintCallable, Category="GridManager")
-	bool IsValidWalkTile(int Row, int Column) const;
-	
-	UFUNCTION(BlueprintCallable, Category="GridManager")
-	bool IsValidSpawnTile(int Row, int Column) const;
-
-	UFUNCTION(BlueprintCallable, Category="GridManager")
-	void LocationToTile(FVector Location, int& RowOut, int& ColumnOut, bool& bValid) const;
-
-	UFUNCTION(BlueprintCallable, Category="GridManager")
-	bool TakeTileSpace(AActor* Actor, bool bAffectWalkable = true);
-
-	UFUNCTION(BlueprintCallable, Category="GridManager")
-	FVector LocationToGridLocation(FVector Location, bool& bValid);
-	
-	UFUNCTION(BlueprintCallable, Category="GridManager")
-	AActor* SpawnActorOnGrid(TSubclassOf<AActor> ActorClass, int Row, int Column, bool& bSpawned, FTransform SpawnTransform, bool bCenter = true, bool bAffectWalkable = false);
-
-	UFUNCTION(BlueprintCallable, Category="GridManager")
-	FVector TileToGridLocation(int Row, int Column, bool& bValid, bool bCenter = true, FVector Offset = FVector(0.0f, 0.0f, 0.0f)) const;
-
-	UFUNCTION(BlueprintCallable, Category="GridManager")
-	FVector TileToWalkGridLocation(int Row, int Column, bool& bValid, bool bCenter = true, FVector Offset = FVector(0.0f, 0.0f, 0.0f)) const;
-
-	UFUNCTION(BlueprintCallable, Category="GridManager")
-	FVector TileToSpawnGridLocation(int Row, int Column, bool& bValid, bool bCenter = true, FVector Offset = FVector(0.0f, 0.0f, 0.0f)) const;
-	
-	UFUNCTION(BlueprintCallable, Category="GridManager")
-	void SetSelectedTile(int Row, int Column) const;
-	
-	UFUNCTION(BlueprintCallable, Category="GridManager")
-	bool IsGridInfoInitialized() const;
-	
-	UFUNCTION(BlueprintCallable, Category="GridManager")
-	FTileInfo GetTileInfoAtIndexCopy(const int Index) const;
-
-	UFUNCTION(BlueprintCallable, Category="GridManager")
-	bool SetTileInfoAtIndex(const int Index, const FTileInfo TileInfoIn);
-
-	UFUNCTION(BlueprintCallable, Category="GridManager")
-	FTileInfo GetTileInfoAtPositionCopy(const int Row, const int Column, bool& bValid) const;
-
-	UFUNCTION(BlueprintCallable, Category="GridManager")
-	FTileInfo GetTileInfoAtPositionWithLocation(const int Row, const int Column, FVector& TileLocation, bool& bValid) const;
-
-	UFUNCTION(BlueprintCallable, Category="GridManager")
-	bool SetTileInfoAtPosition(const int Row, const int Column, const FTileInfo TileInfoIn);
-
-	FORCEINLINE void GetGridRowsAndColumns(int& Row, int& Column) const;
-
-	UFUNCTION(BlueprintCallable, Category="GridManager")
-	FORCEINLINE float GetTileSize() const { return TileSize; } 
-
-	UFUNCTION(BlueprintCallable, Category="GridManager")
-	FORCEINLINE float GetGridWidth() const { return NumColumns * TileSize; }
-	
-	UFUNCTION(BlueprintCallable, Category="GridManager")
-	FORCEINLINE float GetGridHeight() const { return NumRows * TileSize; }
-
-	UFUNCTION(BlueprintCallable, Category = "GridManager")
-	FORCEINLINE UProceduralMeshComponent* GetLineMeshComponent() const { return LineMesh; }
-
-	UFUNCTION(BlueprintCallable, Category = "GridManager")
-	TArray<FTileInfo> GetNeighboringTiles(const int Row, const int Column, const int NeighboringRows, const int NeighboringColumns);
-
-	void DisplayDebugInfoOnTile(const FVector& Location) const;
+// Copyright Rekt Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "GridAttributeLayers.h"
+#include "GridCoordinateMapper.h"
+#include "GridFlowField.h"
+#include "GridGenerationRules.h"
+#include "GridHierarchy.h"
+#include "GridLineOfSight.h"
+#include "GridMeshBuilder.h"
+#include "GridPathfinder.h"
+#include "GridPathQueryScheduler.h"
+#include "GridRegionLabels.h"
+#include "GridReplication.h"
+#include "GridTileDeltas.h"
+#include "GridTileQuery.h"
+#include "GridTileSnapshots.h"
+#include "GridTileStorage.h"
+
+#include "GridManager.generated.h"
+
+class UProceduralMeshComponent;
+class UTexture2D;
+
+UENUM(BlueprintType)
+enum class EGridRenderMode : uint8
+{
+	// Lines, selection and overlays are procedural mesh geometry
+	LineMesh,
+	// One quad over the grid, the surface material draws lines, selection and overlays from the tile state texture
+	Material
+};
+
+UENUM(BlueprintType, meta=(Bitflags, UseEnumValuesAsMaskValuesInEditor="true"))
+enum class EGridTileField : uint8
+{
+	None = 0 UMETA(Hidden),
+	Walkable = 1 << 0,
+	Spawnable = 1 << 1,
+	Occupant = 1 << 2
+};
+ENUM_CLASS_FLAGS(EGridTileField);
+static_assert(static_cast<uint8>(EGridTileField::Walkable) == FGridTileFilter::Walkable && static_cast<uint8>(EGridTileField::Spawnable) == FGridTileFilter::Spawnable &&
+	static_cast<uint8>(EGridTileField::Occupant) == FGridTileFilter::Occupied, "Tile query filters take EGridTileField masks");
+
+USTRUCT(BlueprintType)
+struct FTileMod
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin=0))
+	int Row;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin=0))
+	int Column;
+
+	FTileMod(): Row(-1), Column(-1)
+	{
+	}
+
+	explicit FTileMod(int const NewRow, int const NewColumn): Row(NewRow), Column(NewColumn)
+	{
+	}
+};
+
+USTRUCT(BlueprintType)
+struct FTileInfo
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
+	FIntPoint Position;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bCanSpawnOn;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bCanWalkOn;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
+	TObjectPtr<AActor> ActorOnTile;
+
+	FTileInfo(): Position(FIntPoint(-1,-1)), bCanSpawnOn(true), bCanWalkOn(true)
+	{
+	}
+
+	FTileInfo(int const Row, int const Column): bCanSpawnOn(true), bCanWalkOn(true)
+	{
+		Position.X = Row;
+		Position.Y = Column;
+	}
+
+	FTileInfo(const bool bNewCanSpawn, const bool bNewCanWalk): Position(FIntPoint(-1,-1))
+	{
+		bCanWalkOn = bNewCanWalk;
+		bCanSpawnOn = bNewCanSpawn;
+	}
+
+	FTileInfo(const bool bNewCanSpawn, const bool bNewCanWalk, AActor* NewActorOnTile)
+	{
+		bCanWalkOn = bNewCanWalk;
+		bCanSpawnOn = bNewCanSpawn;
+		ActorOnTile = NewActorOnTile;
+	}
+};
+
+/**
+ * Parameters a line chunk was built with, the chunk is only rebuilt when they change
+ */
+struct FGridLineChunkKey
+{
+	// Tiles covered by the chunk, Min row/column included, Max excluded
+	FIntRect Tiles = FIntRect(0, 0, -1, -1);
+	float TileSize = 0.0f;
+	float LineThickness = 0.0f;
+	// Chunk on the last row/column also draws the closing line of the grid
+	bool bClosingRowLine = false;
+	bool bClosingColumnLine = false;
+
+	bool operator==(const FGridLineChunkKey& Other) const
+	{
+		return Tiles == Other.Tiles && TileSize == Other.TileSize && LineThickness == Other.LineThickness && bClosingRowLine == Other.bClosingRowLine && bClosingColumnLine == Other.bClosingColumnLine;
+	}
+};
+
+/**
+ * Movable actor followed through its root component transform updates
+ */
+struct FGridTrackedActor
+{
+	TWeakObjectPtr<AActor> Actor;
+	TWeakObjectPtr<USceneComponent> Root;
+	FDelegateHandle TransformUpdatedHandle;
+
+	// World XY bounds of the cell the actor is in, nothing is recomputed while it stays inside
+	FVector2D CellMin = FVector2D::ZeroVector;
+	FVector2D CellMax = FVector2D::ZeroVector;
+
+	int32 Tile = INDEX_NONE;
+	bool bAffectWalkable = false;
+};
+
+/**
+ * Tracked actors currently on a tile and the flags to restore once the last one leaves
+ */
+struct FGridTileClaim
+{
+	int32 Claims = 0;
+	int32 WalkBlockers = 0;
+	bool bWasWalkable = true;
+	bool bWasSpawnable = true;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnGridActorTileChanged, AActor*, Actor, FIntPoint, OldTile, FIntPoint, NewTile);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnGridTilesChanged, const TArray<int32>&, Indices, const TArray<uint8>&, Fields, int32, AllTilesFields);
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnGridTilesChangedNative, TConstArrayView<int32> /*Indices*/, TConstArrayView<uint8> /*Fields*/, uint8 /*AllTilesFields*/);
+DECLARE_DYNAMIC_DELEGATE_FourParams(FOnGridPathQueryComplete, int32, RequestId, bool, bSuccess, const TArray<FIntPoint>&, Tiles, const TArray<FVector>&, Locations);
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnGridReachabilityQueryComplete, int32, RequestId, bool, bReachable);
+
+UCLASS(meta=(PrioritizeCategories = "GridManager"))
+class AGridManager : public AActor
+{
+	GENERATED_BODY()
+
+	// Sizes the grid and times the protected generation steps
+	friend class UGridBenchmarkCommandlet;
+
+	// Received chunks patch the tiles through the protected writes
+	friend struct FGridReplicatedChunk;
+
+	// Builds small grids to check the occupancy writes
+	friend class FGridOccupancyRectWriteTest;
+	
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess))
+	TObjectPtr<UProceduralMeshComponent> LineMesh;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess))
+	TObjectPtr<UProceduralMeshComponent> SelectionMesh;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess))
+	TObjectPtr<UProceduralMeshComponent> NoWalkMesh;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess))
+	TObjectPtr<UProceduralMeshComponent> NoSpawnMesh;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess))
+	TObjectPtr<UProceduralMeshComponent> SurfaceMesh;
+	
+	
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Generation", meta=(AllowPrivateAccess))
+	int NumRows;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Generation", meta=(AllowPrivateAccess))
+	int NumColumns;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Generation", meta=(AllowPrivateAccess))
+	float TileSize;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Generation", meta=(AllowPrivateAccess))
+	float LineThickness;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Generation", meta=(AllowPrivateAccess))
+	float LineOpacity;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Generation", meta=(AllowPrivateAccess))
+	float SelectionOpacity;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Generation", meta=(AllowPrivateAccess))
+	FLinearColor LineColor;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Generation", meta=(AllowPrivateAccess))
+	FLinearColor SelectionColor;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="GridManager|Generation", meta=(AllowPrivateAccess))
+	TObjectPtr<UMaterialInterface> MaterialInterface;
+
+	/** Material mode builds a single quad whatever the number of tiles, LineMesh is the geometry fallback.
+	 * The surface UVs run (Row, Column) while the TileState texture is laid out (Column, Row), so the material samples
+	 * the texture at UV.yx. SelectedTile holds (Row, Column, Valid) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Generation", meta=(AllowPrivateAccess))
+	EGridRenderMode RenderMode;
+
+	/** Material of the surface quad in Material render mode, reads the parameters set by the grid and the TileState texture */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="GridManager|Generation", meta=(AllowPrivateAccess))
+	TObjectPtr<UMaterialInterface> SurfaceMaterialInterface;
+
+	UPROPERTY()
+	TObjectPtr<UMaterialInstanceDynamic> SurfaceMaterial;
+
+	/** One texel per tile (Column, Row), red is set on tiles that can't be walked on, green on tiles that can't be spawned on */
+	UPROPERTY(Transient)
+	TObjectPtr<UTexture2D> TileStateTexture;
+
+	TArray<uint8> TileStateTexels;
+	TArray<int> DirtyTileStateTexels;
+	bool bTileStateTextureDirty = false;
+
+	/** Size in tiles of the square line chunks, each chunk is its own mesh component with tight bounds so it is culled on its own */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Generation", meta=(AllowPrivateAccess, ClampMin=1))
+	int LineChunkSize;
+
+	UPROPERTY()
+	TObjectPtr<UMaterialInstanceDynamic> LinesMaterial;
+
+	/** Line chunk components, the first chunk is drawn by LineMesh. Recreated on construction or begin play */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UProceduralMeshComponent>> LineChunkMeshes;
+
+	TArray<FGridLineChunkKey> LineChunkKeys;
+
+	/** Shared by every mesh build so chunk rebuilds reuse the same buffers */
+	FGridMeshBuilder MeshBuilder;
+	
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Modifiers", meta=(AllowPrivateAccess))
+	float NoWalkOpacity;
+	
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Modifiers", meta=(AllowPrivateAccess))
+	float NoSpawnOpacity;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Modifiers", meta=(AllowPrivateAccess))
+	FLinearColor NoWalkColor;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Modifiers", meta=(AllowPrivateAccess))
+	FLinearColor NoSpawnColor;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="GridManager|Modifiers", meta=(AllowPrivateAccess))
+	TArray<FTileMod> NoSpawningStartingTiles;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="GridManager|Modifiers", meta=(AllowPrivateAccess))
+	TArray<FTileMod> NoWalkingStartingTiles;
+
+	/** Procedural layout steps run in order over the starting modifiers, not applied on paged grids */
+	UPROPERTY(EditAnywhere, Instanced, BlueprintReadOnly, Category="GridManager|Generation", meta=(AllowPrivateAccess))
+	TArray<TObjectPtr<UGridGenerationRule>> GenerationRules;
+
+	/** Same seed and rules give the same layout on every machine, so clients generate it on their own */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="GridManager|Generation", meta=(AllowPrivateAccess))
+	int32 GenerationSeed;
+
+	/** Size in tiles of the square overlay chunks, each chunk is a mesh section rebuilt on its own when its tiles change */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Modifiers", meta=(AllowPrivateAccess, ClampMin=1))
+	int OverlayChunkSize;
+
+	UPROPERTY()
+	TObjectPtr<UMaterialInstanceDynamic> NoWalkOverlayMaterial;
+
+	UPROPERTY()
+	TObjectPtr<UMaterialInstanceDynamic> NoSpawnOverlayMaterial;
+
+	/** Maximum number of async path queries dispatched to worker threads in one frame */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="GridManager|Navigation", meta=(AllowPrivateAccess, ClampMin=1))
+	int MaxPathQueriesPerFrame;
+
+	/** Attribute layer read as a per tile movement cost multiplier by path queries, none for uniform costs */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Navigation", meta=(AllowPrivateAccess))
+	FName PathCostLayer;
+
+	/** Attribute layer blocking sight on tiles where it is above SightBlockingValue, none to only test the flags */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Sight", meta=(AllowPrivateAccess))
+	FName SightBlockingLayer;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="GridManager|Sight", meta=(AllowPrivateAccess))
+	float SightBlockingValue;
+
+	/** Side of the clusters of the hierarchical path graph in tiles */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Navigation", meta=(AllowPrivateAccess, ClampMin=4))
+	int HierarchicalClusterSize;
+
+	/** FindPath goes through the cluster graph when start and goal are at least this many tiles apart (Chebyshev distance)
+	 * and no path cost layer is set, 0 to always search tiles. Those paths are close to but not always the shortest */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="GridManager|Navigation", meta=(AllowPrivateAccess, ClampMin=0))
+	int HierarchicalPathMinDistance;
+
+	/** Dense per tile planes allocated with the tiles info, more can be added at runtime */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Attributes", meta=(AllowPrivateAccess))
+	TArray<FGridAttributeLayerDesc> AttributeLayers;
+
+	/** Keep the tile flags in pages allocated on first write instead of whole grid arrays, for very large grids.
+	 * Overlays, the tile state texture and attribute layers are not available on paged grids */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Streaming", meta=(AllowPrivateAccess))
+	bool bPagedTiles;
+
+	/** Side of a tile page in tiles */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Streaming", meta=(AllowPrivateAccess, ClampMin=8, EditCondition="bPagedTiles"))
+	int TilePageSize;
+
+	/** Pages kept uncompressed in memory, least recently used pages past it are compressed */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Streaming", meta=(AllowPrivateAccess, ClampMin=1, EditCondition="bPagedTiles"))
+	int MaxResidentTilePages;
+
+	/** Pages within this many tiles of the first local player pawn are streamed in every tick, 0 to stream manually */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Streaming", meta=(AllowPrivateAccess, ClampMin=0, EditCondition="bPagedTiles"))
+	int StreamingRadius;
+
+	/** Path queries on paged grids search the start/goal box grown by this many tiles */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Streaming", meta=(AllowPrivateAccess, ClampMin=0, EditCondition="bPagedTiles"))
+	int PagedPathMargin;
+
+	/** Send the walk and spawn writes of the server to the clients as chunks of changed tiles, dense grids only */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="GridManager|Network", meta=(AllowPrivateAccess))
+	bool bReplicateTiles;
+
+	UPROPERTY(Replicated)
+	FGridReplicatedChunks ReplicatedTiles;
+
+	// Words of the last chunk received, reused for every chunk
+	TArray<uint64> ReceivedWalkWords;
+	TArray<uint64> ReceivedSpawnWords;
+
+	FGridTileStorage TileStorage;
+
+	FGridPathfinder Pathfinder;
+
+	FGridPathQueryScheduler PathQueryScheduler;
+
+	// Built lazily by the reachability queries, then updated on every walk flag write
+	mutable FGridRegionLabels RegionLabels;
+
+	FGridFlowFields FlowFields;
+
+	// Filled by the tile writes while a change listener is bound, flushed on the next tick
+	FGridTileDeltas TileDeltas;
+	TArray<int32> FlushedTileIndices;
+	TArray<uint8> FlushedTileFields;
+
+	// Created by the first GetTileSnapshots call, then published on the tick after tiles change
+	TSharedPtr<FGridTileSnapshots, ESPMode::ThreadSafe> TileSnapshots;
+
+	// Clusters and borders are dirtied by walk writes and rebuilt by the next hierarchical query
+	FGridHierarchy Hierarchy;
+
+	TBitArray<> DirtyOverlayChunkFlags;
+	TArray<int> DirtyOverlayChunks;
+
+	TMap<TObjectKey<AActor>, FGridTrackedActor> TrackedActors;
+	TMap<int, FGridTileClaim> TileClaims;
+
+	bool bStartingModifiersInitialized;
+	
+public:	
+	AGridManager();
+
+	virtual void Tick(float DeltaSeconds) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+protected:
+	virtual void OnConstruction(const FTransform& Transform) override;
+	virtual void PostInitializeComponents() override;
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	void GenerateTileInfo();
+	void InitializeStartingTilesModifiers();
+	TObjectPtr<UMaterialInstanceDynamic> CreateMaterialInstance(FLinearColor Color, float Opacity);
+
+	FTileInfo MakeTileInfo(int Index) const;
+	void ApplyTileInfo(int Index, const FTileInfo& TileInfoIn);
+	void SetTileFlags(int Index, bool bCanWalkOn, bool bCanSpawnOn);
+	void OnTileFlagsChanged(int Index);
+	void OnTilesFlagsChanged(const FIntRect& Tiles);
+	bool IsRecordingTileChanges() const;
+	void RecordTileChange(int Index, EGridTileField Fields);
+	void RecordAllTilesChanged(EGridTileField Fields);
+	void FlushTileDeltas();
+	void ApplyReplicatedChunk(int32 ChunkIndex, const TArray<uint8>& Payload);
+	void ApplyReplicatedChunks();
+	bool IsStreamingAroundPlayer() const;
+	bool HasDeferredWork() const;
+
+	void UpdateTrackedActorTile(AActor* Actor, FGridTrackedActor& Tracked, const FVector& Location, bool bBroadcast);
+	void ReplaceTrackedActors();
+	bool EnsureRegionLabels() const;
+	bool FindHierarchicalPath(int32 Start, int32 Goal, TArray<FIntPoint>& OutTiles);
+	FGridTileFilter MakeSightFilter(int32 RequiredFields, int32 ExcludedFields) const;
+	void ClaimTile(int Index, bool bBlockWalk);
+	void ReleaseTileClaim(int Index, bool bBlockWalk);
+	void ReleaseTrackedActor(AActor* Actor, TObjectKey<AActor> Key, const FGridTrackedActor& Tracked);
+	void HandleTrackedTransformUpdated(USceneComponent* Component, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	UFUNCTION()
+	void HandleTrackedActorDestroyed(AActor* DestroyedActor);
+
+	void UpdateLineChunks();
+	FGridLineChunkKey MakeLineChunkKey(int ChunkIndex) const;
+	void BuildLineChunk(UProceduralMeshComponent* ChunkMesh, const FGridLineChunkKey& Key);
+	UProceduralMeshComponent* CreateLineChunkMesh();
+
+	FORCEINLINE int GetNumLineChunkRows() const { return FMath::DivideAndRoundUp(NumRows, LineChunkSize); }
+	FORCEINLINE int GetNumLineChunkColumns() const { return FMath::DivideAndRoundUp(NumColumns, LineChunkSize); }
+
+	void ClearLineChunks();
+
+	void BuildSurface();
+	void RebuildTileStateTexture();
+	void WriteTileStateTexel(int Index, bool bCanWalkOn, bool bCanSpawnOn);
+	void MarkTileStateTexelDirty(int Index);
+	void MarkTileStateRectDirty(const FIntRect& Tiles);
+	void UploadDirtyTileStateTexels();
+
+	void GetStartingModifierBits(FGridBitset& OutWalkable, FGridBitset& OutSpawnable) const;
+	void RebuildOverlays();
+	void BuildOverlayChunk(UProceduralMeshComponent* OverlayMesh, UMaterialInterface* Material, int ChunkIndex, const FGridBitset& AllowedTiles);
+	void MarkOverlayTileDirty(int Index);
+	void MarkOverlayRectDirty(const FIntRect& Tiles);
+	void RebuildDirtyOverlayChunks();
+
+	FORCEINLINE int GetNumOverlayChunkRows() const { return FMath::DivideAndRoundUp(NumRows, OverlayChunkSize); }
+	FORCEINLINE int GetNumOverlayChunkColumns() const { return FMath::DivideAndRoundUp(NumColumns, OverlayChunkSize); }
+
+	FORCEINLINE int GetTileIndex(const int Row, const int Column) const { return Row * NumColumns + Column; }
+
+	static void CreateMeshSection(UProceduralMeshComponent* ProceduralMesh, const TArray<FVector>& Vertices, const TArray<int>& Triangles, int SectionIndex = 0);
+	static void CreateLine(const FVector& Start, const FVector& End, float Thickness, TArray<FVector>& Vertices, TArray<int>& Triangles);
+	
+public:
+	UFUNCTION(BlueprintCallable, Category="GridManager")
+	bool GetTileInReferenceToTile(int InRow, int InColumn, int RowOffset, int ColOffset, FVector& OutLocation, FTileInfo& TileInfo, bool bConsiderRotation = false, FRotator Rotation = FRotator::ZeroRotator);
+
+	UFUNCTION(BlueprintCallable, Category="GridManager")
+	bool GetTileInReferenceToLocation(FVector Location, int RowOffset, int ColOffset, FVector& OutLocation, FTileInfo& TileInfo, bool bConsiderRotation = false, FRotator Rotation = FRotator::ZeroRotator);
+	
+	UFUNCTION(BlueprintCallable, Category="GridManager")
+	bool IsValidTile(int Row, int Column) const;
+
+	UFUNCTION(BlueprintCallable, Category="GridManager")
+	bool IsValidWalkTile(int Row, int Column) const;
+	
+	UFUNCTION(BlueprintCallable, Category="GridManager")
+	bool IsValidSpawnTile(int Row, int Column) const;
+
+	UFUNCTION(BlueprintCallable, Category="GridManager")
+	void LocationToTile(FVector Location, int& RowOut, int& ColumnOut, bool& bValid) const;
+
+	UFUNCTION(BlueprintCallable, Category="GridManager")
+	bool TakeTileSpace(AActor* Actor, bool bAffectWalkable = true);
+
+	UFUNCTION(BlueprintCallable, Category="GridManager")
+	FVector LocationToGridLocation(FVector Location, bool& bValid);
+	
+	UFUNCTION(BlueprintCallable, Category="GridManager")
+	AActor* SpawnActorOnGrid(TSubclassOf<AActor> ActorClass, int Row, int Column, bool& bSpawned, FTransform SpawnTransform, bool bCenter = true, bool bAffectWalkable = false);
+
+	UFUNCTION(BlueprintCallable, Category="GridManager")
+	FVector TileToGridLocation(int Row, int Column, bool& bValid, bool bCenter = true, FVector Offset = FVector(0.0f, 0.0f, 0.0f)) const;
+
+	UFUNCTION(BlueprintCallable, Category="GridManager")
+	FVector TileToWalkGridLocation(int Row, int Column, bool& bValid, bool bCenter = true, FVector Offset = FVector(0.0f, 0.0f, 0.0f)) const;
+
+	UFUNCTION(BlueprintCallable, Category="GridManager")
+	FVector TileToSpawnGridLocation(int Row, int Column, bool& bValid, bool bCenter = true, FVector Offset = FVector(0.0f, 0.0f, 0.0f)) const;
+	
+	UFUNCTION(BlueprintCallable, Category="GridManager")
+	void SetSelectedTile(int Row, int Column) const;
+	
+	UFUNCTION(BlueprintCallable, Category="GridManager")
+	bool IsGridInfoInitialized() const;
+	
+	UFUNCTION(BlueprintCallable, Category="GridManager")
+	FTileInfo GetTileInfoAtIndexCopy(const int Index) const;
+
+	UFUNCTION(BlueprintCallable, Category="GridManager")
+	bool SetTileInfoAtIndex(const int Index, const FTileInfo TileInfoIn);
+
+	UFUNCTION(BlueprintCallable, Category="GridManager")
+	FTileInfo GetTileInfoAtPositionCopy(const int Row, const int Column, bool& bValid) const;
+
+	UFUNCTION(BlueprintCallable, Category="GridManager")
+	FTileInfo GetTileInfoAtPositionWithLocation(const int Row, const int Column, FVector& TileLocation, bool& bValid) const;
+
+	UFUNCTION(BlueprintCallable, Category="GridManager")
+	bool SetTileInfoAtPosition(const int Row, const int Column, const FTileInfo TileInfoIn);
+
+	UFUNCTION(BlueprintCallable, Category="GridManager|Batch")
+	bool SetTilesInRect(int StartRow, int StartColumn, int EndRow, int EndColumn, UPARAM(meta=(Bitmask, BitmaskEnum="/Script/OptimizedGrid.EGridTileField")) int32 Fields, bool bCanWalkOn, bool bCanSpawnOn, AActor* Actor = nullptr);
+
+	UFUNCTION(BlueprintCallable, Category="GridManager|Batch")
+	bool SetTilesAtIndices(const TArray<int>& Indices, UPARAM(meta=(Bitmask, BitmaskEnum="/Script/OptimizedGrid.EGridTileField")) int32 Fields, bool bCanWalkOn, bool bCanSpawnOn, AActor* Actor = nullptr);
+
+	bool SetTilesFromMask(const FGridBitset& Mask, EGridTileField Fields, bool bCanWalkOn, bool bCanSpawnOn, AActor* Actor = nullptr);
+
+	UFUNCTION(BlueprintCallable, Category="GridManager|Batch")
+	void LocationsToTiles(const TArray<FVector>& Locations, TArray<FIntPoint>& OutTiles, TArray<bool>& OutValid) const;
+
+	UFUNCTION(BlueprintCallable, Category="GridManager|Batch")
+	void TilesToGridLocations(const TArray<FIntPoint>& Tiles, TArray<FVector>& OutLocations, TArray<bool>& OutValid, bool bCenter = true, FVector Offset = FVector(0.0f, 0.0f, 0.0f)) const;
+
+	/** Origin and tile size of the grid for native batch conversions, refresh it if the grid moves */
+	FGridCoordinateMapper MakeCoordinateMapper() const;
+
+	UFUNCTION(BlueprintCallable, Category="GridManager|Attributes")
+	int AddAttributeLayer(FName Name, EGridAttributeType Type, float DefaultValue = 0.0f);
+
+	UFUNCTION(BlueprintPure, Category="GridManager|Attributes")
+	int FindAttributeLayer(FName Name) const;
+
+	UFUNCTION(BlueprintPure, Category="GridManager|Attributes")
+	float GetTileAttribute(int Layer, int Row, int Column) const;
+
+	UFUNCTION(BlueprintCallable, Category="GridManager|Attributes")
+	bool SetTileAttribute(int Layer, int Row, int Column, float Value);
+
+	UFUNCTION(BlueprintCallable, Category="GridManager|Attributes")
+	bool FillAttributeRect(int Layer, int StartRow, int StartColumn, int EndRow, int EndColumn, float Value);
+
+	UFUNCTION(BlueprintCallable, Category="GridManager|Attributes")
+	bool FillAttributeLayer(int Layer, float Value);
+
+	/** Native access to the attribute planes, index them with the tile index */
+	FORCEINLINE const FGridAttributeLayers& GetAttributes() const { return TileStorage.GetAttributes(); }
+	FORCEINLINE FGridAttributeLayers& GetAttributes() { return TileStorage.GetAttributes(); }
+
+	UFUNCTION(BlueprintCallable, Category="GridManager|Streaming")
+	void StreamTilesAround(FVector Location, int RadiusTiles);
+
+	/** Tiles held by movable actors are written with the flags the actors gave them */
+	UFUNCTION(BlueprintCallable, Category="GridManager|Persistence")
+	bool ExportGridState(const FString& FilePath, bool bRunLength = true) const;
+
+	/** Occupants are not part of the file, tracked actors are placed again on the loaded tiles */
+	UFUNCTION(BlueprintCallable, Category="GridManager|Persistence")
+	bool ImportGridState(const FString& FilePath);
+
+	UFUNCTION(BlueprintCallable, Category="GridManager|Occupancy")
+	bool ReleaseTileSpace(AActor* Actor);
+
+	UFUNCTION(BlueprintCallable, Category="GridManager|Occupancy")
+	bool RegisterMovableActor(AActor* Actor, bool bAffectWalkable = false);
+
+	UFUNCTION(BlueprintCallable, Category="GridManager|Occupancy")
+	bool UnregisterMovableActor(AActor* Actor);
+
+	/** Fired when a registered movable actor crosses into another tile, off grid is (-1, -1) */
+	UPROPERTY(BlueprintAssignable, Category="GridManager|Occupancy")
+	FOnGridActorTileChanged OnActorTileChanged;
+
+	/**
+	 * Tiles changed since the last tick, broadcast once per frame. Indices lists each changed tile once and Fields
+	 * holds its changed EGridTileField bits. AllTilesFields is set instead of the lists when most of the grid changed.
+	 * Nothing is recorded while neither this nor OnTilesChangedNative is bound
+	 */
+	UPROPERTY(BlueprintAssignable, Category="GridManager|Events")
+	FOnGridTilesChanged OnTilesChanged;
+
+	/** Same as OnTilesChanged without the blueprint layer */
+	FOnGridTilesChangedNative OnTilesChangedNative;
+
+	UFUNCTION(BlueprintPure, Category="GridManager|Occupancy")
+	bool GetActorTile(const AActor* Actor, int& Row, int& Column) const;
+
+	UFUNCTION(BlueprintCallable, Category="GridManager|Occupancy")
+	int GetActorsOnTile(int Row, int Column, TArray<AActor*>& OutActors) const;
+
+	UFUNCTION(BlueprintCallable, Category="GridManager|Occupancy")
+	int GetActorsInRect(int StartRow, int StartColumn, int EndRow, int EndColumn, TArray<AActor*>& OutActors) const;
+
+	UFUNCTION(BlueprintCallable, Category="GridManager|Occupancy")
+	int GetActorsInRadius(int Row, int Column, int Radius, TArray<AActor*>& OutActors) const;
+
+	UFUNCTION(BlueprintCallable, Category="GridManager|Occupancy")
+	AActor* FindNearestActor(int Row, int Column, int MaxRadius, int& OutRow, int& OutColumn, TSubclassOf<AActor> ActorClass = nullptr) const;
+
+	/** Native access to the occupancy index, queries append to the caller buffer without resetting it */
+	FORCEINLINE const FGridOccupancyIndex& GetOccupancy() const { return TileStorage.GetOccupancy(); }
+
+	FORCEINLINE void GetGridRowsAndColumns(int& Row, int& Column) const;
+
+	UFUNCTION(BlueprintCallable, Category="GridManager")
+	FORCEINLINE float GetTileSize() const { return TileSize; } 
+
+	UFUNCTION(BlueprintCallable, Category="GridManager")
+	FORCEINLINE float GetGridWidth() const { return NumColumns * TileSize; }
+	
+	UFUNCTION(BlueprintCallable, Category="GridManager")
+	FORCEINLINE float GetGridHeight() const { return NumRows * TileSize; }
+
+	UFUNCTION(BlueprintCallable, Category = "GridManager")
+	FORCEINLINE UProceduralMeshComponent* GetLineMeshComponent() const { return LineMesh; }
+
+	/** Walkable tiles of the rect around the tile, clipped to the grid. Prefer GetTilesInRect or the native queries in loops */
+	UFUNCTION(BlueprintCallable, Category = "GridManager")
+	TArray<FTileInfo> GetNeighboringTiles(const int Row, const int Column, const int NeighboringRows, const int NeighboringColumns);
+
+	/**
+	 * @brief Tiles of the rect, clipped to the grid, that have every RequiredFields flag and none of the ExcludedFields
+	 * @param OutTiles Reset then filled, its allocation is reused
+	 * @return Number of tiles found
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GridManager|Queries")
+	int GetTilesInRect(int StartRow, int StartColumn, int EndRow, int EndColumn, UPARAM(meta=(Bitmask, BitmaskEnum="/Script/OptimizedGrid.EGridTileField")) int32 RequiredFields,
+		UPARAM(meta=(Bitmask, BitmaskEnum="/Script/OptimizedGrid.EGridTileField")) int32 ExcludedFields, TArray<FIntPoint>& OutTiles) const;
+
+	/** Same filters as GetTilesInRect over the 4 or 8 tiles around a tile */
+	UFUNCTION(BlueprintCallable, Category = "GridManager|Queries")
+	int GetAdjacentTiles(int Row, int Column, bool bEightConnected, UPARAM(meta=(Bitmask, BitmaskEnum="/Script/OptimizedGrid.EGridTileField")) int32 RequiredFields,
+		UPARAM(meta=(Bitmask, BitmaskEnum="/Script/OptimizedGrid.EGridTileField")) int32 ExcludedFields, TArray<FIntPoint>& OutTiles) const;
+
+	/**
+	 * @brief Check that sight between two tiles is not blocked by a tile in between, the same both ways.
+	 * Sight goes through tiles with every RequiredFields flag and none of the ExcludedFields, and under SightBlockingValue on SightBlockingLayer
+	 */
+	UFUNCTION(BlueprintPure, Category = "GridManager|Sight")
+	bool HasLineOfSight(int FromRow, int FromColumn, int ToRow, int ToColumn, UPARAM(meta=(Bitmask, BitmaskEnum="/Script/OptimizedGrid.EGridTileField")) int32 RequiredFields,
+		UPARAM(meta=(Bitmask, BitmaskEnum="/Script/OptimizedGrid.EGridTileField")) int32 ExcludedFields) const;
+
+	/**
+	 * @brief Step from a tile toward another and stop on the first tile that blocks sight, same filters as HasLineOfSight
+	 * @param OutHitTile First blocking tile, the target included
+	 * @return true if a tile blocked the ray
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GridManager|Sight")
+	bool RaycastTiles(int FromRow, int FromColumn, int ToRow, int ToColumn, UPARAM(meta=(Bitmask, BitmaskEnum="/Script/OptimizedGrid.EGridTileField")) int32 RequiredFields,
+		UPARAM(meta=(Bitmask, BitmaskEnum="/Script/OptimizedGrid.EGridTileField")) int32 ExcludedFields, FIntPoint& OutHitTile) const;
+
+	/**
+	 * @brief HasLineOfSight for every origin/target pair, traced on worker threads for large batches
+	 * @param OutVisible One entry per pair, false for every pair if the arrays differ in size
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GridManager|Sight")
+	void HasLineOfSightBatch(const TArray<FIntPoint>& Origins, const TArray<FIntPoint>& Targets, UPARAM(meta=(Bitmask, BitmaskEnum="/Script/OptimizedGrid.EGridTileField")) int32 RequiredFields,
+		UPARAM(meta=(Bitmask, BitmaskEnum="/Script/OptimizedGrid.EGridTileField")) int32 ExcludedFields, TArray<bool>& OutVisible) const;
+
+	/**
+	 * @brief Tiles seen from a tile within Radius tiles, blocking tiles that are seen included. Same filters as HasLineOfSight
+	 * @return Number of tiles found
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GridManager|Sight")
+	int GetVisibleTiles(int Row, int Column, int Radius, UPARAM(meta=(Bitmask, BitmaskEnum="/Script/OptimizedGrid.EGridTileField")) int32 RequiredFields,
+		UPARAM(meta=(Bitmask, BitmaskEnum="/Script/OptimizedGrid.EGridTileField")) int32 ExcludedFields, TArray<FIntPoint>& OutTiles) const;
+
+	/** Native access to the tile storage for FGridTileQuery and other allocation free reads */
+	FORCEINLINE const FGridTileStorage& GetTileStorage() const { return TileStorage; }
+
+	/**
+	 * @brief Snapshots of the walk, spawn and occupied flags that worker threads read without locks.
+	 * Get them on the game thread, then Pin() from any thread while holding the returned pointer.
+	 * Tile writes show up in the version published on the next tick
+	 * @return nullptr on paged grids or before the tiles are built
+	 */
+	TSharedPtr<FGridTileSnapshots, ESPMode::ThreadSafe> GetTileSnapshots();
+
+	UFUNCTION(BlueprintCallable, Category = "GridManager|Navigation")
+	bool FindPath(int StartRow, int StartColumn, int GoalRow, int GoalColumn, TArray<FIntPoint>& OutTiles, TArray<FVector>& OutLocations);
+
+	/**
+	 * @brief Coarse path on the cluster graph, the waypoints are cluster entrances between start and goal (both included)
+	 * @return false if the grid is not initialized or paged, a tile is not walkable or the goal can't be reached
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GridManager|Navigation")
+	bool FindAbstractPath(int StartRow, int StartColumn, int GoalRow, int GoalColumn, TArray<FIntPoint>& OutWaypoints);
+
+	/**
+	 * @brief Tiles between two consecutive waypoints of FindAbstractPath
+	 * @param OutTiles Tiles after From up to To included
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GridManager|Navigation")
+	bool RefinePathSegment(int FromRow, int FromColumn, int ToRow, int ToColumn, TArray<FIntPoint>& OutTiles);
+
+	UFUNCTION(BlueprintCallable, Category = "GridManager|Navigation")
+	int32 RequestPathAsync(int StartRow, int StartColumn, int GoalRow, int GoalColumn, FOnGridPathQueryComplete OnComplete);
+
+	UFUNCTION(BlueprintCallable, Category = "GridManager|Navigation")
+	int32 RequestReachabilityAsync(int StartRow, int StartColumn, int GoalRow, int GoalColumn, FOnGridReachabilityQueryComplete OnComplete);
+
+	UFUNCTION(BlueprintCallable, Category = "GridManager|Navigation")
+	bool CancelPathQuery(int32 RequestId);
+
+	/** Reachability as a region label comparison, the labels are built on first use and kept up to date after */
+	UFUNCTION(BlueprintPure, Category = "GridManager|Navigation")
+	bool AreConnected(int RowA, int ColumnA, int RowB, int ColumnB) const;
+
+	/** Connected region of a walkable tile, -1 if blocked. Ids change whenever a walk flag does */
+	UFUNCTION(BlueprintPure, Category = "GridManager|Navigation")
+	int GetRegionId(int Row, int Column) const;
+
+	/**
+	 * @brief Reference the flow field toward the nearest of the goal tiles, built in the background.
+	 * Units sharing the same goals share one field, release it once no unit follows it anymore
+	 * @return Field id, -1 if the grid is not initialized or paged
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GridManager|FlowFields")
+	int32 AcquireFlowField(const TArray<FIntPoint>& GoalTiles);
+
+	UFUNCTION(BlueprintCallable, Category = "GridManager|FlowFields")
+	bool ReleaseFlowField(int32 FieldId);
+
+	/** Direction queries fail until the first build of the field is done */
+	UFUNCTION(BlueprintPure, Category = "GridManager|FlowFields")
+	bool IsFlowFieldReady(int32 FieldId) const;
+
+	/** World direction toward the next tile on the way to the nearest goal, zero on goals */
+	UFUNCTION(BlueprintPure, Category = "GridManager|FlowFields")
+	bool GetFlowDirection(int32 FieldId, int Row, int Column, FVector& OutDirection) const;
+
+	UFUNCTION(BlueprintPure, Category = "GridManager|FlowFields")
+	bool GetFlowDirectionAtLocation(int32 FieldId, FVector Location, FVector& OutDirection) const;
+
+	/** Path length to the nearest goal in tiles, -1 if no goal can be reached */
+	UFUNCTION(BlueprintPure, Category = "GridManager|FlowFields")
+	float GetFlowDistance(int32 FieldId, int Row, int Column) const;
+
+	/** Native access to a field for units reading many tiles a frame, nullptr until it is ready */
+	FORCEINLINE const FGridFlowField* FindFlowField(const int32 FieldId) const { return FlowFields.Find(FieldId); }
+
+	int32 EnqueuePathQuery(FIntPoint Start, FIntPoint Goal, bool bReachabilityOnly, FGridPathQueryScheduler::FOnQueryComplete&& OnComplete);
+
+	void DisplayDebugInfoOnTile(const FVector& Location) const;
 };
\ No newline at end of file
@@ -0,0 +1,53 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Reusable vertex and triangle buffers for the grid procedural meshes.
+ * Buffers keep their allocation between builds, quads are written straight into them.
+ */
+struct FGridMeshBuilder
+{
+	TArray<FVector> Vertices;
+	TArray<int> Triangles;
+
+	/** Empty the buffers and make room for NumQuads quads without reallocating on the way */
+	FORCEINLINE void Reset(const int NumQuads)
+	{
+		Vertices.Reset(NumQuads * 4);
+		Triangles.Reset(NumQuads * 6);
+	}
+
+	FORCEINLINE bool IsEmpty() const { return Vertices.Num() == 0; }
+
+	FORCEINLINE void AddLine(const FVector& Start, const FVector& End, const float Thickness)
+	{
+		AppendLine(Start, End, Thickness, Vertices, Triangles);
+	}
+
+	/**
+	 * @brief Write the quad of a line lying on the XY plane at the end of the buffers
+	 * @param Thickness Width of the quad across the line direction
+	 */
+	static FORCEINLINE void AppendLine(const FVector& Start, const FVector& End, const float Thickness, TArray<FVector>& OutVertices, TArray<int>& OutTriangles)
+	{
+		const FVector ThicknessOffset = FVector::CrossProduct((End - Start).GetSafeNormal(), FVector::UpVector) * (Thickness / 2);
+		const int VerticesCount = OutVertices.Num();
+
+		int* Triangle = OutTriangles.GetData() + OutTriangles.AddUninitialized(6);
+		Triangle[0] = VerticesCount + 2;
+		Triangle[1] = VerticesCount + 1;
+		Triangle[2] = VerticesCount + 0;
+		Triangle[3] = VerticesCount + 2;
+		Triangle[4] = VerticesCount + 3;
+		Triangle[5] = VerticesCount + 1;
+
+		FVector* Vertex = OutVertices.GetData() + OutVertices.AddUninitialized(4);
+		Vertex[0] = Start + ThicknessOffset;
+		Vertex[1] = End + ThicknessOffset;
+		Vertex[2] = Start - ThicknessOffset;
+		Vertex[3] = End - ThicknessOffset;
+	}
+};
@@ -0,0 +1,307 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#include "GridOccupancyIndex.h"
+
+void FGridOccupancyIndex::Init(const int32 InNumRows, const int32 InNumColumns, const bool bInSparse)
+{
+	NumRows = FMath::Max(InNumRows, 0);
+	NumColumns = FMath::Max(InNumColumns, 0);
+	bSparse = bInSparse;
+	SparseHeads.Reset();
+	if(bSparse)
+	{
+		TileHeads.Empty();
+		Occupied.Empty();
+	}
+	else
+	{
+		TileHeads.Init(INDEX_NONE, NumRows * NumColumns);
+		Occupied.Init(NumRows * NumColumns, false);
+	}
+	Entries.Reset();
+	ActorEntries.Reset();
+	FreeEntry = INDEX_NONE;
+}
+
+void FGridOccupancyIndex::Empty()
+{
+	NumRows = 0;
+	NumColumns = 0;
+	TileHeads.Empty();
+	Occupied.Empty();
+	SparseHeads.Empty();
+	Entries.Empty();
+	ActorEntries.Empty();
+	FreeEntry = INDEX_NONE;
+}
+
+SIZE_T FGridOccupancyIndex::GetAllocatedSize() const
+{
+	return Entries.GetAllocatedSize() + TileHeads.GetAllocatedSize() + Occupied.GetAllocatedSize() + SparseHeads.GetAllocatedSize() + ActorEntries.GetAllocatedSize();
+}
+
+void FGridOccupancyIndex::Add(const int32 Tile, AActor* Actor)
+{
+	// Tile lists are short, the pair is looked for there rather than along the actor list
+	if(Actor == nullptr || FindEntry(Tile, Actor) != INDEX_NONE) return;
+
+	int32 EntryIndex = FreeEntry;
+	if(EntryIndex != INDEX_NONE)
+	{
+		FreeEntry = Entries[FreeEntry].Next;
+	}
+	else
+	{
+		EntryIndex = Entries.AddDefaulted();
+	}
+
+	int32& ActorHead = ActorEntries.FindOrAdd(Actor, INDEX_NONE);
+	FEntry& Entry = Entries[EntryIndex];
+	Entry.Actor = Actor;
+	Entry.ActorKey = Actor;
+	Entry.Tile = Tile;
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = GetHead(Tile);
+	if(Entry.Next != INDEX_NONE) Entries[Entry.Next].Prev = EntryIndex;
+	SetHead(Tile, EntryIndex);
+
+	Entry.ActorPrev = INDEX_NONE;
+	Entry.ActorNext = ActorHead;
+	if(ActorHead != INDEX_NONE) Entries[ActorHead].ActorPrev = EntryIndex;
+	ActorHead = EntryIndex;
+}
+
+bool FGridOccupancyIndex::Remove(const int32 Tile, const TObjectKey<AActor> Actor)
+{
+	// Callers may hold tiles of a grid that was resized since
+	if(Tile < 0 || Tile >= NumRows * NumColumns) return false;
+
+	const int32 EntryIndex = FindEntry(Tile, Actor);
+	if(EntryIndex == INDEX_NONE) return false;
+
+	RemoveEntry(EntryIndex);
+	return true;
+}
+
+bool FGridOccupancyIndex::Remove(const TObjectKey<AActor> Actor)
+{
+	if(!ActorEntries.Contains(Actor)) return false;
+
+	// Each removal moves the head along the actor list, the last one drops the map entry
+	while (const int32* ActorHead = ActorEntries.Find(Actor))
+	{
+		RemoveEntry(*ActorHead);
+	}
+	return true;
+}
+
+void FGridOccupancyIndex::ClearTile(const int32 Tile)
+{
+	for (int32 EntryIndex = GetHead(Tile); EntryIndex != INDEX_NONE; EntryIndex = GetHead(Tile))
+	{
+		RemoveEntry(EntryIndex);
+	}
+}
+
+int32 FGridOccupancyIndex::GetTile(const TObjectKey<AActor> Actor) const
+{
+	const int32* EntryIndex = ActorEntries.Find(Actor);
+	return EntryIndex != nullptr ? Entries[*EntryIndex].Tile : INDEX_NONE;
+}
+
+int32 FGridOccupancyIndex::GetTiles(const TObjectKey<AActor> Actor, TArray<int32>& OutTiles) const
+{
+	const int32* ActorHead = ActorEntries.Find(Actor);
+	if(ActorHead == nullptr) return 0;
+
+	const int32 StartNum = OutTiles.Num();
+	for (int32 EntryIndex = *ActorHead; EntryIndex != INDEX_NONE; EntryIndex = Entries[EntryIndex].ActorNext)
+	{
+		OutTiles.Add(Entries[EntryIndex].Tile);
+	}
+	return OutTiles.Num() - StartNum;
+}
+
+AActor* FGridOccupancyIndex::GetFirst(const int32 Tile) const
+{
+	for (int32 EntryIndex = GetHead(Tile); EntryIndex != INDEX_NONE; EntryIndex = Entries[EntryIndex].Next)
+	{
+		if(AActor* Actor = Entries[EntryIndex].Actor.Get()) return Actor;
+	}
+	return nullptr;
+}
+
+int32 FGridOccupancyIndex::GetActorsOnTile(const int32 Tile, TArray<AActor*>& OutActors) const
+{
+	const int32 StartNum = OutActors.Num();
+	ForEachActorOnTile(Tile, [&OutActors](AActor* Actor) { OutActors.Add(Actor); });
+	return OutActors.Num() - StartNum;
+}
+
+int32 FGridOccupancyIndex::QueryRect(const FIntRect& Tiles, TArray<AActor*>& OutActors) const
+{
+	const int32 MinRow = FMath::Max(Tiles.Min.X, 0);
+	const int32 MaxRow = FMath::Min(Tiles.Max.X, NumRows);
+	const int32 MinColumn = FMath::Max(Tiles.Min.Y, 0);
+	const int32 MaxColumn = FMath::Min(Tiles.Max.Y, NumColumns);
+	if(MinColumn >= MaxColumn) return 0;
+
+	const int32 StartNum = OutActors.Num();
+	for (int32 Row = MinRow; Row < MaxRow; ++Row)
+	{
+		ForEachOccupiedTileInRow(Row, MinColumn, MaxColumn, [this, &OutActors](const int32 Tile)
+		{
+			ForEachActorOnTile(Tile, [&OutActors](AActor* Actor) { OutActors.Add(Actor); });
+		});
+	}
+	return OutActors.Num() - StartNum;
+}
+
+int32 FGridOccupancyIndex::QueryRadius(const FIntPoint Center, const int32 Radius, TArray<AActor*>& OutActors) const
+{
+	if(Radius < 0) return 0;
+
+	const int32 StartNum = OutActors.Num();
+	const int32 MinRow = FMath::Max(Center.X - Radius, 0);
+	const int32 MaxRow = FMath::Min(Center.X + Radius + 1, NumRows);
+	for (int32 Row = MinRow; Row < MaxRow; ++Row)
+	{
+		// Half width of the disc on this row, the row is then a plain column span
+		const int32 RowDelta = Row - Center.X;
+		const int32 HalfWidth = FMath::FloorToInt32(FMath::Sqrt(static_cast<float>(Radius * Radius - RowDelta * RowDelta)));
+		const int32 MinColumn = FMath::Max(Center.Y - HalfWidth, 0);
+		const int32 MaxColumn = FMath::Min(Center.Y + HalfWidth + 1, NumColumns);
+		if(MinColumn >= MaxColumn) continue;
+
+		ForEachOccupiedTileInRow(Row, MinColumn, MaxColumn, [this, &OutActors](const int32 Tile)
+		{
+			ForEachActorOnTile(Tile, [&OutActors](AActor* Actor) { OutActors.Add(Actor); });
+		});
+	}
+	return OutActors.Num() - StartNum;
+}
+
+AActor* FGridOccupancyIndex::FindNearest(const FIntPoint Center, const int32 MaxRadius, FIntPoint& OutTile, TFunctionRef<bool(const AActor*)> Filter) const
+{
+	AActor* Nearest = nullptr;
+	int32 NearestDistanceSquared = MAX_int32;
+
+	const auto VisitTile = [this, Center, &Filter, &Nearest, &NearestDistanceSquared, &OutTile](const int32 Tile)
+	{
+		const FIntPoint Position(Tile / NumColumns, Tile % NumColumns);
+		const int32 DistanceSquared = (Position - Center).SizeSquared();
+		if(DistanceSquared >= NearestDistanceSquared) return;
+
+		for (int32 EntryIndex = GetHead(Tile); EntryIndex != INDEX_NONE; EntryIndex = Entries[EntryIndex].Next)
+		{
+			AActor* Actor = Entries[EntryIndex].Actor.Get();
+			if(Actor != nullptr && Filter(Actor))
+			{
+				Nearest = Actor;
+				NearestDistanceSquared = DistanceSquared;
+				OutTile = Position;
+				return;
+			}
+		}
+	};
+
+	// Every tile of ring N is at least N tiles away, once N is past the best hit no ring can do better
+	for (int32 Ring = 0; Ring <= MaxRadius && Ring * Ring < NearestDistanceSquared; ++Ring)
+	{
+		const int32 MinColumn = FMath::Max(Center.Y - Ring, 0);
+		const int32 MaxColumn = FMath::Min(Center.Y + Ring + 1, NumColumns);
+		if(MinColumn >= MaxColumn) continue;
+
+		// Top and bottom rows of the ring in full, then the two side columns in between
+		if(Center.X - Ring >= 0 && Center.X - Ring < NumRows)
+		{
+			ForEachOccupiedTileInRow(Center.X - Ring, MinColumn, MaxColumn, VisitTile);
+		}
+		if(Ring > 0 && Center.X + Ring >= 0 && Center.X + Ring < NumRows)
+		{
+			ForEachOccupiedTileInRow(Center.X + Ring, MinColumn, MaxColumn, VisitTile);
+		}
+
+		if(Ring == 0) continue;
+		for (int32 Row = FMath::Max(Center.X - Ring + 1, 0); Row < FMath::Min(Center.X + Ring, NumRows); ++Row)
+		{
+			if(Center.Y - Ring >= 0 && IsOccupied(Row * NumColumns + Center.Y - Ring)) VisitTile(Row * NumColumns + Center.Y - Ring);
+			if(Center.Y + Ring < NumColumns && IsOccupied(Row * NumColumns + Center.Y + Ring)) VisitTile(Row * NumColumns + Center.Y + Ring);
+		}
+	}
+
+	return Nearest;
+}
+
+AActor* FGridOccupancyIndex::FindNearest(const FIntPoint Center, const int32 MaxRadius, FIntPoint& OutTile) const
+{
+	return FindNearest(Center, MaxRadius, OutTile, [](const AActor*) { return true; });
+}
+
+int32 FGridOccupancyIndex::FindEntry(const int32 Tile, const TObjectKey<AActor> Actor) const
+{
+	for (int32 EntryIndex = GetHead(Tile); EntryIndex != INDEX_NONE; EntryIndex = Entries[EntryIndex].Next)
+	{
+		if(Entries[EntryIndex].ActorKey == Actor) return EntryIndex;
+	}
+	return INDEX_NONE;
+}
+
+void FGridOccupancyIndex::RemoveEntry(const int32 EntryIndex)
+{
+	FEntry& Entry = Entries[EntryIndex];
+	if(Entry.Prev != INDEX_NONE)
+	{
+		Entries[Entry.Prev].Next = Entry.Next;
+	}
+	else
+	{
+		SetHead(Entry.Tile, Entry.Next);
+	}
+	if(Entry.Next != INDEX_NONE) Entries[Entry.Next].Prev = Entry.Prev;
+
+	if(Entry.ActorPrev != INDEX_NONE)
+	{
+		Entries[Entry.ActorPrev].ActorNext = Entry.ActorNext;
+	}
+	else if(int32* ActorHead = ActorEntries.Find(Entry.ActorKey); ActorHead != nullptr && *ActorHead == EntryIndex)
+	{
+		if(Entry.ActorNext != INDEX_NONE)
+		{
+			*ActorHead = Entry.ActorNext;
+		}
+		else
+		{
+			ActorEntries.Remove(Entry.ActorKey);
+		}
+	}
+	if(Entry.ActorNext != INDEX_NONE) Entries[Entry.ActorNext].ActorPrev = Entry.ActorPrev;
+
+	Entry.Actor.Reset();
+	Entry.ActorKey = TObjectKey<AActor>();
+	Entry.Tile = INDEX_NONE;
+	Entry.Prev = INDEX_NONE;
+	Entry.ActorPrev = INDEX_NONE;
+	Entry.ActorNext = INDEX_NONE;
+	Entry.Next = FreeEntry;
+	FreeEntry = EntryIndex;
+}
+
+void FGridOccupancyIndex::SetHead(const int32 Tile, const int32 EntryIndex)
+{
+	if(bSparse)
+	{
+		if(EntryIndex != INDEX_NONE)
+		{
+			SparseHeads.Add(Tile, EntryIndex);
+		}
+		else
+		{
+			SparseHeads.Remove(Tile);
+		}
+		return;
+	}
+
+	TileHeads[Tile] = EntryIndex;
+	Occupied.Set(Tile, EntryIndex != INDEX_NONE);
+}
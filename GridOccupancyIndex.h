@@ -0,0 +1,173 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GridTileStorage.h"
+#include "UObject/ObjectKey.h"
+
+/**
+ * Spatial index of the actors occupying the grid tiles.
+ * A tile can hold several actors and an actor can cover several tiles, with one entry per tile and actor pair.
+ * Entries are linked in a list per tile and a list per actor, so removing an actor only visits its own tiles.
+ * Tiles also keep an occupied bitset so rect scans skip 64 empty tiles at a time.
+ * Queries append to caller buffers, reusing the same buffer every tick does not allocate.
+ * Sparse indices keep the tile lists in a map instead, for paged grids too large for per tile arrays.
+ */
+class FGridOccupancyIndex
+{
+public:
+	void Init(int32 InNumRows, int32 InNumColumns, bool bInSparse = false);
+	void Empty();
+
+	/** Bytes held by the entries, heads and actor lookup */
+	SIZE_T GetAllocatedSize() const;
+
+	/** Add the actor to the tile, the tiles it already covers are kept */
+	void Add(int32 Tile, AActor* Actor);
+
+	/** @return false if the actor was not on the tile */
+	bool Remove(int32 Tile, TObjectKey<AActor> Actor);
+
+	/** Remove the actor from every tile it covers, by key so destroyed actors can be removed too */
+	bool Remove(TObjectKey<AActor> Actor);
+	void ClearTile(int32 Tile);
+
+	/** @return Last tile the actor was added to, INDEX_NONE if it is not in the index */
+	int32 GetTile(TObjectKey<AActor> Actor) const;
+
+	/** @return Number of tiles the actor covers appended */
+	int32 GetTiles(TObjectKey<AActor> Actor, TArray<int32>& OutTiles) const;
+
+	/** @return First actor still alive on the tile, nullptr if none */
+	AActor* GetFirst(int32 Tile) const;
+
+	FORCEINLINE bool IsOccupied(const int32 Tile) const { return bSparse ? SparseHeads.Contains(Tile) : Occupied.Get(Tile); }
+
+	/** Occupied bitset of dense indices, nullptr if sparse */
+	FORCEINLINE const FGridBitset* GetOccupiedBits() const { return bSparse ? nullptr : &Occupied; }
+	FORCEINLINE int32 NumActors() const { return ActorEntries.Num(); }
+
+	/** @return Number of actors appended */
+	int32 GetActorsOnTile(int32 Tile, TArray<AActor*>& OutActors) const;
+
+	/**
+	 * @brief Append the actors of every tile inside the rect, clipped to the grid. Actors covering several of the tiles
+	 * are appended once per tile, the same goes for QueryRadius
+	 * @param Tiles Min row/column included, Max excluded
+	 * @return Number of actors appended
+	 */
+	int32 QueryRect(const FIntRect& Tiles, TArray<AActor*>& OutActors) const;
+
+	/**
+	 * @brief Append the actors of every tile whose center is within Radius tiles of Center
+	 * @return Number of actors appended
+	 */
+	int32 QueryRadius(FIntPoint Center, int32 Radius, TArray<AActor*>& OutActors) const;
+
+	/**
+	 * @brief Closest actor to Center by tile distance, searched ring by ring outward
+	 * @param MaxRadius Rings further than this are not searched
+	 * @param Filter Actors it rejects are skipped
+	 * @return nullptr if no accepted actor is within MaxRadius
+	 */
+	AActor* FindNearest(FIntPoint Center, int32 MaxRadius, FIntPoint& OutTile, TFunctionRef<bool(const AActor*)> Filter) const;
+	AActor* FindNearest(FIntPoint Center, int32 MaxRadius, FIntPoint& OutTile) const;
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+
+		// Kept next to the weak pointer so the actor list can still be found once the actor is destroyed
+		TObjectKey<AActor> ActorKey;
+		int32 Tile = INDEX_NONE;
+
+		// Entries of the same tile
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+
+		// Entries of the same actor
+		int32 ActorPrev = INDEX_NONE;
+		int32 ActorNext = INDEX_NONE;
+	};
+
+	/** @return Entry of the actor on the tile, INDEX_NONE if there is none */
+	int32 FindEntry(int32 Tile, TObjectKey<AActor> Actor) const;
+
+	/** Unlink the entry from both of its lists and put it on the free list */
+	void RemoveEntry(int32 EntryIndex);
+
+	FORCEINLINE int32 GetHead(const int32 Tile) const
+	{
+		if(!bSparse) return TileHeads[Tile];
+		const int32* Head = SparseHeads.Find(Tile);
+		return Head != nullptr ? *Head : INDEX_NONE;
+	}
+
+	void SetHead(int32 Tile, int32 EntryIndex);
+
+	/** Call Func(Tile) for every occupied tile of a row between the two columns, Max excluded */
+	template <typename FuncType>
+	void ForEachOccupiedTileInRow(int32 Row, int32 MinColumn, int32 MaxColumn, FuncType&& Func) const;
+
+	/** Call Func(Actor) for every live actor of the tile */
+	template <typename FuncType>
+	FORCEINLINE void ForEachActorOnTile(const int32 Tile, FuncType&& Func) const
+	{
+		for (int32 EntryIndex = GetHead(Tile); EntryIndex != INDEX_NONE; EntryIndex = Entries[EntryIndex].Next)
+		{
+			if(AActor* Actor = Entries[EntryIndex].Actor.Get()) Func(Actor);
+		}
+	}
+
+	// Entries are recycled through a free list threaded on Next
+	TArray<FEntry> Entries;
+	int32 FreeEntry = INDEX_NONE;
+
+	/** First entry of each tile, INDEX_NONE when empty */
+	TArray<int32> TileHeads;
+	FGridBitset Occupied;
+
+	// Sparse mode, only occupied tiles have a head
+	TMap<int32, int32> SparseHeads;
+	bool bSparse = false;
+
+	/** First entry of each actor in the index */
+	TMap<TObjectKey<AActor>, int32> ActorEntries;
+
+	int32 NumRows = 0;
+	int32 NumColumns = 0;
+};
+
+template <typename FuncType>
+void FGridOccupancyIndex::ForEachOccupiedTileInRow(const int32 Row, const int32 MinColumn, const int32 MaxColumn, FuncType&& Func) const
+{
+	const int32 RowStart = Row * NumColumns;
+	const int32 StartIndex = RowStart + MinColumn;
+	const int32 EndIndex = RowStart + MaxColumn;
+
+	if(bSparse)
+	{
+		for (int32 Tile = StartIndex; Tile < EndIndex; ++Tile)
+		{
+			if(SparseHeads.Contains(Tile)) Func(Tile);
+		}
+		return;
+	}
+
+	const uint64* Words = Occupied.GetWords();
+	for (int32 WordIndex = StartIndex >> 6; WordIndex <= (EndIndex - 1) >> 6; ++WordIndex)
+	{
+		uint64 Word = Words[WordIndex];
+		const int32 WordStart = WordIndex << 6;
+		if(WordStart < StartIndex) Word &= ~0ull << (StartIndex - WordStart);
+		if(WordStart + 64 > EndIndex) Word &= ~0ull >> (WordStart + 64 - EndIndex);
+
+		while (Word != 0)
+		{
+			Func(WordStart + static_cast<int32>(FMath::CountTrailingZeros64(Word)));
+			Word &= Word - 1;
+		}
+	}
+}
@@ -0,0 +1,121 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GridManager.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGridOccupancyRectWriteTest, "OptimizedGrid.Occupancy.RectWriteKeepsOccupant", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/**
+ * @brief A rect write puts the occupant on every tile of the rect, overlapping writes only replace the tiles they cover
+ */
+bool FGridOccupancyRectWriteTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("GridOccupancyTest"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	AGridManager* Grid = World->SpawnActorDeferred<AGridManager>(AGridManager::StaticClass(), FTransform::Identity);
+	Grid->NumRows = 8;
+	Grid->NumColumns = 8;
+	Grid->FinishSpawning(FTransform::Identity);
+	Grid->GenerateTileInfo();
+
+	AActor* Building = World->SpawnActor<AActor>();
+	AActor* Other = World->SpawnActor<AActor>();
+	const int32 Occupant = static_cast<int32>(EGridTileField::Occupant);
+	TArray<AActor*> Actors;
+
+	// Rows 1 to 3, columns 2 to 5, ends included
+	TestTrue(TEXT("Rect write"), Grid->SetTilesInRect(1, 2, 3, 5, Occupant, true, true, Building));
+	for (int32 Row = 0; Row < 8; ++Row)
+	{
+		for (int32 Column = 0; Column < 8; ++Column)
+		{
+			const bool bInRect = Row >= 1 && Row <= 3 && Column >= 2 && Column <= 5;
+			Grid->GetActorsOnTile(Row, Column, Actors);
+			TestEqual(FString::Printf(TEXT("Actors on (%d, %d)"), Row, Column), Actors.Num(), bInRect ? 1 : 0);
+			if(bInRect && Actors.Num() == 1) TestTrue(FString::Printf(TEXT("Building on (%d, %d)"), Row, Column), Actors[0] == Building);
+		}
+	}
+	TestEqual(TEXT("Actors in rect, once per tile"), Grid->GetActorsInRect(0, 0, 7, 7, Actors), 12);
+
+	// The second write takes over the overlapped column only
+	TestTrue(TEXT("Overlapping write"), Grid->SetTilesInRect(0, 5, 7, 5, Occupant, true, true, Other));
+	Grid->GetActorsOnTile(2, 4, Actors);
+	TestTrue(TEXT("Building kept next to the overlap"), Actors.Num() == 1 && Actors[0] == Building);
+	Grid->GetActorsOnTile(2, 5, Actors);
+	TestTrue(TEXT("Other on the overlap"), Actors.Num() == 1 && Actors[0] == Other);
+
+	TestTrue(TEXT("Release building"), Grid->ReleaseTileSpace(Building));
+	TestEqual(TEXT("Building tiles after release"), Grid->GetActorsInRect(1, 2, 3, 4, Actors), 0);
+	int32 Row, Column;
+	TestFalse(TEXT("Building has no tile"), Grid->GetActorTile(Building, Row, Column));
+	TestEqual(TEXT("Other tiles after release"), Grid->GetActorsInRect(0, 5, 7, 5, Actors), 8);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGridOccupancyTileInfoWriteTest, "OptimizedGrid.Occupancy.TileInfoWriteKeepsOtherOccupants", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/**
+ * @brief A tile info write only replaces the first occupant, and only when it names another actor
+ */
+bool FGridOccupancyTileInfoWriteTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("GridOccupancyTest"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	AGridManager* Grid = World->SpawnActorDeferred<AGridManager>(AGridManager::StaticClass(), FTransform::Identity);
+	Grid->NumRows = 8;
+	Grid->NumColumns = 8;
+	Grid->FinishSpawning(FTransform::Identity);
+	Grid->GenerateTileInfo();
+
+	bool bValid;
+	FVector TileLocation;
+	Grid->GetTileInfoAtPositionWithLocation(3, 4, TileLocation, bValid);
+	TestTrue(TEXT("Tile location"), bValid);
+
+	// Two actors standing on the same tile
+	AActor* First = World->SpawnActor<AActor>(TileLocation, FRotator::ZeroRotator);
+	AActor* Second = World->SpawnActor<AActor>(TileLocation, FRotator::ZeroRotator);
+	TestTrue(TEXT("First takes the tile"), Grid->TakeTileSpace(First, false));
+	TestTrue(TEXT("Second takes the tile"), Grid->TakeTileSpace(Second, false));
+	TArray<AActor*> Actors;
+	TestEqual(TEXT("Occupants before the writes"), Grid->GetActorsOnTile(3, 4, Actors), 2);
+
+	// Writing the tile back with only a flag changed keeps both occupants
+	FTileInfo TileInfo = Grid->GetTileInfoAtPositionCopy(3, 4, bValid);
+	TileInfo.bCanWalkOn = false;
+	TestTrue(TEXT("Flag write"), Grid->SetTileInfoAtPosition(3, 4, TileInfo));
+	TestEqual(TEXT("Occupants after the flag write"), Grid->GetActorsOnTile(3, 4, Actors), 2);
+
+	// Another actor replaces the first occupant only
+	AActor* Replaced = TileInfo.ActorOnTile;
+	AActor* Kept = Replaced == First ? Second : First;
+	AActor* Third = World->SpawnActor<AActor>();
+	TileInfo.ActorOnTile = Third;
+	TestTrue(TEXT("Occupant write"), Grid->SetTileInfoAtPosition(3, 4, TileInfo));
+	Grid->GetActorsOnTile(3, 4, Actors);
+	TestEqual(TEXT("Occupants after the occupant write"), Actors.Num(), 2);
+	TestTrue(TEXT("Third on the tile"), Actors.Contains(Third));
+	TestTrue(TEXT("Other occupant kept"), Actors.Contains(Kept));
+	TestFalse(TEXT("Replaced occupant gone"), Actors.Contains(Replaced));
+
+	int32 Row, Column;
+	TestTrue(TEXT("Kept occupant still has its tile"), Grid->GetActorTile(Kept, Row, Column) && Row == 3 && Column == 4);
+	TestFalse(TEXT("Replaced occupant has no tile"), Grid->GetActorTile(Replaced, Row, Column));
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif
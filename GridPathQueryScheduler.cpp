@@ -0,0 +1,216 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#include "GridPathQueryScheduler.h"
+
+#include "GridPathfinder.h"
+
+FGridPathQueryScheduler::FGridPathQueryScheduler()
+	: NextInFlightQuery(0)
+{
+}
+
+FGridPathQueryScheduler::~FGridPathQueryScheduler()
+{
+	Reset();
+}
+
+/**
+ * @brief Queue a query, it is dispatched on the next Tick with budget left
+ * @return Request id passed back to OnComplete, usable with Cancel
+ */
+int32 FGridPathQueryScheduler::Enqueue(const FIntPoint Start, const FIntPoint Goal, const bool bReachabilityOnly, FOnQueryComplete&& OnComplete)
+{
+	FQuery& Query = PendingQueries.AddDefaulted_GetRef();
+	Query.RequestId = NextRequestId++;
+	Query.Start = Start;
+	Query.Goal = Goal;
+	Query.bReachabilityOnly = bReachabilityOnly;
+	Query.OnComplete = MoveTemp(OnComplete);
+
+	if(NextRequestId <= 0) NextRequestId = 1;
+	return Query.RequestId;
+}
+
+/**
+ * @brief Cancel a pending or in flight query, its callback will not be called
+ * @return false if no query with this id is waiting for a result
+ */
+bool FGridPathQueryScheduler::Cancel(const int32 RequestId)
+{
+	if(const int32 PendingIndex = PendingQueries.IndexOfByPredicate([RequestId](const FQuery& Query) { return Query.RequestId == RequestId; }); PendingIndex != INDEX_NONE)
+	{
+		PendingQueries.RemoveAt(PendingIndex);
+		return true;
+	}
+
+	// Workers never read the cancelled flag, the result is just dropped on delivery
+	for (TArray<FQuery>* Queries : {&InFlightQueries, DeliveringQueries})
+	{
+		if(Queries == nullptr) continue;
+		for (FQuery& Query : *Queries)
+		{
+			if(Query.RequestId == RequestId && !Query.bCancelled)
+			{
+				Query.bCancelled = true;
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+bool FGridPathQueryScheduler::Tick(const FGridTileStorage& Storage, const int32 MaxQueriesPerFrame, const int32 CostLayer, const int32 PagedWindowMargin)
+{
+	if(InFlightTasks.Num() > 0)
+	{
+		for (const UE::Tasks::FTask& Task : InFlightTasks)
+		{
+			if(!Task.IsCompleted()) return true;
+		}
+		DeliverBatch();
+	}
+
+	if(PendingQueries.Num() > 0)
+	{
+		if(!Storage.IsPaged()) UpdateSnapshot(Storage, CostLayer);
+		DispatchBatch(FMath::Max(MaxQueriesPerFrame, 1), Storage, PagedWindowMargin);
+	}
+
+	return HasPendingWork();
+}
+
+void FGridPathQueryScheduler::Reset()
+{
+	UE::Tasks::Wait(InFlightTasks);
+	InFlightTasks.Reset();
+	InFlightQueries.Reset();
+	PendingQueries.Reset();
+
+	// Called from a callback, the rest of the batch being delivered is dropped as well
+	if(DeliveringQueries != nullptr)
+	{
+		for (FQuery& Query : *DeliveringQueries)
+		{
+			Query.bCancelled = true;
+		}
+	}
+}
+
+/**
+ * @brief Copy the walk bits and the cost plane if they changed since the last snapshot.
+ * Tasks of an older batch keep their own reference, so the storage can be mutated while they run
+ */
+void FGridPathQueryScheduler::UpdateSnapshot(const FGridTileStorage& Storage, int32 CostLayer)
+{
+	const FGridAttributeLayers& Attributes = Storage.GetAttributes();
+	if(!Attributes.IsValidLayer(CostLayer)) CostLayer = INDEX_NONE;
+	const uint32 CostVersion = CostLayer != INDEX_NONE ? Attributes.GetLayerVersion(CostLayer) : 0;
+
+	if(Snapshot.IsValid() && Snapshot->WalkVersion == Storage.GetWalkVersion() && Snapshot->NumRows == Storage.GetNumRows() && Snapshot->NumColumns == Storage.GetNumColumns() &&
+		Snapshot->CostLayer == CostLayer && Snapshot->CostVersion == CostVersion)
+	{
+		return;
+	}
+
+	const TSharedRef<FGridWalkSnapshot, ESPMode::ThreadSafe> NewSnapshot = MakeShared<FGridWalkSnapshot, ESPMode::ThreadSafe>();
+	NewSnapshot->Walkable = Storage.GetWalkableBits();
+	NewSnapshot->NumRows = Storage.GetNumRows();
+	NewSnapshot->NumColumns = Storage.GetNumColumns();
+	NewSnapshot->WalkVersion = Storage.GetWalkVersion();
+	NewSnapshot->CostLayer = CostLayer;
+	NewSnapshot->CostVersion = CostVersion;
+	if(CostLayer != INDEX_NONE)
+	{
+		const TConstArrayView<uint8> CostBytes = Attributes.GetPlaneBytes(CostLayer);
+		NewSnapshot->CostBytes.Append(CostBytes.GetData(), CostBytes.Num());
+		NewSnapshot->CostType = Attributes.GetLayerType(CostLayer);
+	}
+	Snapshot = NewSnapshot;
+}
+
+TSharedRef<FGridWalkSnapshot, ESPMode::ThreadSafe> FGridPathQueryScheduler::MakeWindowSnapshot(const FGridTileStorage& Storage, const FIntPoint Start, const FIntPoint Goal, const int32 Margin)
+{
+	const FIntRect Window(
+		FMath::Max(FMath::Min(Start.X, Goal.X) - Margin, 0), FMath::Max(FMath::Min(Start.Y, Goal.Y) - Margin, 0),
+		FMath::Min(FMath::Max(Start.X, Goal.X) + Margin + 1, Storage.GetNumRows()), FMath::Min(FMath::Max(Start.Y, Goal.Y) + Margin + 1, Storage.GetNumColumns()));
+
+	const TSharedRef<FGridWalkSnapshot, ESPMode::ThreadSafe> NewSnapshot = MakeShared<FGridWalkSnapshot, ESPMode::ThreadSafe>();
+	NewSnapshot->Origin = Window.Min;
+	NewSnapshot->NumRows = FMath::Max(Window.Width(), 0);
+	NewSnapshot->NumColumns = FMath::Max(Window.Height(), 0);
+	NewSnapshot->WalkVersion = Storage.GetWalkVersion();
+	if(NewSnapshot->NumRows > 0 && NewSnapshot->NumColumns > 0)
+	{
+		Storage.GetPages().ExtractWalkBits(Window, NewSnapshot->Walkable);
+	}
+	return NewSnapshot;
+}
+
+/**
+ * @brief Move up to MaxQueries pending queries in flight and launch one task per worker to solve them
+ */
+void FGridPathQueryScheduler::DispatchBatch(const int32 MaxQueries, const FGridTileStorage& Storage, const int32 PagedWindowMargin)
+{
+	const int32 BatchSize = FMath::Min(PendingQueries.Num(), MaxQueries);
+	InFlightQueries.Reset();
+	InFlightQueries.Reserve(BatchSize);
+	for (int32 i = 0; i < BatchSize; ++i)
+	{
+		FQuery& Query = InFlightQueries.Add_GetRef(MoveTemp(PendingQueries[i]));
+
+		// Pages are not thread safe, windows are copied here on the game thread
+		if(Storage.IsPaged())
+		{
+			Query.Window = MakeWindowSnapshot(Storage, Query.Start, Query.Goal, PagedWindowMargin);
+		}
+	}
+	PendingQueries.RemoveAt(0, BatchSize, EAllowShrinking::No);
+
+	const int32 NumTasks = FMath::Clamp(FTaskGraphInterface::Get().GetNumWorkerThreads(), 1, BatchSize);
+	while (Pathfinders.Num() < NumTasks)
+	{
+		Pathfinders.Add(MakeUnique<FGridPathfinder>());
+	}
+
+	NextInFlightQuery = 0;
+	for (int32 TaskIndex = 0; TaskIndex < NumTasks; ++TaskIndex)
+	{
+		InFlightTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, TaskIndex, WalkSnapshot = Snapshot]()
+		{
+			FGridPathfinder& Pathfinder = *Pathfinders[TaskIndex];
+			for (int32 QueryIndex = NextInFlightQuery++; QueryIndex < InFlightQueries.Num(); QueryIndex = NextInFlightQuery++)
+			{
+				FQuery& Query = InFlightQueries[QueryIndex];
+				const FGridWalkSnapshot& Search = Query.Window.IsValid() ? *Query.Window : *WalkSnapshot;
+				Query.bSuccess = Pathfinder.FindPathWeighted(Search.Walkable, Search.GetCostView(), Search.NumRows, Search.NumColumns, Query.Start - Search.Origin, Query.Goal - Search.Origin, Query.Path);
+				for (FIntPoint& Tile : Query.Path)
+				{
+					Tile += Search.Origin;
+				}
+				if(Query.bReachabilityOnly) Query.Path.Empty();
+			}
+		}));
+	}
+}
+
+void FGridPathQueryScheduler::DeliverBatch()
+{
+	InFlightTasks.Reset();
+
+	// Callbacks may enqueue, cancel or reset, so they run over a local copy that only Cancel and Reset reach, through
+	// the cancelled flags. New queries go to the pending list and wait for the next batch
+	TArray<FQuery> Completed = MoveTemp(InFlightQueries);
+	DeliveringQueries = &Completed;
+	for (FQuery& Query : Completed)
+	{
+		if(!Query.bCancelled && Query.OnComplete)
+		{
+			Query.OnComplete(Query.RequestId, Query.bSuccess, Query.Path);
+		}
+	}
+	DeliveringQueries = nullptr;
+
+	// Keep the allocation for the next batch
+	Completed.Reset();
+	if(InFlightQueries.Max() == 0) InFlightQueries = MoveTemp(Completed);
+}
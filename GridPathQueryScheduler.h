@@ -0,0 +1,101 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GridTileStorage.h"
+#include "Tasks/Task.h"
+
+#include <atomic>
+
+class FGridPathfinder;
+
+/**
+ * Immutable copy of the walk state, and of the cost layer if any, that worker threads search against.
+ * Paged grids are copied one window per query, Origin is the grid tile of the window first tile
+ */
+struct FGridWalkSnapshot
+{
+	FGridBitset Walkable;
+	FIntPoint Origin = FIntPoint::ZeroValue;
+	int32 NumRows = 0;
+	int32 NumColumns = 0;
+	uint32 WalkVersion = 0;
+
+	TArray<uint8> CostBytes;
+	EGridAttributeType CostType = EGridAttributeType::UInt8;
+	int32 CostLayer = INDEX_NONE;
+	uint32 CostVersion = 0;
+
+	FORCEINLINE FGridAttributePlaneView GetCostView() const
+	{
+		return CostLayer != INDEX_NONE ? FGridAttributePlaneView{CostBytes.GetData(), CostType} : FGridAttributePlaneView();
+	}
+};
+
+/**
+ * Queues path and reachability queries and solves them in batches on worker threads.
+ * Must only be used from the game thread, results are delivered from Tick.
+ */
+class FGridPathQueryScheduler
+{
+public:
+	using FOnQueryComplete = TFunction<void(int32 RequestId, bool bSuccess, const TArray<FIntPoint>& Path)>;
+
+	FGridPathQueryScheduler();
+	~FGridPathQueryScheduler();
+
+	int32 Enqueue(FIntPoint Start, FIntPoint Goal, bool bReachabilityOnly, FOnQueryComplete&& OnComplete);
+	bool Cancel(int32 RequestId);
+
+	/**
+	 * @brief Deliver the finished batch then dispatch the next one against a snapshot of the storage
+	 * @param MaxQueriesPerFrame Budget of queries dispatched in one batch
+	 * @param CostLayer Attribute layer used as tile cost, INDEX_NONE for uniform costs
+	 * @param PagedWindowMargin Tiles added around the start/goal box of each query on paged storage
+	 * @return true while queries are pending or in flight
+	 */
+	bool Tick(const FGridTileStorage& Storage, int32 MaxQueriesPerFrame, int32 CostLayer = INDEX_NONE, int32 PagedWindowMargin = 32);
+
+	/** Copy the walk flags of the start/goal box grown by Margin, clipped to the grid */
+	static TSharedRef<FGridWalkSnapshot, ESPMode::ThreadSafe> MakeWindowSnapshot(const FGridTileStorage& Storage, FIntPoint Start, FIntPoint Goal, int32 Margin);
+
+	/** Wait for the in flight batch and drop every query without calling back */
+	void Reset();
+
+	FORCEINLINE bool HasPendingWork() const { return PendingQueries.Num() > 0 || InFlightTasks.Num() > 0; }
+
+private:
+	struct FQuery
+	{
+		int32 RequestId = INDEX_NONE;
+		FIntPoint Start;
+		FIntPoint Goal;
+		bool bReachabilityOnly = false;
+		bool bCancelled = false;
+		bool bSuccess = false;
+		TArray<FIntPoint> Path;
+		FOnQueryComplete OnComplete;
+
+		// Paged storage only, the window this query searches in
+		TSharedPtr<const FGridWalkSnapshot, ESPMode::ThreadSafe> Window;
+	};
+
+	void UpdateSnapshot(const FGridTileStorage& Storage, int32 CostLayer);
+	void DispatchBatch(int32 MaxQueries, const FGridTileStorage& Storage, int32 PagedWindowMargin);
+	void DeliverBatch();
+
+	TArray<FQuery> PendingQueries;
+	TArray<FQuery> InFlightQueries;
+
+	// Batch whose callbacks are running, set only inside DeliverBatch
+	TArray<FQuery>* DeliveringQueries = nullptr;
+	TArray<UE::Tasks::FTask> InFlightTasks;
+	std::atomic<int32> NextInFlightQuery;
+
+	// One pathfinder per worker task, kept so their search buffers are reused between batches
+	TArray<TUniquePtr<FGridPathfinder>> Pathfinders;
+
+	TSharedPtr<const FGridWalkSnapshot, ESPMode::ThreadSafe> Snapshot;
+	int32 NextRequestId = 1;
+};
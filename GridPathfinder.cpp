@@ -0,0 +1,363 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#include "GridPathfinder.h"
+
+#include "GridTileStorage.h"
+
+namespace GridPathfinder
+{
+	constexpr float DiagonalCost = UE_SQRT_2;
+
+	/** Octile distance between two tiles */
+	FORCEINLINE float OctileDistance(const int32 RowDelta, const int32 ColumnDelta)
+	{
+		const int32 DeltaX = FMath::Abs(RowDelta);
+		const int32 DeltaY = FMath::Abs(ColumnDelta);
+		return (DeltaX + DeltaY) + (DiagonalCost - 2.0f) * FMath::Min(DeltaX, DeltaY);
+	}
+}
+
+/**
+ * @brief Bind the query state and handle the trivial cases shared by every search
+ * @param bOutDone Set when the result is already known, the return value is then the query result
+ */
+bool FGridPathfinder::BeginQuery(const FGridBitset& Walkable, const int32 InNumRows, const int32 InNumColumns, const FIntPoint Start, const FIntPoint Goal, TArray<FIntPoint>& OutPath, bool& bOutDone)
+{
+	OutPath.Reset();
+	bOutDone = true;
+
+	const int32 NumTiles = InNumRows * InNumColumns;
+	if(NumTiles <= 0 || Walkable.Num() != NumTiles) return false;
+
+	WalkWords = Walkable.GetWords();
+	NumRows = InNumRows;
+	NumColumns = InNumColumns;
+	GoalRow = Goal.X;
+	GoalColumn = Goal.Y;
+
+	if(!IsWalkable(Start.X, Start.Y) || !IsWalkable(Goal.X, Goal.Y)) return false;
+
+	if(Start == Goal)
+	{
+		OutPath.Add(Start);
+		return true;
+	}
+
+	bOutDone = false;
+	PrepareSearch(NumTiles);
+	return false;
+}
+
+bool FGridPathfinder::FindPath(const FGridBitset& Walkable, const int32 InNumRows, const int32 InNumColumns, const FIntPoint Start, const FIntPoint Goal, TArray<FIntPoint>& OutPath)
+{
+	bool bDone;
+	const bool bResult = BeginQuery(Walkable, InNumRows, InNumColumns, Start, Goal, OutPath, bDone);
+	if(bDone) return bResult;
+
+	const int32 StartIndex = Start.X * NumColumns + Start.Y;
+	const int32 GoalIndex = Goal.X * NumColumns + Goal.Y;
+
+	const auto OpenPredicate = [](const FOpenNode& A, const FOpenNode& B) { return A.Cost < B.Cost; };
+
+	NodeSearchIds[StartIndex] = SearchId;
+	NodeCosts[StartIndex] = 0.0f;
+	NodeParents[StartIndex] = INDEX_NONE;
+	NodeStates[StartIndex] = ENodeState::Open;
+	OpenList.HeapPush({StartIndex, Heuristic(Start.X, Start.Y)}, OpenPredicate);
+
+	while (OpenList.Num() > 0)
+	{
+		FOpenNode Current;
+		OpenList.HeapPop(Current, OpenPredicate, EAllowShrinking::No);
+
+		// Stale duplicate of a node already expanded with a lower cost
+		if(NodeStates[Current.Index] == ENodeState::Closed) continue;
+		NodeStates[Current.Index] = ENodeState::Closed;
+
+		if(Current.Index == GoalIndex)
+		{
+			BuildPath(GoalIndex, OutPath);
+			return true;
+		}
+
+		const int32 Row = Current.Index / NumColumns;
+		const int32 Column = Current.Index % NumColumns;
+
+		FIntPoint Neighbors[8];
+		const int32 NumNeighbors = GetPrunedNeighbors(Current.Index, Neighbors);
+		for (int32 i = 0; i < NumNeighbors; ++i)
+		{
+			const int32 JumpIndex = Jump(Neighbors[i].X, Neighbors[i].Y, FMath::Sign(Neighbors[i].X - Row), FMath::Sign(Neighbors[i].Y - Column));
+			if(JumpIndex == INDEX_NONE) continue;
+
+			const bool bVisited = IsVisited(JumpIndex);
+			if(bVisited && NodeStates[JumpIndex] == ENodeState::Closed) continue;
+
+			const int32 JumpRow = JumpIndex / NumColumns;
+			const int32 JumpColumn = JumpIndex % NumColumns;
+			const float Cost = NodeCosts[Current.Index] + GridPathfinder::OctileDistance(JumpRow - Row, JumpColumn - Column);
+			if(bVisited && Cost >= NodeCosts[JumpIndex]) continue;
+
+			NodeSearchIds[JumpIndex] = SearchId;
+			NodeCosts[JumpIndex] = Cost;
+			NodeParents[JumpIndex] = Current.Index;
+			NodeStates[JumpIndex] = ENodeState::Open;
+			OpenList.HeapPush({JumpIndex, Cost + Heuristic(JumpRow, JumpColumn)}, OpenPredicate);
+		}
+	}
+
+	return false;
+}
+
+bool FGridPathfinder::FindPathWeighted(const FGridBitset& Walkable, const FGridAttributePlaneView& Costs, const int32 InNumRows, const int32 InNumColumns, const FIntPoint Start, const FIntPoint Goal, TArray<FIntPoint>& OutPath)
+{
+	if(!Costs.IsValid()) return FindPath(Walkable, InNumRows, InNumColumns, Start, Goal, OutPath);
+
+	bool bDone;
+	const bool bResult = BeginQuery(Walkable, InNumRows, InNumColumns, Start, Goal, OutPath, bDone);
+	if(bDone) return bResult;
+
+	const int32 StartIndex = Start.X * NumColumns + Start.Y;
+	const int32 GoalIndex = Goal.X * NumColumns + Goal.Y;
+
+	const auto OpenPredicate = [](const FOpenNode& A, const FOpenNode& B) { return A.Cost < B.Cost; };
+
+	NodeSearchIds[StartIndex] = SearchId;
+	NodeCosts[StartIndex] = 0.0f;
+	NodeParents[StartIndex] = INDEX_NONE;
+	NodeStates[StartIndex] = ENodeState::Open;
+	OpenList.HeapPush({StartIndex, Heuristic(Start.X, Start.Y)}, OpenPredicate);
+
+	while (OpenList.Num() > 0)
+	{
+		FOpenNode Current;
+		OpenList.HeapPop(Current, OpenPredicate, EAllowShrinking::No);
+
+		if(NodeStates[Current.Index] == ENodeState::Closed) continue;
+		NodeStates[Current.Index] = ENodeState::Closed;
+
+		if(Current.Index == GoalIndex)
+		{
+			BuildPath(GoalIndex, OutPath);
+			return true;
+		}
+
+		const int32 Row = Current.Index / NumColumns;
+		const int32 Column = Current.Index % NumColumns;
+		for (int32 RowStep = -1; RowStep <= 1; ++RowStep)
+		{
+			for (int32 ColumnStep = -1; ColumnStep <= 1; ++ColumnStep)
+			{
+				if(RowStep == 0 && ColumnStep == 0) continue;
+				if(!IsWalkable(Row + RowStep, Column + ColumnStep)) continue;
+
+				const bool bDiagonal = RowStep != 0 && ColumnStep != 0;
+				if(bDiagonal && (!IsWalkable(Row + RowStep, Column) || !IsWalkable(Row, Column + ColumnStep))) continue;
+
+				const int32 NeighborIndex = Current.Index + RowStep * NumColumns + ColumnStep;
+				const bool bVisited = IsVisited(NeighborIndex);
+				if(bVisited && NodeStates[NeighborIndex] == ENodeState::Closed) continue;
+
+				const float StepCost = (bDiagonal ? GridPathfinder::DiagonalCost : 1.0f) * FMath::Max(Costs.Get(NeighborIndex), 1.0f);
+				const float Cost = NodeCosts[Current.Index] + StepCost;
+				if(bVisited && Cost >= NodeCosts[NeighborIndex]) continue;
+
+				NodeSearchIds[NeighborIndex] = SearchId;
+				NodeCosts[NeighborIndex] = Cost;
+				NodeParents[NeighborIndex] = Current.Index;
+				NodeStates[NeighborIndex] = ENodeState::Open;
+				OpenList.HeapPush({NeighborIndex, Cost + Heuristic(Row + RowStep, Column + ColumnStep)}, OpenPredicate);
+			}
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @brief Size the node buffers to the grid and start a new search id, nodes of older searches become unvisited
+ */
+void FGridPathfinder::PrepareSearch(const int32 NumTiles)
+{
+	if(NodeSearchIds.Num() != NumTiles)
+	{
+		NodeCosts.SetNumUninitialized(NumTiles);
+		NodeParents.SetNumUninitialized(NumTiles);
+		NodeStates.SetNumUninitialized(NumTiles);
+		NodeSearchIds.SetNumZeroed(NumTiles);
+		SearchId = 0;
+	}
+
+	if(++SearchId == 0)
+	{
+		// Search id wrapped around, old stamps could alias the new ones
+		FMemory::Memzero(NodeSearchIds.GetData(), NodeSearchIds.Num() * sizeof(uint32));
+		SearchId = 1;
+	}
+
+	OpenList.Reset();
+}
+
+int32 FGridPathfinder::Jump(const int32 Row, const int32 Column, const int32 RowStep, const int32 ColumnStep) const
+{
+	return RowStep != 0 && ColumnStep != 0 ? JumpDiagonal(Row, Column, RowStep, ColumnStep) : JumpStraight(Row, Column, RowStep, ColumnStep);
+}
+
+/**
+ * @brief Walk along a row or a column until a jump point, the goal or an obstacle is hit
+ * @return Index of the jump point, INDEX_NONE if blocked
+ */
+int32 FGridPathfinder::JumpStraight(int32 Row, int32 Column, const int32 RowStep, const int32 ColumnStep) const
+{
+	while (IsWalkable(Row, Column))
+	{
+		if(Row == GoalRow && Column == GoalColumn) return Row * NumColumns + Column;
+
+		// Forced neighbors: a side tile that opens up right after an obstacle behind it
+		if(RowStep != 0)
+		{
+			if((IsWalkable(Row, Column - 1) && !IsWalkable(Row - RowStep, Column - 1)) ||
+				(IsWalkable(Row, Column + 1) && !IsWalkable(Row - RowStep, Column + 1)))
+			{
+				return Row * NumColumns + Column;
+			}
+		}
+		else
+		{
+			if((IsWalkable(Row - 1, Column) && !IsWalkable(Row - 1, Column - ColumnStep)) ||
+				(IsWalkable(Row + 1, Column) && !IsWalkable(Row + 1, Column - ColumnStep)))
+			{
+				return Row * NumColumns + Column;
+			}
+		}
+
+		Row += RowStep;
+		Column += ColumnStep;
+	}
+	return INDEX_NONE;
+}
+
+/**
+ * @brief Walk along a diagonal, stopping where one of the straight sub jumps finds something
+ * @return Index of the jump point, INDEX_NONE if blocked
+ */
+int32 FGridPathfinder::JumpDiagonal(int32 Row, int32 Column, const int32 RowStep, const int32 ColumnStep) const
+{
+	while (IsWalkable(Row, Column))
+	{
+		if(Row == GoalRow && Column == GoalColumn) return Row * NumColumns + Column;
+
+		if(JumpStraight(Row + RowStep, Column, RowStep, 0) != INDEX_NONE || JumpStraight(Row, Column + ColumnStep, 0, ColumnStep) != INDEX_NONE)
+		{
+			return Row * NumColumns + Column;
+		}
+
+		// No corner cutting, both orthogonal tiles must be open to keep going diagonally
+		if(!IsWalkable(Row + RowStep, Column) || !IsWalkable(Row, Column + ColumnStep)) return INDEX_NONE;
+
+		Row += RowStep;
+		Column += ColumnStep;
+	}
+	return INDEX_NONE;
+}
+
+/**
+ * @brief Neighbors worth jumping to from a node given the direction it was reached from
+ * @return Number of neighbors written
+ */
+int32 FGridPathfinder::GetPrunedNeighbors(const int32 Index, FIntPoint (&OutNeighbors)[8]) const
+{
+	const int32 Row = Index / NumColumns;
+	const int32 Column = Index % NumColumns;
+	int32 Count = 0;
+
+	const int32 Parent = NodeParents[Index];
+	if(Parent == INDEX_NONE)
+	{
+		// Start node, every open neighbor
+		for (int32 RowStep = -1; RowStep <= 1; ++RowStep)
+		{
+			for (int32 ColumnStep = -1; ColumnStep <= 1; ++ColumnStep)
+			{
+				if(RowStep == 0 && ColumnStep == 0) continue;
+				if(!IsWalkable(Row + RowStep, Column + ColumnStep)) continue;
+				if(RowStep != 0 && ColumnStep != 0 && (!IsWalkable(Row + RowStep, Column) || !IsWalkable(Row, Column + ColumnStep))) continue;
+				OutNeighbors[Count++] = FIntPoint(Row + RowStep, Column + ColumnStep);
+			}
+		}
+		return Count;
+	}
+
+	const int32 RowStep = FMath::Sign(Row - Parent / NumColumns);
+	const int32 ColumnStep = FMath::Sign(Column - Parent % NumColumns);
+
+	if(RowStep != 0 && ColumnStep != 0)
+	{
+		const bool bColumnOpen = IsWalkable(Row, Column + ColumnStep);
+		const bool bRowOpen = IsWalkable(Row + RowStep, Column);
+		if(bColumnOpen) OutNeighbors[Count++] = FIntPoint(Row, Column + ColumnStep);
+		if(bRowOpen) OutNeighbors[Count++] = FIntPoint(Row + RowStep, Column);
+		if(bColumnOpen && bRowOpen) OutNeighbors[Count++] = FIntPoint(Row + RowStep, Column + ColumnStep);
+	}
+	else if(RowStep != 0)
+	{
+		const bool bNextOpen = IsWalkable(Row + RowStep, Column);
+		const bool bRightOpen = IsWalkable(Row, Column + 1);
+		const bool bLeftOpen = IsWalkable(Row, Column - 1);
+		if(bNextOpen)
+		{
+			OutNeighbors[Count++] = FIntPoint(Row + RowStep, Column);
+			if(bRightOpen) OutNeighbors[Count++] = FIntPoint(Row + RowStep, Column + 1);
+			if(bLeftOpen) OutNeighbors[Count++] = FIntPoint(Row + RowStep, Column - 1);
+		}
+		if(bRightOpen) OutNeighbors[Count++] = FIntPoint(Row, Column + 1);
+		if(bLeftOpen) OutNeighbors[Count++] = FIntPoint(Row, Column - 1);
+	}
+	else
+	{
+		const bool bNextOpen = IsWalkable(Row, Column + ColumnStep);
+		const bool bDownOpen = IsWalkable(Row + 1, Column);
+		const bool bUpOpen = IsWalkable(Row - 1, Column);
+		if(bNextOpen)
+		{
+			OutNeighbors[Count++] = FIntPoint(Row, Column + ColumnStep);
+			if(bDownOpen) OutNeighbors[Count++] = FIntPoint(Row + 1, Column + ColumnStep);
+			if(bUpOpen) OutNeighbors[Count++] = FIntPoint(Row - 1, Column + ColumnStep);
+		}
+		if(bDownOpen) OutNeighbors[Count++] = FIntPoint(Row + 1, Column);
+		if(bUpOpen) OutNeighbors[Count++] = FIntPoint(Row - 1, Column);
+	}
+	return Count;
+}
+
+float FGridPathfinder::Heuristic(const int32 Row, const int32 Column) const
+{
+	return GridPathfinder::OctileDistance(GoalRow - Row, GoalColumn - Column);
+}
+
+/**
+ * @brief Follow the parents from the goal back to the start and expand the jump points into every tile in between
+ */
+void FGridPathfinder::BuildPath(const int32 GoalIndex, TArray<FIntPoint>& OutPath)
+{
+	JumpPoints.Reset();
+	for (int32 Index = GoalIndex; Index != INDEX_NONE; Index = NodeParents[Index])
+	{
+		JumpPoints.Add(Index);
+	}
+
+	OutPath.Add(FIntPoint(JumpPoints.Last() / NumColumns, JumpPoints.Last() % NumColumns));
+	for (int32 i = JumpPoints.Num() - 2; i >= 0; --i)
+	{
+		const FIntPoint Target(JumpPoints[i] / NumColumns, JumpPoints[i] % NumColumns);
+		FIntPoint Tile = OutPath.Last();
+
+		// Segments between jump points are always straight or exactly diagonal
+		const FIntPoint Step(FMath::Sign(Target.X - Tile.X), FMath::Sign(Target.Y - Tile.Y));
+		while (Tile != Target)
+		{
+			Tile += Step;
+			OutPath.Add(Tile);
+		}
+	}
+}
@@ -0,0 +1,78 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GridAttributeLayers.h"
+
+struct FGridBitset;
+
+/**
+ * Jump Point Search over a walk bitset, 8-connected without cutting corners.
+ * Weighted queries fall back to plain A* over the same neighborhood since jumps assume uniform costs.
+ * Search buffers are kept between queries so steady state pathing does not allocate.
+ */
+class FGridPathfinder
+{
+public:
+	/**
+	 * @brief Find a path between two tiles
+	 * @param Walkable Walk bitset of the grid, indexed Row * NumColumns + Column
+	 * @param OutPath Every tile of the path from start to goal (both included), reset before writing
+	 * @return false if no path exists or start/goal are not walkable
+	 */
+	bool FindPath(const FGridBitset& Walkable, int32 InNumRows, int32 InNumColumns, FIntPoint Start, FIntPoint Goal, TArray<FIntPoint>& OutPath);
+
+	/**
+	 * @brief Find the cheapest path where entering a tile costs the step length times the tile cost
+	 * @param Costs Per tile cost multiplier, values below 1 count as 1 so the octile heuristic stays admissible
+	 */
+	bool FindPathWeighted(const FGridBitset& Walkable, const FGridAttributePlaneView& Costs, int32 InNumRows, int32 InNumColumns, FIntPoint Start, FIntPoint Goal, TArray<FIntPoint>& OutPath);
+
+private:
+	struct FOpenNode
+	{
+		int32 Index;
+		float Cost;
+	};
+
+	enum class ENodeState : uint8
+	{
+		Open,
+		Closed
+	};
+
+	bool BeginQuery(const FGridBitset& Walkable, int32 InNumRows, int32 InNumColumns, FIntPoint Start, FIntPoint Goal, TArray<FIntPoint>& OutPath, bool& bOutDone);
+	void PrepareSearch(int32 NumTiles);
+	int32 Jump(int32 Row, int32 Column, int32 RowStep, int32 ColumnStep) const;
+	int32 JumpStraight(int32 Row, int32 Column, int32 RowStep, int32 ColumnStep) const;
+	int32 JumpDiagonal(int32 Row, int32 Column, int32 RowStep, int32 ColumnStep) const;
+	int32 GetPrunedNeighbors(int32 Index, FIntPoint (&OutNeighbors)[8]) const;
+	float Heuristic(int32 Row, int32 Column) const;
+	void BuildPath(int32 GoalIndex, TArray<FIntPoint>& OutPath);
+
+	FORCEINLINE bool IsWalkable(const int32 Row, const int32 Column) const
+	{
+		if(Row < 0 || Row >= NumRows || Column < 0 || Column >= NumColumns) return false;
+		const int32 Index = Row * NumColumns + Column;
+		return (WalkWords[Index >> 6] >> (Index & 63)) & 1ull;
+	}
+
+	FORCEINLINE bool IsVisited(const int32 Index) const { return NodeSearchIds[Index] == SearchId; }
+
+	// Reused search storage, a node is only valid for the current search when its search id matches
+	TArray<float> NodeCosts;
+	TArray<int32> NodeParents;
+	TArray<uint32> NodeSearchIds;
+	TArray<ENodeState> NodeStates;
+	TArray<FOpenNode> OpenList;
+	TArray<int32> JumpPoints;
+	uint32 SearchId = 0;
+
+	// Query state
+	const uint64* WalkWords = nullptr;
+	int32 NumRows = 0;
+	int32 NumColumns = 0;
+	int32 GoalRow = 0;
+	int32 GoalColumn = 0;
+};
@@ -0,0 +1,251 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#include "GridRegionLabels.h"
+
+#include "GridTileStorage.h"
+
+void FGridRegionLabels::Build(const FGridBitset& Walkable, const int32 InNumRows, const int32 InNumColumns)
+{
+	NumRows = InNumRows;
+	NumColumns = InNumColumns;
+	RegionCount = 0;
+	LabelParents.Reset();
+
+	const int32 NumTiles = NumRows * NumColumns;
+	TileLabels.SetNumUninitialized(NumTiles);
+	VisitStamps.Init(0, NumTiles);
+	FloodStamp = 0;
+
+	// Single pass over the rows, each tile joins the labels of its left and upper neighbors
+	for (int32 Index = 0; Index < NumTiles; ++Index)
+	{
+		if(!Walkable.Get(Index))
+		{
+			TileLabels[Index] = INDEX_NONE;
+			continue;
+		}
+
+		const int32 Left = Index % NumColumns > 0 ? TileLabels[Index - 1] : INDEX_NONE;
+		const int32 Up = Index >= NumColumns ? TileLabels[Index - NumColumns] : INDEX_NONE;
+		if(Left != INDEX_NONE)
+		{
+			TileLabels[Index] = Left;
+			if(Up != INDEX_NONE) Union(Left, Up);
+		}
+		else
+		{
+			TileLabels[Index] = Up != INDEX_NONE ? Up : MakeLabel();
+		}
+	}
+
+	// Point every tile straight at its root so lookups right after a build are one hop
+	for (int32& Label : TileLabels)
+	{
+		if(Label != INDEX_NONE) Label = FindRoot(Label);
+	}
+	bBuilt = true;
+}
+
+void FGridRegionLabels::Invalidate()
+{
+	bBuilt = false;
+}
+
+void FGridRegionLabels::OnWalkableChanged(const FGridBitset& Walkable, const int32 Index)
+{
+	if(!bBuilt) return;
+
+	const bool bWalkable = Walkable.Get(Index);
+	if(bWalkable == (TileLabels[Index] != INDEX_NONE)) return;
+
+	if(bWalkable)
+	{
+		OnTileOpened(Walkable, Index);
+	}
+	else
+	{
+		OnTileClosed(Walkable, Index);
+	}
+
+	// Every change adds labels, start over once most of them are dead
+	if(LabelParents.Num() > TileLabels.Num() * 2 + 1024)
+	{
+		Build(Walkable, NumRows, NumColumns);
+	}
+}
+
+int32 FGridRegionLabels::GetRegionId(const int32 Index) const
+{
+	const int32 Label = bBuilt ? TileLabels[Index] : INDEX_NONE;
+	return Label != INDEX_NONE ? FindRoot(Label) : INDEX_NONE;
+}
+
+int32 FGridRegionLabels::MakeLabel()
+{
+	++RegionCount;
+	return LabelParents.Add(LabelParents.Num());
+}
+
+int32 FGridRegionLabels::FindRoot(int32 Label) const
+{
+	// Path halving, every other node on the way up is pointed at its grandparent
+	while (LabelParents[Label] != Label)
+	{
+		LabelParents[Label] = LabelParents[LabelParents[Label]];
+		Label = LabelParents[Label];
+	}
+	return Label;
+}
+
+bool FGridRegionLabels::Union(const int32 LabelA, const int32 LabelB)
+{
+	const int32 RootA = FindRoot(LabelA);
+	const int32 RootB = FindRoot(LabelB);
+	if(RootA == RootB) return false;
+
+	LabelParents[FMath::Max(RootA, RootB)] = FMath::Min(RootA, RootB);
+	--RegionCount;
+	return true;
+}
+
+void FGridRegionLabels::OnTileOpened(const FGridBitset& Walkable, const int32 Index)
+{
+	const int32 Label = MakeLabel();
+	TileLabels[Index] = Label;
+
+	int32 Neighbors[MaxFloods];
+	const int32 NumNeighbors = GetOpenNeighbors(Walkable, Index, Neighbors);
+	for (int32 i = 0; i < NumNeighbors; ++i)
+	{
+		Union(Label, TileLabels[Neighbors[i]]);
+	}
+}
+
+/**
+ * @brief Find out whether closing the tile split its region, and relabel the pieces that were cut off
+ */
+void FGridRegionLabels::OnTileClosed(const FGridBitset& Walkable, const int32 Index)
+{
+	TileLabels[Index] = INDEX_NONE;
+
+	int32 Neighbors[MaxFloods];
+	const int32 NumFloods = GetOpenNeighbors(Walkable, Index, Neighbors);
+	if(NumFloods == 0)
+	{
+		// The tile was a region on its own, its label is simply left unused
+		--RegionCount;
+		return;
+	}
+	if(NumFloods == 1) return;
+
+	if(FloodStamp >= MAX_uint32 - 2 * MaxFloods)
+	{
+		FMemory::Memzero(VisitStamps.GetData(), VisitStamps.Num() * sizeof(uint32));
+		FloodStamp = 0;
+	}
+	FloodStamp += MaxFloods;
+
+	// One flood per open neighbor, floods that meet are grouped since they are on the same piece
+	int32 Groups[MaxFloods];
+	int32 Heads[MaxFloods];
+	for (int32 Flood = 0; Flood < NumFloods; ++Flood)
+	{
+		Groups[Flood] = Flood;
+		Heads[Flood] = 0;
+		FloodTiles[Flood].Reset();
+		FloodTiles[Flood].Add(Neighbors[Flood]);
+		VisitStamps[Neighbors[Flood]] = FloodStamp + Flood;
+	}
+
+	const auto FindGroup = [&Groups](int32 Flood)
+	{
+		while (Groups[Flood] != Flood) Flood = Groups[Flood];
+		return Flood;
+	};
+
+	int32 NumGroups = NumFloods;
+	int32 OpenGroup = INDEX_NONE;
+	while (true)
+	{
+		// A group is open while one of its floods still has tiles to expand
+		bool bGroupOpen[MaxFloods] = {};
+		NumGroups = 0;
+		for (int32 Flood = 0; Flood < NumFloods; ++Flood)
+		{
+			const int32 Group = FindGroup(Flood);
+			NumGroups += Group == Flood;
+			bGroupOpen[Group] |= Heads[Flood] < FloodTiles[Flood].Num();
+		}
+
+		int32 NumOpenGroups = 0;
+		for (int32 Group = 0; Group < NumFloods; ++Group)
+		{
+			if(bGroupOpen[Group])
+			{
+				++NumOpenGroups;
+				OpenGroup = Group;
+			}
+		}
+
+		// Every closed group is a complete piece, the last open one does not need to be walked to the end
+		if(NumGroups == 1 || NumOpenGroups <= 1)
+		{
+			if(NumOpenGroups == 0) OpenGroup = FindGroup(0);
+			break;
+		}
+
+		for (int32 Flood = 0; Flood < NumFloods; ++Flood)
+		{
+			if(Heads[Flood] >= FloodTiles[Flood].Num()) continue;
+
+			int32 Expanded[MaxFloods];
+			const int32 NumExpanded = GetOpenNeighbors(Walkable, FloodTiles[Flood][Heads[Flood]++], Expanded);
+			for (int32 i = 0; i < NumExpanded; ++i)
+			{
+				const int32 Tile = Expanded[i];
+				const uint32 Reached = VisitStamps[Tile] - FloodStamp;
+				if(Reached < MaxFloods)
+				{
+					const int32 GroupA = FindGroup(Flood);
+					const int32 GroupB = FindGroup(Reached);
+					if(GroupA != GroupB) Groups[FMath::Max(GroupA, GroupB)] = FMath::Min(GroupA, GroupB);
+				}
+				else
+				{
+					VisitStamps[Tile] = FloodStamp + Flood;
+					FloodTiles[Flood].Add(Tile);
+				}
+			}
+		}
+	}
+
+	if(NumGroups == 1) return;
+
+	// The piece still open keeps the old label, the others were fully walked and get one each
+	for (int32 Group = 0; Group < NumFloods; ++Group)
+	{
+		if(Group == OpenGroup || FindGroup(Group) != Group) continue;
+
+		const int32 Label = MakeLabel();
+		for (int32 Flood = 0; Flood < NumFloods; ++Flood)
+		{
+			if(FindGroup(Flood) != Group) continue;
+			for (const int32 Tile : FloodTiles[Flood])
+			{
+				TileLabels[Tile] = Label;
+			}
+		}
+	}
+}
+
+int32 FGridRegionLabels::GetOpenNeighbors(const FGridBitset& Walkable, const int32 Index, int32 (&OutNeighbors)[MaxFloods]) const
+{
+	const int32 Row = Index / NumColumns;
+	const int32 Column = Index - Row * NumColumns;
+	int32 NumNeighbors = 0;
+	if(Row > 0 && Walkable.Get(Index - NumColumns)) OutNeighbors[NumNeighbors++] = Index - NumColumns;
+	if(Row < NumRows - 1 && Walkable.Get(Index + NumColumns)) OutNeighbors[NumNeighbors++] = Index + NumColumns;
+	if(Column > 0 && Walkable.Get(Index - 1)) OutNeighbors[NumNeighbors++] = Index - 1;
+	if(Column < NumColumns - 1 && Walkable.Get(Index + 1)) OutNeighbors[NumNeighbors++] = Index + 1;
+	return NumNeighbors;
+}
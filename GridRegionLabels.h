@@ -0,0 +1,72 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FGridBitset;
+
+/**
+ * Connected regions of the walkable tiles, so reachability is a label comparison instead of a search.
+ * Regions are 4-connected, which reaches the same tiles as the 8-connected pathfinder since it never cuts corners.
+ * Tiles hold a label and labels are merged with union-find, a tile opening unions its neighbors in place.
+ * A tile closing floods from its open neighbors in lockstep and stops as soon as at most one flood is still going,
+ * only the pieces that closed off get new labels so the cost follows the size of the smaller pieces.
+ */
+class FGridRegionLabels
+{
+public:
+	/** Label every tile from the walk bitset, indexed Row * NumColumns + Column */
+	void Build(const FGridBitset& Walkable, int32 InNumRows, int32 InNumColumns);
+
+	/** Drop the labels, keeping the allocation for the next build */
+	void Invalidate();
+
+	FORCEINLINE bool IsBuilt() const { return bBuilt; }
+
+	/** Update the labels after the walk flag of one tile was written, the bitset holds the new value */
+	void OnWalkableChanged(const FGridBitset& Walkable, int32 Index);
+
+	/**
+	 * @brief Region of a tile, ids are only stable until the next walk flag change
+	 * @return INDEX_NONE if the tile is not walkable
+	 */
+	int32 GetRegionId(int32 Index) const;
+
+	FORCEINLINE bool AreConnected(const int32 IndexA, const int32 IndexB) const
+	{
+		const int32 RegionA = GetRegionId(IndexA);
+		return RegionA != INDEX_NONE && RegionA == GetRegionId(IndexB);
+	}
+
+	FORCEINLINE int32 NumRegions() const { return RegionCount; }
+
+private:
+	static constexpr int32 MaxFloods = 4;
+
+	int32 MakeLabel();
+	int32 FindRoot(int32 Label) const;
+
+	/** @return true if the two labels were in different regions */
+	bool Union(int32 LabelA, int32 LabelB);
+
+	void OnTileOpened(const FGridBitset& Walkable, int32 Index);
+	void OnTileClosed(const FGridBitset& Walkable, int32 Index);
+	int32 GetOpenNeighbors(const FGridBitset& Walkable, int32 Index, int32 (&OutNeighbors)[MaxFloods]) const;
+
+	int32 NumRows = 0;
+	int32 NumColumns = 0;
+	int32 RegionCount = 0;
+	bool bBuilt = false;
+
+	// Per tile label, INDEX_NONE on blocked tiles
+	TArray<int32> TileLabels;
+
+	// Union-find forest over labels, paths are compressed on lookups
+	mutable TArray<int32> LabelParents;
+
+	// Flood bookkeeping of splits, a tile stamped FloodStamp + i was reached by flood i
+	TArray<uint32> VisitStamps;
+	uint32 FloodStamp = 0;
+	TArray<int32> FloodTiles[MaxFloods];
+};
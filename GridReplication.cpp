@@ -0,0 +1,147 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#include "GridReplication.h"
+
+#include "GridManager.h"
+#include "GridStats.h"
+#include "GridTileStorage.h"
+
+namespace GridReplication
+{
+	enum EWordTag : uint8
+	{
+		Zeros = 0,
+		Ones = 1,
+		Literal = 2
+	};
+
+	FORCEINLINE int32 GetNumTagBytes(const int32 NumWords)
+	{
+		// 2 bits per word of both bitsets
+		return FMath::DivideAndRoundUp(NumWords * 2, 4);
+	}
+}
+
+void FGridReplicatedChunk::PostReplicatedAdd(const FGridReplicatedChunks& InArraySerializer)
+{
+	// Chunks received before the owner is set up are applied by its BeginPlay
+	if(InArraySerializer.Owner != nullptr) InArraySerializer.Owner->ApplyReplicatedChunk(ChunkIndex, Payload);
+}
+
+void FGridReplicatedChunk::PostReplicatedChange(const FGridReplicatedChunks& InArraySerializer)
+{
+	if(InArraySerializer.Owner != nullptr) InArraySerializer.Owner->ApplyReplicatedChunk(ChunkIndex, Payload);
+}
+
+void FGridReplicatedChunks::StartTracking(const int32 NumTiles)
+{
+	const int32 NumChunks = FMath::DivideAndRoundUp(FMath::Max(NumTiles, 0), ChunkTiles);
+	ChunkItems.Init(INDEX_NONE, NumChunks);
+	DirtyChunkFlags.Init(false, NumChunks);
+	DirtyChunks.Reset();
+	Items.Reset();
+	MarkArrayDirty();
+}
+
+void FGridReplicatedChunks::MarkAllDirty()
+{
+	for (int32 Chunk = 0; Chunk < ChunkItems.Num(); ++Chunk)
+	{
+		MarkTileDirty(Chunk * ChunkTiles);
+	}
+}
+
+int32 FGridReplicatedChunks::Flush(const FGridTileStorage& Storage)
+{
+	const FGridBitset& Walkable = Storage.GetWalkableBits();
+	const FGridBitset& Spawnable = Storage.GetSpawnableBits();
+
+	int32 NumBytes = 0;
+	for (const int32 Chunk : DirtyChunks)
+	{
+		DirtyChunkFlags[Chunk] = false;
+		const int32 FirstWord = Chunk * ChunkWords;
+		EncodeChunk(Walkable.GetWords() + FirstWord, Spawnable.GetWords() + FirstWord, FMath::Min(ChunkWords, Walkable.NumWords() - FirstWord), EncodedPayload);
+
+		int32& ItemIndex = ChunkItems[Chunk];
+		if(ItemIndex == INDEX_NONE)
+		{
+			ItemIndex = Items.AddDefaulted();
+			Items[ItemIndex].ChunkIndex = Chunk;
+		}
+		else if(Items[ItemIndex].Payload == EncodedPayload)
+		{
+			// Tiles changed and changed back before the flush
+			continue;
+		}
+
+		FGridReplicatedChunk& Item = Items[ItemIndex];
+		Item.Payload = EncodedPayload;
+		MarkItemDirty(Item);
+		NumBytes += Item.Payload.Num();
+	}
+	DirtyChunks.Reset();
+	INC_DWORD_STAT_BY(STAT_GridReplicatedBytes, NumBytes);
+	return NumBytes;
+}
+
+/**
+ * @brief Tag every word of both bitsets, then append the words that are neither all zeros nor all ones
+ */
+void FGridReplicatedChunks::EncodeChunk(const uint64* Walkable, const uint64* Spawnable, const int32 NumWords, TArray<uint8>& OutPayload)
+{
+	const int32 NumTagBytes = GridReplication::GetNumTagBytes(NumWords);
+	OutPayload.Reset();
+	OutPayload.AddZeroed(NumTagBytes);
+
+	for (int32 Tag = 0; Tag < NumWords * 2; ++Tag)
+	{
+		const uint64 Word = Tag < NumWords ? Walkable[Tag] : Spawnable[Tag - NumWords];
+		uint8 WordTag = GridReplication::Literal;
+		if(Word == 0)
+		{
+			WordTag = GridReplication::Zeros;
+		}
+		else if(Word == ~0ull)
+		{
+			WordTag = GridReplication::Ones;
+		}
+		else
+		{
+			OutPayload.Append(reinterpret_cast<const uint8*>(&Word), sizeof(uint64));
+		}
+		OutPayload[Tag >> 2] |= WordTag << ((Tag & 3) * 2);
+	}
+}
+
+bool FGridReplicatedChunks::DecodeChunk(const TArray<uint8>& Payload, const int32 NumWords, TArray<uint64>& OutWalkable, TArray<uint64>& OutSpawnable)
+{
+	const int32 NumTagBytes = GridReplication::GetNumTagBytes(NumWords);
+	if(NumWords <= 0 || Payload.Num() < NumTagBytes) return false;
+
+	OutWalkable.SetNumUninitialized(NumWords, EAllowShrinking::No);
+	OutSpawnable.SetNumUninitialized(NumWords, EAllowShrinking::No);
+
+	int32 Offset = NumTagBytes;
+	for (int32 Tag = 0; Tag < NumWords * 2; ++Tag)
+	{
+		uint64& Word = Tag < NumWords ? OutWalkable[Tag] : OutSpawnable[Tag - NumWords];
+		switch ((Payload[Tag >> 2] >> ((Tag & 3) * 2)) & 3)
+		{
+		case GridReplication::Zeros:
+			Word = 0;
+			break;
+		case GridReplication::Ones:
+			Word = ~0ull;
+			break;
+		case GridReplication::Literal:
+			if(Offset + static_cast<int32>(sizeof(uint64)) > Payload.Num()) return false;
+			FMemory::Memcpy(&Word, Payload.GetData() + Offset, sizeof(uint64));
+			Offset += sizeof(uint64);
+			break;
+		default:
+			return false;
+		}
+	}
+	return Offset == Payload.Num();
+}
@@ -0,0 +1,109 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Net/Serialization/FastArraySerializer.h"
+
+#include "GridReplication.generated.h"
+
+class AGridManager;
+struct FGridTileStorage;
+struct FGridReplicatedChunks;
+
+/**
+ * Walk and spawn words of one chunk of tiles as last written on the server.
+ * Payload is a 2 bit tag per word, all zeros, all ones or literal, walk words first, followed by the literal words
+ */
+USTRUCT()
+struct FGridReplicatedChunk : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 ChunkIndex = INDEX_NONE;
+
+	UPROPERTY()
+	TArray<uint8> Payload;
+
+	void PostReplicatedAdd(const FGridReplicatedChunks& InArraySerializer);
+	void PostReplicatedChange(const FGridReplicatedChunks& InArraySerializer);
+};
+
+/**
+ * Tile flags of a dense grid replicated as fast array items, one per chunk of ChunkWords bitset words.
+ * Clients build the starting flags on their own, so the server adds the item of a chunk the first time one of its tiles
+ * changes and late joiners only receive the chunks that changed. Later writes dirty their chunk, the next flush packs
+ * it again and the fast array sends the items whose replication key moved.
+ */
+USTRUCT()
+struct FGridReplicatedChunks : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	static constexpr int32 ChunkWords = 64;
+	static constexpr int32 ChunkTiles = ChunkWords * 64;
+
+	/** Chunks with more changed tiles than this are patched in bulk instead of tile by tile */
+	static constexpr int32 MaxPerTilePatch = 64;
+
+	/** Track the writes of the server from now on, the current flags are what the clients built themselves */
+	void StartTracking(int32 NumTiles);
+	FORCEINLINE bool IsTracking() const { return ChunkItems.Num() > 0; }
+	FORCEINLINE bool HasDirtyChunks() const { return DirtyChunks.Num() > 0; }
+
+	FORCEINLINE void MarkTileDirty(const int32 Index)
+	{
+		const int32 Chunk = Index / ChunkTiles;
+		if(!DirtyChunkFlags.IsValidIndex(Chunk) || DirtyChunkFlags[Chunk]) return;
+
+		DirtyChunkFlags[Chunk] = true;
+		DirtyChunks.Add(Chunk);
+	}
+
+	void MarkAllDirty();
+
+	/**
+	 * @brief Pack the dirty chunks into their items, items whose payload did not change are not sent again
+	 * @return Payload bytes of the items marked for sending
+	 */
+	int32 Flush(const FGridTileStorage& Storage);
+
+	/**
+	 * @brief Unpack a chunk payload
+	 * @param NumWords Words per bitset the chunk covers, fewer than ChunkWords for the last chunk
+	 * @return false if the payload does not hold exactly NumWords words per bitset
+	 */
+	static bool DecodeChunk(const TArray<uint8>& Payload, int32 NumWords, TArray<uint64>& OutWalkable, TArray<uint64>& OutSpawnable);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FGridReplicatedChunk, FGridReplicatedChunks>(Items, DeltaParms, *this);
+	}
+
+	UPROPERTY()
+	TArray<FGridReplicatedChunk> Items;
+
+	/** Grid patched with the chunks received on clients */
+	UPROPERTY(NotReplicated, Transient)
+	TObjectPtr<AGridManager> Owner;
+
+private:
+	static void EncodeChunk(const uint64* Walkable, const uint64* Spawnable, int32 NumWords, TArray<uint8>& OutPayload);
+
+	// Item of each chunk, INDEX_NONE until one of its tiles changes
+	TArray<int32> ChunkItems;
+
+	TBitArray<> DirtyChunkFlags;
+	TArray<int32> DirtyChunks;
+	TArray<uint8> EncodedPayload;
+};
+
+template<>
+struct TStructOpsTypeTraits<FGridReplicatedChunks> : public TStructOpsTypeTraitsBase2<FGridReplicatedChunks>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true
+	};
+};
@@ -0,0 +1,246 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#include "GridStateFile.h"
+
+#include "GridTileStorage.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+
+namespace GridStateFile
+{
+	constexpr int32 PayloadAlignment = 16;
+
+	FORCEINLINE void AppendBytes(TArray<uint8>& Buffer, const void* Data, const int64 Size)
+	{
+		Buffer.Append(static_cast<const uint8*>(Data), Size);
+	}
+}
+
+bool FGridStateFile::Save(const FGridTileStorage& Storage, const FString& FilePath, const bool bRunLengthFlags)
+{
+	if(Storage.IsPaged())
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s() Paged grids can not be saved"), *FString(__FUNCTION__));
+		return false;
+	}
+
+	const FGridAttributeLayers& Attributes = Storage.GetAttributes();
+	TArray<FSection> Sections;
+	TArray<TConstArrayView<uint8>> Payloads;
+	TArray<uint8> NameBlob;
+
+	// Run length payloads are built up front, raw ones point straight at the storage
+	TArray<uint8> WalkRuns;
+	TArray<uint8> SpawnRuns;
+	const auto AddFlags = [&](const ESectionKind Kind, const FGridBitset& Bits, TArray<uint8>& Runs)
+	{
+		FSection& Section = Sections.AddZeroed_GetRef();
+		Section.Kind = Kind;
+		Section.Encoding = bRunLengthFlags ? EEncoding::RunLength : EEncoding::Raw;
+		if(bRunLengthFlags)
+		{
+			EncodeRuns(Bits.GetWords(), Bits.Num(), Runs);
+			Payloads.Add(Runs);
+		}
+		else
+		{
+			Payloads.Add(TConstArrayView<uint8>(reinterpret_cast<const uint8*>(Bits.GetWords()), Bits.NumWords() * sizeof(uint64)));
+		}
+	};
+	AddFlags(ESectionKind::Walkable, Storage.GetWalkableBits(), WalkRuns);
+	AddFlags(ESectionKind::Spawnable, Storage.GetSpawnableBits(), SpawnRuns);
+
+	for (int32 Layer = 0; Layer < Attributes.NumLayers(); ++Layer)
+	{
+		const FTCHARToUTF8 Name(*Attributes.GetLayerName(Layer).ToString());
+		FSection& Section = Sections.AddZeroed_GetRef();
+		Section.Kind = ESectionKind::Attribute;
+		Section.Encoding = EEncoding::Raw;
+		Section.AttributeType = static_cast<uint8>(Attributes.GetLayerType(Layer));
+		Section.NameLength = static_cast<uint8>(FMath::Min(Name.Length(), 255));
+		Section.NameOffset = NameBlob.Num();
+		GridStateFile::AppendBytes(NameBlob, Name.Get(), Section.NameLength);
+		Payloads.Add(Attributes.GetPlaneBytes(Layer));
+	}
+
+	const FHeader Header{Magic, Version, static_cast<uint16>(Sections.Num()), Storage.GetNumRows(), Storage.GetNumColumns()};
+
+	// Name offsets become file offsets once the table size is known
+	const int64 NamesOffset = sizeof(FHeader) + Sections.Num() * sizeof(FSection);
+	int64 PayloadOffset = Align(NamesOffset + NameBlob.Num(), GridStateFile::PayloadAlignment);
+	for (int32 i = 0; i < Sections.Num(); ++i)
+	{
+		Sections[i].NameOffset += NamesOffset;
+		Sections[i].Offset = PayloadOffset;
+		Sections[i].Size = Payloads[i].Num();
+		PayloadOffset = Align(PayloadOffset + Payloads[i].Num(), GridStateFile::PayloadAlignment);
+	}
+
+	TArray<uint8> Buffer;
+	Buffer.Reserve(PayloadOffset);
+	GridStateFile::AppendBytes(Buffer, &Header, sizeof(FHeader));
+	GridStateFile::AppendBytes(Buffer, Sections.GetData(), Sections.Num() * sizeof(FSection));
+	Buffer.Append(NameBlob);
+	for (int32 i = 0; i < Sections.Num(); ++i)
+	{
+		Buffer.AddZeroed(Sections[i].Offset - Buffer.Num());
+		Buffer.Append(Payloads[i]);
+	}
+
+	if(!FFileHelper::SaveArrayToFile(Buffer, *FilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s() Could not write %s"), *FString(__FUNCTION__), *FilePath);
+		return false;
+	}
+	return true;
+}
+
+bool FGridStateFile::Load(FGridTileStorage& Storage, const FString& FilePath)
+{
+	if(Storage.IsPaged())
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s() Paged grids can not be loaded"), *FString(__FUNCTION__));
+		return false;
+	}
+
+	// Map the file so raw planes are copied straight out of the page cache, read it whole where mapping is not supported
+	const TUniquePtr<IMappedFileHandle> MappedFile(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+	const TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile.IsValid() ? MappedFile->MapRegion() : nullptr);
+	TArray<uint8> FileBytes;
+	if(!MappedRegion.IsValid() && !FFileHelper::LoadFileToArray(FileBytes, *FilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s() Could not open %s"), *FString(__FUNCTION__), *FilePath);
+		return false;
+	}
+
+	const uint8* FileData = MappedRegion.IsValid() ? MappedRegion->GetMappedPtr() : FileBytes.GetData();
+	const uint64 FileSize = MappedRegion.IsValid() ? MappedRegion->GetMappedSize() : FileBytes.Num();
+
+	FHeader Header;
+	if(FileSize < sizeof(FHeader)) return false;
+	FMemory::Memcpy(&Header, FileData, sizeof(FHeader));
+	if(Header.Magic != Magic || Header.Version > Version || FileSize < sizeof(FHeader) + Header.NumSections * sizeof(FSection))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s() %s is not a grid state file or is from a newer version"), *FString(__FUNCTION__), *FilePath);
+		return false;
+	}
+
+	if(Header.NumRows != Storage.GetNumRows() || Header.NumColumns != Storage.GetNumColumns())
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s() %s is a %dx%d grid, expected %dx%d"), *FString(__FUNCTION__), *FilePath, Header.NumRows, Header.NumColumns, Storage.GetNumRows(), Storage.GetNumColumns());
+		return false;
+	}
+
+	TArray<FSection> Sections;
+	Sections.SetNumUninitialized(Header.NumSections);
+	FMemory::Memcpy(Sections.GetData(), FileData + sizeof(FHeader), Header.NumSections * sizeof(FSection));
+	for (const FSection& Section : Sections)
+	{
+		if(Section.Offset > FileSize || Section.Size > FileSize - Section.Offset || Section.NameOffset + Section.NameLength > FileSize)
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s() %s is truncated"), *FString(__FUNCTION__), *FilePath);
+			return false;
+		}
+	}
+
+	// Decode everything before touching the storage so a bad file leaves it as it was
+	const int32 NumTiles = Storage.Num();
+	FGridBitset Walkable;
+	FGridBitset Spawnable;
+	bool bHasWalkable = false;
+	bool bHasSpawnable = false;
+	for (const FSection& Section : Sections)
+	{
+		if(Section.Kind == ESectionKind::Walkable) bHasWalkable = ReadFlags(FileData, Section, NumTiles, Walkable);
+		if(Section.Kind == ESectionKind::Spawnable) bHasSpawnable = ReadFlags(FileData, Section, NumTiles, Spawnable);
+	}
+
+	if(!bHasWalkable || !bHasSpawnable)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s() %s has invalid flags"), *FString(__FUNCTION__), *FilePath);
+		return false;
+	}
+
+	Storage.AdoptFlags(MoveTemp(Walkable), MoveTemp(Spawnable));
+
+	FGridAttributeLayers& Attributes = Storage.GetAttributes();
+	for (const FSection& Section : Sections)
+	{
+		if(Section.Kind != ESectionKind::Attribute || Section.AttributeType > static_cast<uint8>(EGridAttributeType::Float)) continue;
+
+		const EGridAttributeType Type = static_cast<EGridAttributeType>(Section.AttributeType);
+		const FUTF8ToTCHAR NameText(reinterpret_cast<const ANSICHAR*>(FileData + Section.NameOffset), Section.NameLength);
+		const FName Name(NameText.Length(), NameText.Get());
+		const int32 Layer = Attributes.AddLayer(Name, Type, 0.0f);
+		if(Layer == INDEX_NONE || Section.Size != static_cast<uint64>(Attributes.GetPlaneBytes(Layer).Num()))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s() Skipped attribute layer %s of %s"), *FString(__FUNCTION__), *Name.ToString(), *FilePath);
+			continue;
+		}
+		Attributes.SetPlaneBytes(Layer, TConstArrayView<uint8>(FileData + Section.Offset, Section.Size));
+	}
+	return true;
+}
+
+bool FGridStateFile::ReadFlags(const uint8* FileData, const FSection& Section, const int32 NumBits, FGridBitset& OutBits)
+{
+	if(Section.Encoding == EEncoding::RunLength)
+	{
+		return DecodeRuns(FileData + Section.Offset, Section.Size, NumBits, OutBits);
+	}
+
+	if(Section.Size != FMath::DivideAndRoundUp(NumBits, 64) * sizeof(uint64)) return false;
+	OutBits.InitFromWords(NumBits, reinterpret_cast<const uint64*>(FileData + Section.Offset));
+	return true;
+}
+
+/**
+ * @brief Runs of equal bits as uint32 lengths, the first run is of zeros and may be empty
+ */
+void FGridStateFile::EncodeRuns(const uint64* Words, const int32 NumBits, TArray<uint8>& OutBytes)
+{
+	OutBytes.Reset();
+	bool bValue = false;
+	int32 RunStart = 0;
+	while (RunStart < NumBits)
+	{
+		// Find the next bit that differs from the run value a word at a time
+		int32 RunEnd = NumBits;
+		for (int32 WordIndex = RunStart >> 6; WordIndex < FMath::DivideAndRoundUp(NumBits, 64); ++WordIndex)
+		{
+			uint64 Different = bValue ? ~Words[WordIndex] : Words[WordIndex];
+			if(WordIndex == RunStart >> 6) Different &= ~0ull << (RunStart & 63);
+			if(Different != 0)
+			{
+				RunEnd = FMath::Min((WordIndex << 6) + static_cast<int32>(FMath::CountTrailingZeros64(Different)), NumBits);
+				break;
+			}
+		}
+
+		const uint32 RunLength = RunEnd - RunStart;
+		GridStateFile::AppendBytes(OutBytes, &RunLength, sizeof(uint32));
+		RunStart = RunEnd;
+		bValue = !bValue;
+	}
+}
+
+bool FGridStateFile::DecodeRuns(const uint8* Bytes, const uint64 Size, const int32 NumBits, FGridBitset& OutBits)
+{
+	if(Size % sizeof(uint32) != 0) return false;
+
+	OutBits.Init(NumBits, false);
+	int32 Position = 0;
+	bool bValue = false;
+	for (uint64 Offset = 0; Offset < Size; Offset += sizeof(uint32))
+	{
+		uint32 RunLength;
+		FMemory::Memcpy(&RunLength, Bytes + Offset, sizeof(uint32));
+		if(RunLength > static_cast<uint32>(NumBits - Position)) return false;
+
+		if(bValue) OutBits.SetRange(Position, RunLength, true);
+		Position += RunLength;
+		bValue = !bValue;
+	}
+	return Position == NumBits;
+}
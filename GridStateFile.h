@@ -0,0 +1,75 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FGridBitset;
+struct FGridTileStorage;
+
+/**
+ * Versioned binary file of the grid tile state: walk and spawn flags plus the attribute planes.
+ *
+ * Layout, little endian:
+ *   Header | Section table | UTF-8 layer names | section payloads, each 16 byte aligned
+ * Flags are stored as raw bitset words or as alternating run lengths, planes are stored raw.
+ * Raw payloads are laid out exactly like the storage so loading maps the file and copies them in bulk.
+ * Occupants are runtime state and are not saved.
+ */
+class FGridStateFile
+{
+public:
+	static constexpr uint32 Magic = 0x53445247; // "GRDS"
+	static constexpr uint16 Version = 1;
+
+	/**
+	 * @param bRunLengthFlags Store the flags as runs, smaller for layouts with few blocked areas
+	 * @return false if the storage is paged or the file could not be written
+	 */
+	static bool Save(const FGridTileStorage& Storage, const FString& FilePath, bool bRunLengthFlags);
+
+	/**
+	 * @brief Replace the flags and the saved attribute planes of the storage with the file content.
+	 * Layers missing from the storage are added, layers missing from the file are left as they are
+	 * @return false if the file is invalid or its size does not match the storage, the storage is then untouched
+	 */
+	static bool Load(FGridTileStorage& Storage, const FString& FilePath);
+
+private:
+	enum class ESectionKind : uint8
+	{
+		Walkable,
+		Spawnable,
+		Attribute
+	};
+
+	enum class EEncoding : uint8
+	{
+		Raw,
+		RunLength
+	};
+
+	struct FHeader
+	{
+		uint32 Magic;
+		uint16 Version;
+		uint16 NumSections;
+		int32 NumRows;
+		int32 NumColumns;
+	};
+
+	struct FSection
+	{
+		ESectionKind Kind;
+		EEncoding Encoding;
+		uint8 AttributeType;
+		uint8 NameLength;
+		uint32 NameOffset;
+		uint64 Offset;
+		uint64 Size;
+	};
+
+	static void EncodeRuns(const uint64* Words, int32 NumBits, TArray<uint8>& OutBytes);
+	static bool DecodeRuns(const uint8* Bytes, uint64 Size, int32 NumBits, FGridBitset& OutBits);
+	static bool ReadFlags(const uint8* FileData, const FSection& Section, int32 NumBits, FGridBitset& OutBits);
+};
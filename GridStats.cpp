@@ -0,0 +1,172 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#include "GridStats.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include <atomic>
+
+DEFINE_STAT(STAT_GridConstruction);
+DEFINE_STAT(STAT_GridGetTileInfo);
+DEFINE_STAT(STAT_GridSetTileInfo);
+DEFINE_STAT(STAT_GridSpawn);
+DEFINE_STAT(STAT_GridNeighbors);
+DEFINE_STAT(STAT_GridCoordinateConversion);
+DEFINE_STAT(STAT_GridGeneration);
+
+DEFINE_STAT(STAT_GridCalls);
+DEFINE_STAT(STAT_GridTilesTouched);
+DEFINE_STAT(STAT_GridAllocations);
+DEFINE_STAT(STAT_GridErrors);
+DEFINE_STAT(STAT_GridReplicatedBytes);
+
+namespace GridStats
+{
+	enum ECounter : uint8
+	{
+		Calls,
+		Tiles,
+		Allocations,
+		Errors,
+		NumCounters
+	};
+
+	constexpr int32 NumCalls = static_cast<int32>(EGridStatCall::Num);
+
+	const TCHAR* CallNames[NumCalls] = {
+		TEXT("Construction"), TEXT("GetTileInfo"), TEXT("SetTileInfo"), TEXT("Spawn"), TEXT("Neighbors"), TEXT("CoordinateConversion")
+	};
+
+	struct FCounters
+	{
+		uint64 Values[NumCalls][NumCounters] = {};
+
+		uint64 GetTotalCalls() const
+		{
+			uint64 Total = 0;
+			for (int32 Call = 0; Call < NumCalls; ++Call)
+			{
+				Total += Values[Call][Calls];
+			}
+			return Total;
+		}
+	};
+
+	// Written from any thread, read and cleared by the game thread at the end of the frame
+	std::atomic<uint32> Current[NumCalls][NumCounters];
+
+	// Game thread only
+	FCounters LastFrame;
+	FCounters Totals;
+	FCounters PeakFrame;
+	uint64 NumFrames = 0;
+	bool bFrameHookRegistered = false;
+
+	FORCEINLINE void Add(const EGridStatCall Call, const ECounter Counter, const uint32 Amount)
+	{
+		Current[static_cast<int32>(Call)][Counter].fetch_add(Amount, std::memory_order_relaxed);
+	}
+
+	void DumpCounters(FOutputDevice& Ar, const TCHAR* Title, const FCounters& Counters, const double Divider)
+	{
+		Ar.Logf(TEXT("%s"), Title);
+		Ar.Logf(TEXT("  %-22s %12s %12s %12s %12s"), TEXT("Call"), TEXT("Calls"), TEXT("Tiles"), TEXT("Allocations"), TEXT("Errors"));
+		for (int32 Call = 0; Call < NumCalls; ++Call)
+		{
+			const uint64 (&Values)[NumCounters] = Counters.Values[Call];
+			Ar.Logf(TEXT("  %-22s %12.1f %12.1f %12.1f %12.1f"), CallNames[Call], Values[Calls] / Divider, Values[Tiles] / Divider, Values[Allocations] / Divider, Values[Errors] / Divider);
+		}
+	}
+}
+
+static FAutoConsoleCommandWithOutputDevice GridDumpStatsCommand(
+	TEXT("Grid.DumpStats"),
+	TEXT("Print the grid calls, tiles touched, allocations and errors of the last frame, per frame on average and of the busiest frame"),
+	FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&FGridStats::Dump));
+
+static FAutoConsoleCommand GridResetStatsCommand(
+	TEXT("Grid.ResetStats"),
+	TEXT("Clear the grid frame counters, the average and the busiest frame"),
+	FConsoleCommandDelegate::CreateStatic(&FGridStats::Reset));
+
+void FGridStats::RecordCall(const EGridStatCall Call)
+{
+	GridStats::Add(Call, GridStats::Calls, 1);
+	INC_DWORD_STAT(STAT_GridCalls);
+}
+
+void FGridStats::RecordTiles(const EGridStatCall Call, const int32 NumTiles)
+{
+	GridStats::Add(Call, GridStats::Tiles, FMath::Max(NumTiles, 0));
+	INC_DWORD_STAT_BY(STAT_GridTilesTouched, FMath::Max(NumTiles, 0));
+}
+
+void FGridStats::RecordAllocation(const EGridStatCall Call)
+{
+	GridStats::Add(Call, GridStats::Allocations, 1);
+	INC_DWORD_STAT(STAT_GridAllocations);
+}
+
+void FGridStats::RecordError(const EGridStatCall Call)
+{
+	GridStats::Add(Call, GridStats::Errors, 1);
+	INC_DWORD_STAT(STAT_GridErrors);
+}
+
+void FGridStats::RegisterFrameHook()
+{
+	if(GridStats::bFrameHookRegistered) return;
+
+	GridStats::bFrameHookRegistered = true;
+	FCoreDelegates::OnEndFrame.AddStatic(&FGridStats::EndFrame);
+}
+
+void FGridStats::EndFrame()
+{
+	for (int32 Call = 0; Call < GridStats::NumCalls; ++Call)
+	{
+		for (int32 Counter = 0; Counter < GridStats::NumCounters; ++Counter)
+		{
+			const uint32 Value = GridStats::Current[Call][Counter].exchange(0, std::memory_order_relaxed);
+			GridStats::LastFrame.Values[Call][Counter] = Value;
+			GridStats::Totals.Values[Call][Counter] += Value;
+		}
+	}
+	++GridStats::NumFrames;
+
+	if(GridStats::LastFrame.GetTotalCalls() > GridStats::PeakFrame.GetTotalCalls())
+	{
+		GridStats::PeakFrame = GridStats::LastFrame;
+	}
+}
+
+void FGridStats::Dump(FOutputDevice& Ar)
+{
+	if(!GridStats::bFrameHookRegistered)
+	{
+		Ar.Logf(TEXT("Grid stats are not collected, no grid has begun play"));
+		return;
+	}
+#if !GRID_STATS
+	Ar.Logf(TEXT("Grid stats are compiled out of this build, set GRID_STATS=1 to collect them"));
+#endif
+
+	GridStats::DumpCounters(Ar, TEXT("Grid stats, last frame"), GridStats::LastFrame, 1.0);
+	GridStats::DumpCounters(Ar, *FString::Printf(TEXT("Grid stats, average of %llu frames"), GridStats::NumFrames), GridStats::Totals, FMath::Max<double>(GridStats::NumFrames, 1.0));
+	GridStats::DumpCounters(Ar, TEXT("Grid stats, busiest frame"), GridStats::PeakFrame, 1.0);
+}
+
+void FGridStats::Reset()
+{
+	for (std::atomic<uint32> (&Counters)[GridStats::NumCounters] : GridStats::Current)
+	{
+		for (std::atomic<uint32>& Counter : Counters)
+		{
+			Counter.store(0, std::memory_order_relaxed);
+		}
+	}
+	GridStats::LastFrame = GridStats::FCounters();
+	GridStats::Totals = GridStats::FCounters();
+	GridStats::PeakFrame = GridStats::FCounters();
+	GridStats::NumFrames = 0;
+}
@@ -0,0 +1,75 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("GridManager"), STATGROUP_GridManager, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Construction"), STAT_GridConstruction, STATGROUP_GridManager, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Get Tile Info"), STAT_GridGetTileInfo, STATGROUP_GridManager, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Set Tile Info"), STAT_GridSetTileInfo, STATGROUP_GridManager, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spawn"), STAT_GridSpawn, STATGROUP_GridManager, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Neighbors"), STAT_GridNeighbors, STATGROUP_GridManager, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Coordinate Conversion"), STAT_GridCoordinateConversion, STATGROUP_GridManager, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Generation"), STAT_GridGeneration, STATGROUP_GridManager, );
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Calls"), STAT_GridCalls, STATGROUP_GridManager, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Tiles Touched"), STAT_GridTilesTouched, STATGROUP_GridManager, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Allocations"), STAT_GridAllocations, STATGROUP_GridManager, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Errors"), STAT_GridErrors, STATGROUP_GridManager, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Replicated Bytes"), STAT_GridReplicatedBytes, STATGROUP_GridManager, );
+
+// Frame counters behind Grid.DumpStats, kept in Test builds where the stats system is usually compiled out
+#ifndef GRID_STATS
+#define GRID_STATS !UE_BUILD_SHIPPING
+#endif
+
+enum class EGridStatCall : uint8
+{
+	Construction,
+	GetTileInfo,
+	SetTileInfo,
+	Spawn,
+	Neighbors,
+	CoordinateConversion,
+	Num
+};
+
+/**
+ * Per frame counters of the grid entry points, safe to record from any thread.
+ * Counts roll over at the end of every frame once RegisterFrameHook was called, Grid.DumpStats prints the last frame
+ * next to the per frame average and the busiest frame since the hook was registered.
+ */
+class FGridStats
+{
+public:
+	static void RecordCall(EGridStatCall Call);
+	static void RecordTiles(EGridStatCall Call, int32 NumTiles);
+	static void RecordAllocation(EGridStatCall Call);
+	static void RecordError(EGridStatCall Call);
+
+	/** Roll the counters over at the end of every frame, only the first call registers */
+	static void RegisterFrameHook();
+
+	static void Dump(FOutputDevice& Ar);
+	static void Reset();
+
+private:
+	static void EndFrame();
+};
+
+// Trace and cycle scope of a grid entry point, counted as one call of that kind
+#if GRID_STATS
+#define GRID_STAT_SCOPE(Call) SCOPE_CYCLE_COUNTER(STAT_Grid##Call); TRACE_CPUPROFILER_EVENT_SCOPE(Grid_##Call); FGridStats::RecordCall(EGridStatCall::Call)
+#define GRID_STAT_TILES(Call, NumTiles) FGridStats::RecordTiles(EGridStatCall::Call, NumTiles)
+#define GRID_STAT_ALLOCATION(Call) FGridStats::RecordAllocation(EGridStatCall::Call)
+#define GRID_STAT_ERROR(Call) FGridStats::RecordError(EGridStatCall::Call)
+#else
+#define GRID_STAT_SCOPE(Call) SCOPE_CYCLE_COUNTER(STAT_Grid##Call); TRACE_CPUPROFILER_EVENT_SCOPE(Grid_##Call)
+#define GRID_STAT_TILES(Call, NumTiles)
+#define GRID_STAT_ALLOCATION(Call)
+#define GRID_STAT_ERROR(Call)
+#endif
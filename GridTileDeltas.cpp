@@ -0,0 +1,133 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#include "GridTileDeltas.h"
+
+namespace GridTileDeltas
+{
+	// Fraction of the grid past which the list is dropped for an every tile change
+	constexpr int32 AllTilesDivider = 4;
+}
+
+void FGridTileDeltas::Init(const int32 InNumTiles, const bool bSparse)
+{
+	Empty();
+	NumTiles = FMath::Max(InNumTiles, 0);
+	bSparseTiles = bSparse;
+	if(!bSparseTiles)
+	{
+		for (FGridBitset& Bits : FieldBits)
+		{
+			Bits.Init(NumTiles, false);
+		}
+	}
+}
+
+void FGridTileDeltas::Empty()
+{
+	Indices.Empty();
+	for (FGridBitset& Bits : FieldBits)
+	{
+		Bits.Empty();
+	}
+	SparseFields.Empty();
+	AllTilesFields = 0;
+	NumTiles = 0;
+}
+
+void FGridTileDeltas::Record(const int32 Index, const uint8 InFields)
+{
+	if(InFields == 0 || Index < 0 || Index >= NumTiles) return;
+
+	if(AllTilesFields != 0)
+	{
+		AllTilesFields |= InFields;
+		return;
+	}
+
+	if(!IsListed(Index))
+	{
+		if(Indices.Num() >= FMath::Max(NumTiles / GridTileDeltas::AllTilesDivider, 1))
+		{
+			RecordAll(InFields);
+			return;
+		}
+		Indices.Add(Index);
+	}
+
+	if(bSparseTiles)
+	{
+		SparseFields.FindOrAdd(Index) |= InFields;
+		return;
+	}
+
+	for (int32 Field = 0; Field < NumFields; ++Field)
+	{
+		if(InFields & (1 << Field)) FieldBits[Field].Set(Index, true);
+	}
+}
+
+void FGridTileDeltas::RecordAll(const uint8 InFields)
+{
+	if(InFields == 0) return;
+
+	// The listed fields are folded in so dropping the list loses nothing
+	uint8 ListedFields = 0;
+	for (const int32 Index : Indices)
+	{
+		ListedFields |= GetListedFields(Index);
+	}
+	Reset();
+	AllTilesFields = ListedFields | InFields;
+}
+
+void FGridTileDeltas::Flush(TArray<int32>& OutIndices, TArray<uint8>& OutFields, uint8& OutAllTilesFields)
+{
+	OutFields.SetNumUninitialized(Indices.Num(), EAllowShrinking::No);
+	for (int32 i = 0; i < Indices.Num(); ++i)
+	{
+		OutFields[i] = GetListedFields(Indices[i]);
+	}
+	OutAllTilesFields = AllTilesFields;
+
+	// The caller's emptied array becomes the list of the next flush
+	OutIndices.Reset();
+	Swap(OutIndices, Indices);
+	ClearListed(OutIndices);
+	AllTilesFields = 0;
+}
+
+void FGridTileDeltas::Reset()
+{
+	ClearListed(Indices);
+	Indices.Reset();
+	AllTilesFields = 0;
+}
+
+uint8 FGridTileDeltas::GetListedFields(const int32 Index) const
+{
+	if(bSparseTiles) return SparseFields.FindRef(Index);
+
+	uint8 TileFields = 0;
+	for (int32 Field = 0; Field < NumFields; ++Field)
+	{
+		if(FieldBits[Field].Get(Index)) TileFields |= 1 << Field;
+	}
+	return TileFields;
+}
+
+void FGridTileDeltas::ClearListed(const TArray<int32>& ListedIndices)
+{
+	if(bSparseTiles)
+	{
+		SparseFields.Reset();
+		return;
+	}
+
+	for (const int32 Index : ListedIndices)
+	{
+		for (FGridBitset& Bits : FieldBits)
+		{
+			Bits.Set(Index, false);
+		}
+	}
+}
@@ -0,0 +1,62 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GridTileStorage.h"
+
+/**
+ * Tiles changed since the last flush, each listed once with the union of the fields that changed on it.
+ * Fields use the EGridTileField bits. Dense grids keep one bit per tile and field to coalesce repeated writes,
+ * paged grids a map of the changed tiles. Past a quarter of the grid the list is dropped and every tile counts
+ * as changed, listeners then rescan the grid instead of walking a list nearly as long.
+ */
+class FGridTileDeltas
+{
+public:
+	static constexpr int32 NumFields = 3;
+
+	void Init(int32 InNumTiles, bool bSparse);
+	void Empty();
+
+	/** Add the fields to the tile entry, the tile is listed on its first change */
+	void Record(int32 Index, uint8 Fields);
+
+	/** Every tile changed, the fields given here and in later records apply to all tiles */
+	void RecordAll(uint8 Fields);
+
+	FORCEINLINE bool HasChanges() const { return Indices.Num() > 0 || AllTilesFields != 0; }
+
+	/**
+	 * @brief Hand the changes over and start empty, records made while the caller reads them go to the next flush.
+	 * The arrays are swapped so their allocations are reused every other flush
+	 * @param OutIndices Changed tiles in the order they first changed, empty when every tile changed
+	 * @param OutFields Changed fields of the tile at the same position of OutIndices
+	 * @param OutAllTilesFields Fields changed on every tile, 0 if only the listed tiles changed
+	 */
+	void Flush(TArray<int32>& OutIndices, TArray<uint8>& OutFields, uint8& OutAllTilesFields);
+
+	/** Clear the entries, costs the number of changed tiles not the grid size */
+	void Reset();
+
+private:
+	uint8 GetListedFields(int32 Index) const;
+
+	/** Clear the per tile state of the listed tiles, costs their number not the grid size */
+	void ClearListed(const TArray<int32>& ListedIndices);
+
+	FORCEINLINE bool IsListed(const int32 Index) const
+	{
+		return bSparseTiles ? SparseFields.Contains(Index) : (FieldBits[0].Get(Index) || FieldBits[1].Get(Index) || FieldBits[2].Get(Index));
+	}
+
+	TArray<int32> Indices;
+	uint8 AllTilesFields = 0;
+
+	// One bitset per field bit on dense grids
+	FGridBitset FieldBits[NumFields];
+	TMap<int32, uint8> SparseFields;
+	bool bSparseTiles = false;
+
+	int32 NumTiles = 0;
+};
@@ -0,0 +1,54 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GridManager.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGridListenerWriteTest, "OptimizedGrid.TileDeltas.ListenerWriteReportedNextFlush", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/**
+ * @brief A tile written by a change listener while the deltas are broadcast keeps the tick on and is reported by the next flush
+ */
+bool FGridListenerWriteTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("GridTileDeltasTest"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	AGridManager* Grid = World->SpawnActorDeferred<AGridManager>(AGridManager::StaticClass(), FTransform::Identity);
+	Grid->NumRows = 8;
+	Grid->NumColumns = 8;
+	Grid->FinishSpawning(FTransform::Identity);
+	Grid->GenerateTileInfo();
+
+	constexpr int32 Columns = 8;
+	TArray<TArray<int32>> Flushes;
+	Grid->OnTilesChangedNative.AddLambda([Grid, &Flushes](TConstArrayView<int32> Indices, TConstArrayView<uint8> Fields, uint8 AllTilesFields)
+	{
+		Flushes.Emplace(Indices);
+
+		// Only the first flush writes, the second one must report it
+		if(Flushes.Num() == 1) Grid->SetTilesInRect(5, 6, 5, 6, static_cast<int32>(EGridTileField::Walkable), false, true);
+	});
+
+	TestTrue(TEXT("First write"), Grid->SetTilesInRect(1, 2, 1, 2, static_cast<int32>(EGridTileField::Walkable), false, true));
+	Grid->Tick(0.f);
+	TestEqual(TEXT("Flushes after the first tick"), Flushes.Num(), 1);
+	TestTrue(TEXT("First flush holds the first write"), Flushes.Num() >= 1 && Flushes[0].Num() == 1 && Flushes[0][0] == 1 * Columns + 2);
+	TestTrue(TEXT("Tick kept on for the listener write"), Grid->IsActorTickEnabled());
+
+	Grid->Tick(0.f);
+	TestEqual(TEXT("Flushes after the second tick"), Flushes.Num(), 2);
+	TestTrue(TEXT("Second flush holds the listener write"), Flushes.Num() >= 2 && Flushes[1].Num() == 1 && Flushes[1][0] == 5 * Columns + 6);
+	TestFalse(TEXT("Tick off once nothing is left"), Grid->IsActorTickEnabled());
+
+	Grid->OnTilesChangedNative.Clear();
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif
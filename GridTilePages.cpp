@@ -0,0 +1,209 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#include "GridTilePages.h"
+
+#include "GridTileStorage.h"
+#include "Misc/Compression.h"
+
+namespace GridTilePages
+{
+	// Page table values below zero, resident pages hold their slot index
+	constexpr int32 DefaultPage = -1;
+	constexpr int32 ColdPage = -2;
+}
+
+void FGridTilePages::Init(const int32 InNumRows, const int32 InNumColumns, const int32 InPageSize, const int32 InMaxResidentPages)
+{
+	Empty();
+
+	NumRows = FMath::Max(InNumRows, 0);
+	NumColumns = FMath::Max(InNumColumns, 0);
+	PageSize = FMath::Max(InPageSize, 8);
+	NumPageColumns = FMath::DivideAndRoundUp(NumColumns, PageSize);
+	WordsPerPlane = FMath::DivideAndRoundUp(PageSize * PageSize, 64);
+	MaxResidentPages = FMath::Max(InMaxResidentPages, 1);
+
+	DefaultPage.Words.Init(~0ull, WordsPerPlane * 2);
+
+	// Only the page table scales with the grid size, every entry starts on the default page
+	PageSlots.Init(GridTilePages::DefaultPage, FMath::DivideAndRoundUp(NumRows, PageSize) * NumPageColumns);
+}
+
+void FGridTilePages::Empty()
+{
+	NumRows = 0;
+	NumColumns = 0;
+	NumPageColumns = 0;
+	PageSlots.Empty();
+	ResidentPages.Empty();
+	FreeSlots.Empty();
+	ColdPages.Empty();
+	DefaultPage.Words.Empty();
+	TouchCounter = 0;
+}
+
+void FGridTilePages::StreamIn(const FIntRect& Tiles)
+{
+	const int32 MinPageRow = FMath::Max(Tiles.Min.X, 0) / PageSize;
+	const int32 MaxPageRow = (FMath::Min(Tiles.Max.X, NumRows) - 1) / PageSize;
+	const int32 MinPageColumn = FMath::Max(Tiles.Min.Y, 0) / PageSize;
+	const int32 MaxPageColumn = (FMath::Min(Tiles.Max.Y, NumColumns) - 1) / PageSize;
+
+	for (int32 PageRow = MinPageRow; PageRow <= MaxPageRow; ++PageRow)
+	{
+		for (int32 PageColumn = MinPageColumn; PageColumn <= MaxPageColumn; ++PageColumn)
+		{
+			// Touching is enough, default pages stay shared until written
+			GetPageForRead(PageRow * NumPageColumns + PageColumn);
+		}
+	}
+}
+
+void FGridTilePages::ExtractWalkBits(const FIntRect& Tiles, FGridBitset& OutBits) const
+{
+	// Rows run along X, a row of the rect holds Height() columns
+	const int32 RectColumns = Tiles.Height();
+	OutBits.Init(Tiles.Width() * RectColumns, false);
+
+	for (int32 Row = Tiles.Min.X; Row < Tiles.Max.X; ++Row)
+	{
+		// Walk the row one page span at a time so the page is only looked up once per span
+		for (int32 Column = Tiles.Min.Y; Column < Tiles.Max.Y;)
+		{
+			const FPage& Page = GetPageForRead(GetPageIndex(Row, Column));
+			const int32 SpanEnd = FMath::Min((Column / PageSize + 1) * PageSize, Tiles.Max.Y);
+			for (; Column < SpanEnd; ++Column)
+			{
+				const int32 Bit = GetBitInPage(Row, Column);
+				if((Page.Words[Bit >> 6] >> (Bit & 63)) & 1ull)
+				{
+					OutBits.Set((Row - Tiles.Min.X) * RectColumns + Column - Tiles.Min.Y, true);
+				}
+			}
+		}
+	}
+}
+
+SIZE_T FGridTilePages::GetAllocatedSize() const
+{
+	SIZE_T Size = ResidentPages.GetAllocatedSize() + ColdPages.GetAllocatedSize();
+	for (const FPage& Page : ResidentPages)
+	{
+		Size += Page.Words.GetAllocatedSize();
+	}
+	for (const TPair<int32, TArray<uint8>>& Pair : ColdPages)
+	{
+		Size += Pair.Value.GetAllocatedSize();
+	}
+	return Size;
+}
+
+bool FGridTilePages::GetBit(const int32 Row, const int32 Column, const int32 PlaneOffset) const
+{
+	const FPage& Page = GetPageForRead(GetPageIndex(Row, Column));
+	const int32 Bit = GetBitInPage(Row, Column);
+	return (Page.Words[PlaneOffset + (Bit >> 6)] >> (Bit & 63)) & 1ull;
+}
+
+void FGridTilePages::SetBit(const int32 Row, const int32 Column, const int32 PlaneOffset, const bool bValue)
+{
+	// Writing the value a page already has does not need a page of its own
+	if(GetBit(Row, Column, PlaneOffset) == bValue) return;
+
+	FPage& Page = GetPageForWrite(GetPageIndex(Row, Column));
+	const int32 Bit = GetBitInPage(Row, Column);
+	const uint64 Mask = 1ull << (Bit & 63);
+	uint64& Word = Page.Words[PlaneOffset + (Bit >> 6)];
+	Word = bValue ? (Word | Mask) : (Word & ~Mask);
+}
+
+const FGridTilePages::FPage& FGridTilePages::GetPageForRead(const int32 PageIndex) const
+{
+	int32 Slot = PageSlots[PageIndex];
+	if(Slot == GridTilePages::DefaultPage) return DefaultPage;
+	if(Slot == GridTilePages::ColdPage) Slot = MakeResident(PageIndex);
+
+	FPage& Page = ResidentPages[Slot];
+	Page.LastTouch = ++TouchCounter;
+	return Page;
+}
+
+FGridTilePages::FPage& FGridTilePages::GetPageForWrite(const int32 PageIndex)
+{
+	const int32 Slot = PageSlots[PageIndex] >= 0 ? PageSlots[PageIndex] : MakeResident(PageIndex);
+	FPage& Page = ResidentPages[Slot];
+	Page.LastTouch = ++TouchCounter;
+	return Page;
+}
+
+/**
+ * @brief Give the page a resident slot, filled from the cold store or the default page
+ * @return Slot of the page
+ */
+int32 FGridTilePages::MakeResident(const int32 PageIndex) const
+{
+	// Evict first so the slot handed out here cannot be taken back before the caller uses it
+	if(NumResidentPages() >= MaxResidentPages) EvictOverBudget();
+
+	const int32 Slot = FreeSlots.Num() > 0 ? FreeSlots.Pop(EAllowShrinking::No) : ResidentPages.AddDefaulted();
+	FPage& Page = ResidentPages[Slot];
+	Page.PageIndex = PageIndex;
+	Page.Words.SetNumUninitialized(WordsPerPlane * 2);
+
+	TArray<uint8> Compressed;
+	if(PageSlots[PageIndex] == GridTilePages::ColdPage && ColdPages.RemoveAndCopyValue(PageIndex, Compressed))
+	{
+		const bool bUncompressed = FCompression::UncompressMemory(NAME_Zlib, Page.Words.GetData(), Page.Words.Num() * sizeof(uint64), Compressed.GetData(), Compressed.Num());
+		check(bUncompressed);
+	}
+	else
+	{
+		FMemory::Memcpy(Page.Words.GetData(), DefaultPage.Words.GetData(), Page.Words.Num() * sizeof(uint64));
+	}
+
+	PageSlots[PageIndex] = Slot;
+	return Slot;
+}
+
+/**
+ * @brief Evict the least recently touched pages until one slot is left under the budget
+ */
+void FGridTilePages::EvictOverBudget() const
+{
+	while (NumResidentPages() >= MaxResidentPages)
+	{
+		int32 OldestSlot = INDEX_NONE;
+		for (int32 Slot = 0; Slot < ResidentPages.Num(); ++Slot)
+		{
+			if(ResidentPages[Slot].PageIndex != INDEX_NONE && (OldestSlot == INDEX_NONE || ResidentPages[Slot].LastTouch < ResidentPages[OldestSlot].LastTouch))
+			{
+				OldestSlot = Slot;
+			}
+		}
+		Evict(OldestSlot);
+	}
+}
+
+void FGridTilePages::Evict(const int32 Slot) const
+{
+	FPage& Page = ResidentPages[Slot];
+
+	// A page written back to all defaults goes back to sharing the default page
+	if(FMemory::Memcmp(Page.Words.GetData(), DefaultPage.Words.GetData(), Page.Words.Num() * sizeof(uint64)) == 0)
+	{
+		PageSlots[Page.PageIndex] = GridTilePages::DefaultPage;
+	}
+	else
+	{
+		const int32 UncompressedSize = Page.Words.Num() * sizeof(uint64);
+		int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, UncompressedSize);
+		TArray<uint8>& Compressed = ColdPages.Add(Page.PageIndex);
+		Compressed.SetNumUninitialized(CompressedSize);
+		FCompression::CompressMemory(NAME_Zlib, Compressed.GetData(), CompressedSize, Page.Words.GetData(), UncompressedSize);
+		Compressed.SetNum(CompressedSize);
+		PageSlots[Page.PageIndex] = GridTilePages::ColdPage;
+	}
+
+	Page.PageIndex = INDEX_NONE;
+	FreeSlots.Add(Slot);
+}
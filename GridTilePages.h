@@ -0,0 +1,79 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FGridBitset;
+
+/**
+ * Walk and spawn flags of a large grid split in square pages.
+ * Pages that were never written read from one shared default page (walkable and spawnable), a page is only
+ * allocated the first time one of its tiles changes. Resident pages past the budget are evicted least recently
+ * touched first, into a compressed cold store they are read back from on the next touch.
+ */
+class FGridTilePages
+{
+public:
+	void Init(int32 InNumRows, int32 InNumColumns, int32 InPageSize, int32 InMaxResidentPages);
+	void Empty();
+
+	FORCEINLINE bool CanWalkOn(const int32 Row, const int32 Column) const { return GetBit(Row, Column, 0); }
+	FORCEINLINE bool CanSpawnOn(const int32 Row, const int32 Column) const { return GetBit(Row, Column, WordsPerPlane); }
+	FORCEINLINE void SetCanWalkOn(const int32 Row, const int32 Column, const bool bValue) { SetBit(Row, Column, 0, bValue); }
+	FORCEINLINE void SetCanSpawnOn(const int32 Row, const int32 Column, const bool bValue) { SetBit(Row, Column, WordsPerPlane, bValue); }
+
+	/** Bring the pages overlapping the rect back from the cold store and mark them as just used */
+	void StreamIn(const FIntRect& Tiles);
+
+	/**
+	 * @brief Copy the walk flags of a rect into a bitset indexed (Row - Min.X) * Height + (Column - Min.Y)
+	 * @param Tiles Min row/column included, Max excluded, must be inside the grid
+	 */
+	void ExtractWalkBits(const FIntRect& Tiles, FGridBitset& OutBits) const;
+
+	FORCEINLINE int32 GetPageSize() const { return PageSize; }
+	FORCEINLINE int32 NumResidentPages() const { return ResidentPages.Num() - FreeSlots.Num(); }
+	FORCEINLINE int32 NumColdPages() const { return ColdPages.Num(); }
+
+	/** Bytes held by resident and cold pages, the page table excluded */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FPage
+	{
+		// Walk words then spawn words
+		TArray<uint64> Words;
+		int32 PageIndex = INDEX_NONE;
+		uint64 LastTouch = 0;
+	};
+
+	FORCEINLINE int32 GetPageIndex(const int32 Row, const int32 Column) const { return (Row / PageSize) * NumPageColumns + Column / PageSize; }
+	FORCEINLINE int32 GetBitInPage(const int32 Row, const int32 Column) const { return (Row % PageSize) * PageSize + Column % PageSize; }
+
+	bool GetBit(int32 Row, int32 Column, int32 PlaneOffset) const;
+	void SetBit(int32 Row, int32 Column, int32 PlaneOffset, bool bValue);
+
+	/** Page to read from, the default page if it was never written. Cold pages are made resident */
+	const FPage& GetPageForRead(int32 PageIndex) const;
+	FPage& GetPageForWrite(int32 PageIndex);
+	int32 MakeResident(int32 PageIndex) const;
+	void EvictOverBudget() const;
+	void Evict(int32 Slot) const;
+
+	int32 NumRows = 0;
+	int32 NumColumns = 0;
+	int32 PageSize = 64;
+	int32 NumPageColumns = 0;
+	int32 WordsPerPlane = 0;
+	int32 MaxResidentPages = 0;
+
+	FPage DefaultPage;
+
+	// Reads can page data in, residency is bookkeeping rather than grid state
+	mutable TArray<int32> PageSlots;
+	mutable TArray<FPage> ResidentPages;
+	mutable TArray<int32> FreeSlots;
+	mutable TMap<int32, TArray<uint8>> ColdPages;
+	mutable uint64 TouchCounter = 0;
+};
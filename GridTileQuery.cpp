@@ -0,0 +1,178 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#include "GridTileQuery.h"
+
+#include "GridTileStorage.h"
+
+namespace GridTileQuery
+{
+	const FIntPoint NeighborSteps[8] = {
+		FIntPoint(-1, 0), FIntPoint(1, 0), FIntPoint(0, -1), FIntPoint(0, 1),
+		FIntPoint(-1, -1), FIntPoint(-1, 1), FIntPoint(1, -1), FIntPoint(1, 1)
+	};
+
+	/** Narrow the word to the tiles whose flag matches the filter, untested flags leave it as it is */
+	FORCEINLINE void ApplyFlagWord(uint64& Word, const FGridBitset* Bits, const int32 WordIndex, const uint8 Flag, const FGridTileFilter& Filter)
+	{
+		if(Filter.Required & Flag) Word &= Bits->GetWords()[WordIndex];
+		if(Filter.Excluded & Flag) Word &= ~Bits->GetWords()[WordIndex];
+	}
+
+	/**
+	 * Visit the rect tiles that pass the filter until Visitor(Index) returns false
+	 * @return Number of tiles visited, the one that stopped the scan included
+	 */
+	template <typename FuncType>
+	int32 VisitTilesInRect(const FGridTileStorage& Storage, const FIntRect& Tiles, const FGridTileFilter& Filter, FuncType&& Visitor)
+	{
+		const FIntRect Clipped = FGridTileQuery::ClipRect(Storage, Tiles);
+		if(Clipped.IsEmpty()) return 0;
+
+		int32 NumVisited = 0;
+		const int32 NumColumns = Storage.GetNumColumns();
+		if(Storage.IsPaged())
+		{
+			for (int32 Row = Clipped.Min.X; Row < Clipped.Max.X; ++Row)
+			{
+				for (int32 Column = Clipped.Min.Y; Column < Clipped.Max.Y; ++Column)
+				{
+					const int32 Index = Row * NumColumns + Column;
+					if(FGridTileQuery::PassesFilter(Storage, Index, Filter))
+					{
+						++NumVisited;
+						if(!Visitor(Index)) return NumVisited;
+					}
+				}
+			}
+			return NumVisited;
+		}
+
+		// Sparse occupancy has no bitset, occupied tests then go tile by tile with the attribute test
+		const FGridBitset* OccupiedBits = Storage.GetOccupancy().GetOccupiedBits();
+		FGridTileFilter TileFilter;
+		TileFilter.AttributeLayer = Filter.AttributeLayer;
+		TileFilter.MinAttribute = Filter.MinAttribute;
+		TileFilter.MaxAttribute = Filter.MaxAttribute;
+		if(OccupiedBits == nullptr)
+		{
+			TileFilter.Required = Filter.Required & FGridTileFilter::Occupied;
+			TileFilter.Excluded = Filter.Excluded & FGridTileFilter::Occupied;
+		}
+		const bool bTestPerTile = TileFilter.AttributeLayer != INDEX_NONE || TileFilter.Required != 0 || TileFilter.Excluded != 0;
+
+		for (int32 Row = Clipped.Min.X; Row < Clipped.Max.X; ++Row)
+		{
+			const int32 RowStart = Row * NumColumns + Clipped.Min.Y;
+			const int32 RowEnd = Row * NumColumns + Clipped.Max.Y;
+			for (int32 WordIndex = RowStart >> 6; WordIndex <= (RowEnd - 1) >> 6; ++WordIndex)
+			{
+				// Keep the bits of the row span, then the ones of tiles whose flags match
+				uint64 Word = ~0ull;
+				if(WordIndex == RowStart >> 6) Word &= ~0ull << (RowStart & 63);
+				if(WordIndex == (RowEnd - 1) >> 6 && (RowEnd & 63) != 0) Word &= ~0ull >> (64 - (RowEnd & 63));
+				ApplyFlagWord(Word, &Storage.GetWalkableBits(), WordIndex, FGridTileFilter::Walkable, Filter);
+				ApplyFlagWord(Word, &Storage.GetSpawnableBits(), WordIndex, FGridTileFilter::Spawnable, Filter);
+				if(OccupiedBits != nullptr) ApplyFlagWord(Word, OccupiedBits, WordIndex, FGridTileFilter::Occupied, Filter);
+
+				while (Word != 0)
+				{
+					const int32 Index = (WordIndex << 6) + static_cast<int32>(FMath::CountTrailingZeros64(Word));
+					Word &= Word - 1;
+					if(bTestPerTile && !FGridTileQuery::PassesFilter(Storage, Index, TileFilter)) continue;
+
+					++NumVisited;
+					if(!Visitor(Index)) return NumVisited;
+				}
+			}
+		}
+		return NumVisited;
+	}
+}
+
+FIntRect FGridTileQuery::ClipRect(const FGridTileStorage& Storage, const FIntRect& Tiles)
+{
+	const FIntRect Clipped(FMath::Max(Tiles.Min.X, 0), FMath::Max(Tiles.Min.Y, 0), FMath::Min(Tiles.Max.X, Storage.GetNumRows()), FMath::Min(Tiles.Max.Y, Storage.GetNumColumns()));
+	return Clipped.Min.X < Clipped.Max.X && Clipped.Min.Y < Clipped.Max.Y ? Clipped : FIntRect();
+}
+
+bool FGridTileQuery::PassesFilter(const FGridTileStorage& Storage, const int32 Index, const FGridTileFilter& Filter)
+{
+	const uint8 TestedFlags = Filter.Required | Filter.Excluded;
+	uint8 Flags = 0;
+	if(TestedFlags & FGridTileFilter::Walkable) Flags |= Storage.CanWalkOn(Index) ? FGridTileFilter::Walkable : 0;
+	if(TestedFlags & FGridTileFilter::Spawnable) Flags |= Storage.CanSpawnOn(Index) ? FGridTileFilter::Spawnable : 0;
+	if(TestedFlags & FGridTileFilter::Occupied) Flags |= Storage.GetOccupancy().IsOccupied(Index) ? FGridTileFilter::Occupied : 0;
+	if((Flags & Filter.Required) != Filter.Required || (Flags & Filter.Excluded) != 0) return false;
+
+	if(Filter.AttributeLayer == INDEX_NONE) return true;
+
+	// Paged grids have no planes, a filter on one rejects everything there
+	const FGridAttributeLayers& Attributes = Storage.GetAttributes();
+	if(Storage.IsPaged() || !Attributes.IsValidLayer(Filter.AttributeLayer)) return false;
+
+	const float Value = Attributes.GetValue(Filter.AttributeLayer, Index);
+	return Value >= Filter.MinAttribute && Value <= Filter.MaxAttribute;
+}
+
+int32 FGridTileQuery::ForEachTileInRect(const FGridTileStorage& Storage, const FIntRect& Tiles, const FGridTileFilter& Filter, const TFunctionRef<void(int32 Index)> Visitor)
+{
+	return GridTileQuery::VisitTilesInRect(Storage, Tiles, Filter, [&Visitor](const int32 Index)
+	{
+		Visitor(Index);
+		return true;
+	});
+}
+
+int32 FGridTileQuery::GetTilesInRect(const FGridTileStorage& Storage, const FIntRect& Tiles, const FGridTileFilter& Filter, const TArrayView<int32> OutIndices)
+{
+	if(OutIndices.Num() == 0) return 0;
+
+	int32 NumWritten = 0;
+	GridTileQuery::VisitTilesInRect(Storage, Tiles, Filter, [&OutIndices, &NumWritten](const int32 Index)
+	{
+		OutIndices[NumWritten++] = Index;
+		return NumWritten < OutIndices.Num();
+	});
+	return NumWritten;
+}
+
+int32 FGridTileQuery::ForEachNeighbor(const FGridTileStorage& Storage, const int32 Index, const EGridConnectivity Connectivity, const FGridTileFilter& Filter, const TFunctionRef<void(int32 Index)> Visitor)
+{
+	const int32 NumRows = Storage.GetNumRows();
+	const int32 NumColumns = Storage.GetNumColumns();
+	const int32 Row = Index / NumColumns;
+	const int32 Column = Index - Row * NumColumns;
+	const int32 NumSteps = Connectivity == EGridConnectivity::Four ? 4 : 8;
+
+	int32 NumVisited = 0;
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		const int32 NeighborRow = Row + GridTileQuery::NeighborSteps[Step].X;
+		const int32 NeighborColumn = Column + GridTileQuery::NeighborSteps[Step].Y;
+		if(NeighborRow < 0 || NeighborRow >= NumRows || NeighborColumn < 0 || NeighborColumn >= NumColumns) continue;
+
+		if(Step >= 4 && Connectivity == EGridConnectivity::EightNoCornerCutting &&
+			(!Storage.CanWalkOn(NeighborRow * NumColumns + Column) || !Storage.CanWalkOn(Row * NumColumns + NeighborColumn)))
+		{
+			continue;
+		}
+
+		const int32 Neighbor = NeighborRow * NumColumns + NeighborColumn;
+		if(PassesFilter(Storage, Neighbor, Filter))
+		{
+			Visitor(Neighbor);
+			++NumVisited;
+		}
+	}
+	return NumVisited;
+}
+
+int32 FGridTileQuery::GetNeighbors(const FGridTileStorage& Storage, const int32 Index, const EGridConnectivity Connectivity, const FGridTileFilter& Filter, int32 (&OutIndices)[8])
+{
+	int32 NumWritten = 0;
+	ForEachNeighbor(Storage, Index, Connectivity, Filter, [&OutIndices, &NumWritten](const int32 Neighbor)
+	{
+		OutIndices[NumWritten++] = Neighbor;
+	});
+	return NumWritten;
+}
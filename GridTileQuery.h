@@ -0,0 +1,73 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FGridTileStorage;
+
+enum class EGridConnectivity : uint8
+{
+	Four,
+	Eight,
+
+	/** Diagonals only when both orthogonal tiles are walkable, the moves the pathfinder makes */
+	EightNoCornerCutting
+};
+
+/**
+ * Conditions a tile must meet to be visited, an empty filter accepts every tile
+ */
+struct FGridTileFilter
+{
+	// Same bits as EGridTileField so blueprint masks can be passed straight through
+	static constexpr uint8 Walkable = 1 << 0;
+	static constexpr uint8 Spawnable = 1 << 1;
+	static constexpr uint8 Occupied = 1 << 2;
+
+	/** Bits the tile must have */
+	uint8 Required = 0;
+
+	/** Bits the tile must not have */
+	uint8 Excluded = 0;
+
+	/** Attribute layer whose value must be within [MinAttribute, MaxAttribute], INDEX_NONE to ignore */
+	int32 AttributeLayer = INDEX_NONE;
+	float MinAttribute = 0.0f;
+	float MaxAttribute = 0.0f;
+
+	FGridTileFilter() = default;
+	FGridTileFilter(const uint8 InRequired, const uint8 InExcluded = 0): Required(InRequired), Excluded(InExcluded) {}
+};
+
+/**
+ * Rect and neighbor queries over the tile storage that allocate nothing.
+ * Rects are clipped to the grid before iterating so edges cost nothing extra, and dense storage filters
+ * 64 tiles at a time on the flag words. Results go to a callback or a caller owned buffer.
+ */
+class FGridTileQuery
+{
+public:
+	/** @return The rect clipped to the grid, Min included and Max excluded, X rows and Y columns */
+	static FIntRect ClipRect(const FGridTileStorage& Storage, const FIntRect& Tiles);
+
+	static bool PassesFilter(const FGridTileStorage& Storage, int32 Index, const FGridTileFilter& Filter);
+
+	/**
+	 * @brief Visit the index of every tile of the rect that passes the filter, row by row
+	 * @return Number of tiles visited
+	 */
+	static int32 ForEachTileInRect(const FGridTileStorage& Storage, const FIntRect& Tiles, const FGridTileFilter& Filter, TFunctionRef<void(int32 Index)> Visitor);
+
+	/**
+	 * @brief Write the indices of the rect tiles that pass the filter, stopping once the buffer is full
+	 * @return Number of indices written
+	 */
+	static int32 GetTilesInRect(const FGridTileStorage& Storage, const FIntRect& Tiles, const FGridTileFilter& Filter, TArrayView<int32> OutIndices);
+
+	/** @return Number of neighbors visited, the tile itself is not one */
+	static int32 ForEachNeighbor(const FGridTileStorage& Storage, int32 Index, EGridConnectivity Connectivity, const FGridTileFilter& Filter, TFunctionRef<void(int32 Index)> Visitor);
+
+	/** @return Number of neighbor indices written */
+	static int32 GetNeighbors(const FGridTileStorage& Storage, int32 Index, EGridConnectivity Connectivity, const FGridTileFilter& Filter, int32 (&OutIndices)[8]);
+};
@@ -0,0 +1,132 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#include "GridTileSnapshots.h"
+
+FGridTileSnapshots::FPin& FGridTileSnapshots::FPin::operator=(FPin&& Other)
+{
+	if(this != &Other)
+	{
+		Release();
+		Slot = Other.Slot;
+		Other.Slot = nullptr;
+	}
+	return *this;
+}
+
+void FGridTileSnapshots::FPin::Release()
+{
+	if(Slot == nullptr) return;
+
+	// Orders the reads of the snapshot before the publisher sees the slot free
+	Slot->Pins.fetch_sub(1, std::memory_order_release);
+	Slot = nullptr;
+}
+
+FGridTileSnapshots::FPin FGridTileSnapshots::Pin() const
+{
+	// Reads the published slot and counts the pin on it in one step, the slot cannot be retired in between
+	const uint64 Word = Published.fetch_add(PinIncrement, std::memory_order_acquire);
+	checkf((Word >> 32) < (SlotMask), TEXT("Snapshot pin count wrapped"));
+
+	// Each pin reaching a multiple of RebasePins folds that many, grids that never publish again would wrap otherwise.
+	// A fold starts at a multiple above every pending one, so the count never drops below what is still to fold
+	if((((Word >> 32) + 1) & (RebasePins - 1)) == 0) FoldPins(Word & SlotMask);
+	return FPin(&Slots[Word & SlotMask]);
+}
+
+/**
+ * @brief Move RebasePins pins of the published word to the slot counter. The slot is credited first so it never
+ * looks free early, then the word is lowered. If a publish retired the slot in between, it moved the whole count
+ * already and the credit is taken back. The pin being taken keeps the slot from being published again meanwhile
+ */
+void FGridTileSnapshots::FoldPins(const uint64 SlotIndex) const
+{
+	constexpr uint64 Folded = RebasePins * PinIncrement;
+	Slots[SlotIndex].Pins.fetch_add(static_cast<int64>(RebasePins), std::memory_order_acq_rel);
+
+	uint64 Word = Published.load(std::memory_order_relaxed);
+	while ((Word & SlotMask) == SlotIndex)
+	{
+		if(Published.compare_exchange_weak(Word, Word - Folded, std::memory_order_acq_rel, std::memory_order_relaxed)) return;
+	}
+	Slots[SlotIndex].Pins.fetch_sub(static_cast<int64>(RebasePins), std::memory_order_acq_rel);
+}
+
+void FGridTileSnapshots::Init(const int32 InNumRows, const int32 InNumColumns)
+{
+	NumRows = FMath::Max(InNumRows, 0);
+	NumColumns = FMath::Max(InNumColumns, 0);
+	ChunkVersions.Init(0, FMath::DivideAndRoundUp(NumRows * NumColumns, ChunkTiles));
+	MarkAllDirty();
+}
+
+bool FGridTileSnapshots::Publish(const FGridTileStorage& Storage)
+{
+	check(!Storage.IsPaged() && Storage.GetNumRows() == NumRows && Storage.GetNumColumns() == NumColumns);
+
+	// Only this thread changes the slot half of the word
+	const uint64 CurrentSlot = Published.load(std::memory_order_relaxed) & SlotMask;
+	int32 FreeSlot = INDEX_NONE;
+	for (int32 SlotIndex = 0; SlotIndex < MaxSlots; ++SlotIndex)
+	{
+		if(SlotIndex != static_cast<int32>(CurrentSlot) && Slots[SlotIndex].Pins.load(std::memory_order_acquire) == 0)
+		{
+			FreeSlot = SlotIndex;
+			break;
+		}
+	}
+	if(FreeSlot == INDEX_NONE) return false;
+
+	FGridTileSnapshot& Snapshot = Slots[FreeSlot].Snapshot;
+	RefreshSlot(Snapshot, Storage);
+	Snapshot.Version = PendingVersion;
+
+	// Pins taken on the retired slot through the published word now count on the slot itself
+	const uint64 Retired = Published.exchange(FreeSlot, std::memory_order_acq_rel);
+	Slots[Retired & SlotMask].Pins.fetch_add(static_cast<int64>(Retired >> 32), std::memory_order_acq_rel);
+
+	++PendingVersion;
+	bHasChanges = false;
+	return true;
+}
+
+/**
+ * @brief Bring a free slot up to date, whole bitsets are copied if it holds another grid size or every tile changed
+ */
+void FGridTileSnapshots::RefreshSlot(FGridTileSnapshot& Snapshot, const FGridTileStorage& Storage) const
+{
+	const FGridBitset& Walkable = Storage.GetWalkableBits();
+	const FGridBitset& Spawnable = Storage.GetSpawnableBits();
+	const FGridBitset& Occupied = *Storage.GetOccupancy().GetOccupiedBits();
+
+	if(Snapshot.NumRows != NumRows || Snapshot.NumColumns != NumColumns || Snapshot.Version < AllTilesVersion)
+	{
+		Snapshot.Walkable = Walkable;
+		Snapshot.Spawnable = Spawnable;
+		Snapshot.Occupied = Occupied;
+		Snapshot.NumRows = NumRows;
+		Snapshot.NumColumns = NumColumns;
+		return;
+	}
+
+	for (int32 Chunk = 0; Chunk < ChunkVersions.Num(); ++Chunk)
+	{
+		if(ChunkVersions[Chunk] <= Snapshot.Version) continue;
+
+		const int32 FirstWord = Chunk * ChunkWords;
+		const SIZE_T NumBytes = FMath::Min(ChunkWords, Walkable.NumWords() - FirstWord) * sizeof(uint64);
+		FMemory::Memcpy(Snapshot.Walkable.GetWords() + FirstWord, Walkable.GetWords() + FirstWord, NumBytes);
+		FMemory::Memcpy(Snapshot.Spawnable.GetWords() + FirstWord, Spawnable.GetWords() + FirstWord, NumBytes);
+		FMemory::Memcpy(Snapshot.Occupied.GetWords() + FirstWord, Occupied.GetWords() + FirstWord, NumBytes);
+	}
+}
+
+SIZE_T FGridTileSnapshots::GetAllocatedSize() const
+{
+	SIZE_T Size = ChunkVersions.GetAllocatedSize();
+	for (const FSlot& Slot : Slots)
+	{
+		Size += Slot.Snapshot.Walkable.GetAllocatedSize() + Slot.Snapshot.Spawnable.GetAllocatedSize() + Slot.Snapshot.Occupied.GetAllocatedSize();
+	}
+	return Size;
+}
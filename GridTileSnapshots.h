@@ -0,0 +1,139 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GridTileStorage.h"
+
+#include <atomic>
+
+/**
+ * Immutable copy of the walk, spawn and occupied flags of a dense grid as they were when it was published
+ */
+struct FGridTileSnapshot
+{
+	FGridBitset Walkable;
+	FGridBitset Spawnable;
+	FGridBitset Occupied;
+	int32 NumRows = 0;
+	int32 NumColumns = 0;
+
+	/** Number of the publish that made this copy, 0 before the first one */
+	uint64 Version = 0;
+
+	FORCEINLINE bool IsValidTile(const int32 Row, const int32 Column) const
+	{
+		return Row >= 0 && Row < NumRows && Column >= 0 && Column < NumColumns;
+	}
+
+	FORCEINLINE bool CanWalkOn(const int32 Row, const int32 Column) const { return IsValidTile(Row, Column) && Walkable.Get(Row * NumColumns + Column); }
+	FORCEINLINE bool CanSpawnOn(const int32 Row, const int32 Column) const { return IsValidTile(Row, Column) && Spawnable.Get(Row * NumColumns + Column); }
+	FORCEINLINE bool IsOccupied(const int32 Row, const int32 Column) const { return IsValidTile(Row, Column) && Occupied.Get(Row * NumColumns + Column); }
+};
+
+/**
+ * Tile snapshots that worker threads read without locks while the game thread keeps writing the tiles.
+ *
+ * The game thread publishes a new version from time to time, readers pin the current one from any thread and keep
+ * reading it, unchanged, until they release the pin. Versions live in a few fixed slots. The published slot index
+ * and the number of pins taken on it share one atomic word, so pinning is a single fetch add and releasing a
+ * single fetch sub, neither ever waits. Only the rare pin that folds the count below may retry. Publishing swaps the word and moves the pins taken on the old
+ * slot over to the slot counter, the slot is reused once that counter is back to 0.
+ * A slot is refreshed by copying only the chunks of tiles that changed since the version it holds.
+ * Pins held for many frames keep slots busy, publishing is then skipped until one is released.
+ * Every RebasePins pins the count in the word is folded into the slot counter, so grids that stop publishing
+ * never wrap the high half.
+ */
+class FGridTileSnapshots
+{
+	struct FSlot
+	{
+		FGridTileSnapshot Snapshot;
+		mutable std::atomic<int64> Pins{0};
+	};
+
+public:
+	static constexpr int32 MaxSlots = 4;
+	static constexpr int32 ChunkWords = 64;
+	static constexpr int32 ChunkTiles = ChunkWords * 64;
+
+	/** Pinned version, released when destroyed. Move only, may be passed between threads */
+	class FPin
+	{
+	public:
+		FPin() = default;
+		FPin(FPin&& Other) : Slot(Other.Slot) { Other.Slot = nullptr; }
+		FPin& operator=(FPin&& Other);
+		FPin(const FPin&) = delete;
+		FPin& operator=(const FPin&) = delete;
+		~FPin() { Release(); }
+
+		void Release();
+
+		FORCEINLINE bool IsValid() const { return Slot != nullptr; }
+		FORCEINLINE const FGridTileSnapshot& operator*() const { check(Slot != nullptr); return Slot->Snapshot; }
+		FORCEINLINE const FGridTileSnapshot* operator->() const { check(Slot != nullptr); return &Slot->Snapshot; }
+
+	private:
+		friend class FGridTileSnapshots;
+		explicit FPin(const FSlot* InSlot) : Slot(InSlot) {}
+
+		const FSlot* Slot = nullptr;
+	};
+
+	/** Pin the latest published version, safe from any thread. The snapshots must outlive the pin */
+	FPin Pin() const;
+
+	// Game thread only from here
+
+	/** Size the chunk tracking for the grid, everything counts as changed until the next publish */
+	void Init(int32 InNumRows, int32 InNumColumns);
+
+	FORCEINLINE void MarkTileDirty(const int32 Index)
+	{
+		const int32 Chunk = Index / ChunkTiles;
+		if(!ChunkVersions.IsValidIndex(Chunk)) return;
+
+		ChunkVersions[Chunk] = PendingVersion;
+		bHasChanges = true;
+	}
+
+	FORCEINLINE void MarkAllDirty()
+	{
+		AllTilesVersion = PendingVersion;
+		bHasChanges = true;
+	}
+
+	FORCEINLINE bool HasChanges() const { return bHasChanges; }
+
+	/**
+	 * @brief Copy the changed chunks of the storage into a free slot and make it the version readers pin
+	 * @return false if every slot is still pinned, the changes are kept for the next publish
+	 */
+	bool Publish(const FGridTileStorage& Storage);
+
+	/** Bytes held by the slots */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	static constexpr uint64 PinIncrement = 1ull << 32;
+	static constexpr uint64 SlotMask = PinIncrement - 1;
+	static constexpr uint64 RebasePins = 1ull << 30;
+	static_assert(FMath::IsPowerOfTwo(RebasePins), "Folds are triggered with a mask");
+
+	void FoldPins(uint64 SlotIndex) const;
+	void RefreshSlot(FGridTileSnapshot& Snapshot, const FGridTileStorage& Storage) const;
+
+	FSlot Slots[MaxSlots];
+
+	// Low half the published slot, high half the pins taken on it since it was published
+	mutable std::atomic<uint64> Published{0};
+
+	// Version of the next publish and the version each chunk last changed in
+	TArray<uint64> ChunkVersions;
+	uint64 PendingVersion = 1;
+	uint64 AllTilesVersion = 1;
+	bool bHasChanges = true;
+	int32 NumRows = 0;
+	int32 NumColumns = 0;
+};
@@ -0,0 +1,268 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#include "GridTileStorage.h"
+
+/**
+ * @brief Resize the bitset and set every bit to the same value
+ * @param InNumBits Number of bits (tiles)
+ * @param bValue Value of every bit
+ */
+void FGridBitset::Init(const int32 InNumBits, const bool bValue)
+{
+	NumBits = FMath::Max(InNumBits, 0);
+	Words.Init(bValue ? ~0ull : 0ull, FMath::DivideAndRoundUp(NumBits, 64));
+	ClearTrailingBits();
+}
+
+/**
+ * @brief Resize the bitset and copy its words in one go, InWords must hold DivideAndRoundUp(InNumBits, 64) words
+ */
+void FGridBitset::InitFromWords(const int32 InNumBits, const uint64* InWords)
+{
+	NumBits = FMath::Max(InNumBits, 0);
+	Words.SetNumUninitialized(FMath::DivideAndRoundUp(NumBits, 64));
+	FMemory::Memcpy(Words.GetData(), InWords, Words.Num() * sizeof(uint64));
+	ClearTrailingBits();
+}
+
+void FGridBitset::Empty()
+{
+	Words.Empty();
+	NumBits = 0;
+}
+
+/**
+ * @brief Set Count bits starting at StartIndex, whole words are written at once
+ */
+void FGridBitset::SetRange(const int32 StartIndex, const int32 Count, const bool bValue)
+{
+	if(Count <= 0) return;
+
+	const int32 EndIndex = StartIndex + Count;
+	const int32 FirstWord = StartIndex >> 6;
+	const int32 LastWord = (EndIndex - 1) >> 6;
+	const uint64 FirstMask = ~0ull << (StartIndex & 63);
+	const uint64 LastMask = ~0ull >> (63 - ((EndIndex - 1) & 63));
+
+	for (int32 WordIndex = FirstWord; WordIndex <= LastWord; ++WordIndex)
+	{
+		uint64 Mask = ~0ull;
+		if(WordIndex == FirstWord) Mask &= FirstMask;
+		if(WordIndex == LastWord) Mask &= LastMask;
+		Words[WordIndex] = bValue ? (Words[WordIndex] | Mask) : (Words[WordIndex] & ~Mask);
+	}
+}
+
+/**
+ * @brief Set every bit that is set in Mask to bValue, Mask must have the same number of bits
+ */
+void FGridBitset::SetMasked(const FGridBitset& Mask, const bool bValue)
+{
+	check(Mask.Num() == NumBits);
+	for (int32 WordIndex = 0; WordIndex < Words.Num(); ++WordIndex)
+	{
+		Words[WordIndex] = bValue ? (Words[WordIndex] | Mask.Words[WordIndex]) : (Words[WordIndex] & ~Mask.Words[WordIndex]);
+	}
+}
+
+/**
+ * @brief Invert every bit
+ */
+void FGridBitset::Flip()
+{
+	for (uint64& Word : Words)
+	{
+		Word = ~Word;
+	}
+	ClearTrailingBits();
+}
+
+/**
+ * @return Index of the first set bit, INDEX_NONE if none is set
+ */
+int32 FGridBitset::FindFirstSetBit() const
+{
+	for (int32 WordIndex = 0; WordIndex < Words.Num(); ++WordIndex)
+	{
+		if(Words[WordIndex] != 0) return (WordIndex << 6) + static_cast<int32>(FMath::CountTrailingZeros64(Words[WordIndex]));
+	}
+	return INDEX_NONE;
+}
+
+/**
+ * @return Index of the last set bit, INDEX_NONE if none is set
+ */
+int32 FGridBitset::FindLastSetBit() const
+{
+	for (int32 WordIndex = Words.Num() - 1; WordIndex >= 0; --WordIndex)
+	{
+		if(Words[WordIndex] != 0) return (WordIndex << 6) + 63 - static_cast<int32>(FMath::CountLeadingZeros64(Words[WordIndex]));
+	}
+	return INDEX_NONE;
+}
+
+int32 FGridBitset::CountSetBits() const
+{
+	int32 Count = 0;
+	for (const uint64 Word : Words)
+	{
+		Count += FMath::CountBits(Word);
+	}
+	return Count;
+}
+
+void FGridBitset::ClearTrailingBits()
+{
+	if(const int32 UsedBits = NumBits & 63; UsedBits != 0)
+	{
+		Words.Last() &= (1ull << UsedBits) - 1;
+	}
+}
+
+/**
+ * @brief Allocate the tile planes, every tile starts walkable, spawnable and empty
+ */
+void FGridTileStorage::Init(const int32 InNumRows, const int32 InNumColumns)
+{
+	NumRows = FMath::Max(InNumRows, 0);
+	NumColumns = FMath::Max(InNumColumns, 0);
+	bPaged = false;
+	Pages.Empty();
+	Walkable.Init(Num(), true);
+	Spawnable.Init(Num(), true);
+	Occupancy.Init(NumRows, NumColumns);
+	Attributes.Init(Num());
+	++WalkVersion;
+}
+
+/**
+ * @brief Set up paged flags, every tile starts walkable, spawnable and empty on the shared default page
+ */
+void FGridTileStorage::InitPaged(const int32 InNumRows, const int32 InNumColumns, const int32 PageSize, const int32 MaxResidentPages)
+{
+	NumRows = FMath::Max(InNumRows, 0);
+	NumColumns = FMath::Max(InNumColumns, 0);
+	bPaged = true;
+	Pages.Init(NumRows, NumColumns, PageSize, MaxResidentPages);
+	Walkable.Empty();
+	Spawnable.Empty();
+	Occupancy.Init(NumRows, NumColumns, true);
+	Attributes.Empty();
+	++WalkVersion;
+}
+
+void FGridTileStorage::Empty()
+{
+	NumRows = 0;
+	NumColumns = 0;
+	Walkable.Empty();
+	Spawnable.Empty();
+	Occupancy.Empty();
+	Attributes.Empty();
+	Pages.Empty();
+	bPaged = false;
+	++WalkVersion;
+}
+
+SIZE_T FGridTileStorage::GetAllocatedSize() const
+{
+	return Walkable.GetAllocatedSize() + Spawnable.GetAllocatedSize() + Occupancy.GetAllocatedSize() + Attributes.GetAllocatedSize() + Pages.GetAllocatedSize();
+}
+
+void FGridTileStorage::AdoptFlags(FGridBitset&& InWalkable, FGridBitset&& InSpawnable)
+{
+	check(!bPaged && InWalkable.Num() == Num() && InSpawnable.Num() == Num());
+	Walkable = MoveTemp(InWalkable);
+	Spawnable = MoveTemp(InSpawnable);
+	++WalkVersion;
+}
+
+void FGridTileStorage::SetFlagWords(const int32 FirstWord, const int32 NumWords, const uint64* InWalkable, const uint64* InSpawnable)
+{
+	check(!bPaged && FirstWord >= 0 && FirstWord + NumWords <= Walkable.NumWords());
+	FMemory::Memcpy(Walkable.GetWords() + FirstWord, InWalkable, NumWords * sizeof(uint64));
+	FMemory::Memcpy(Spawnable.GetWords() + FirstWord, InSpawnable, NumWords * sizeof(uint64));
+
+	if(FirstWord + NumWords == Walkable.NumWords() && (Num() & 63) != 0)
+	{
+		const uint64 LastWordMask = ~0ull >> (64 - (Num() & 63));
+		Walkable.GetWords()[Walkable.NumWords() - 1] &= LastWordMask;
+		Spawnable.GetWords()[Spawnable.NumWords() - 1] &= LastWordMask;
+	}
+	++WalkVersion;
+}
+
+void FGridTileStorage::SetCanWalkOnRange(const int32 StartIndex, const int32 Count, const bool bValue)
+{
+	if(bPaged)
+	{
+		for (int32 Index = StartIndex; Index < StartIndex + Count; ++Index)
+		{
+			Pages.SetCanWalkOn(Index / NumColumns, Index % NumColumns, bValue);
+		}
+	}
+	else
+	{
+		Walkable.SetRange(StartIndex, Count, bValue);
+	}
+	++WalkVersion;
+}
+
+void FGridTileStorage::SetCanSpawnOnRange(const int32 StartIndex, const int32 Count, const bool bValue)
+{
+	if(bPaged)
+	{
+		for (int32 Index = StartIndex; Index < StartIndex + Count; ++Index)
+		{
+			Pages.SetCanSpawnOn(Index / NumColumns, Index % NumColumns, bValue);
+		}
+	}
+	else
+	{
+		Spawnable.SetRange(StartIndex, Count, bValue);
+	}
+}
+
+void FGridTileStorage::SetCanWalkOnMasked(const FGridBitset& Mask, const bool bValue)
+{
+	if(bPaged)
+	{
+		for (int32 Index = Mask.FindFirstSetBit(); Index != INDEX_NONE && Index < Mask.Num(); ++Index)
+		{
+			if(Mask.Get(Index)) Pages.SetCanWalkOn(Index / NumColumns, Index % NumColumns, bValue);
+		}
+	}
+	else
+	{
+		Walkable.SetMasked(Mask, bValue);
+	}
+	++WalkVersion;
+}
+
+void FGridTileStorage::SetCanSpawnOnMasked(const FGridBitset& Mask, const bool bValue)
+{
+	if(bPaged)
+	{
+		for (int32 Index = Mask.FindFirstSetBit(); Index != INDEX_NONE && Index < Mask.Num(); ++Index)
+		{
+			if(Mask.Get(Index)) Pages.SetCanSpawnOn(Index / NumColumns, Index % NumColumns, bValue);
+		}
+	}
+	else
+	{
+		Spawnable.SetMasked(Mask, bValue);
+	}
+}
+
+/**
+ * @brief Replace the first occupant of the tile with Actor, nullptr only removes it. The other occupants and the
+ * tiles claimed by tracked actors are kept, writing the current occupant again leaves the tile untouched
+ */
+void FGridTileStorage::SetActorOnTile(const int32 Index, AActor* Actor)
+{
+	AActor* Current = Occupancy.GetFirst(Index);
+	if(Current == Actor) return;
+
+	if(Current != nullptr) Occupancy.Remove(Index, Current);
+	Occupancy.Add(Index, Actor);
+}
@@ -0,0 +1,156 @@
+// Copyright Rekt Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GridAttributeLayers.h"
+#include "GridOccupancyIndex.h"
+#include "GridTilePages.h"
+
+/**
+ * Packed bitset stored in 64-bit words, one bit per tile index
+ */
+struct FGridBitset
+{
+	void Init(int32 InNumBits, bool bValue);
+	void InitFromWords(int32 InNumBits, const uint64* InWords);
+	void Empty();
+
+	void SetRange(int32 StartIndex, int32 Count, bool bValue);
+	void SetMasked(const FGridBitset& Mask, bool bValue);
+	void Flip();
+	int32 CountSetBits() const;
+	int32 FindFirstSetBit() const;
+	int32 FindLastSetBit() const;
+
+	FORCEINLINE int32 Num() const { return NumBits; }
+	FORCEINLINE int32 NumWords() const { return Words.Num(); }
+	FORCEINLINE SIZE_T GetAllocatedSize() const { return Words.GetAllocatedSize(); }
+	FORCEINLINE const uint64* GetWords() const { return Words.GetData(); }
+	FORCEINLINE uint64* GetWords() { return Words.GetData(); }
+
+	FORCEINLINE bool Get(const int32 Index) const
+	{
+		return (Words[Index >> 6] >> (Index & 63)) & 1ull;
+	}
+
+	FORCEINLINE void Set(const int32 Index, const bool bValue)
+	{
+		const uint64 Mask = 1ull << (Index & 63);
+		uint64& Word = Words[Index >> 6];
+		Word = bValue ? (Word | Mask) : (Word & ~Mask);
+	}
+
+private:
+	/** Clears the bits of the last word that are past NumBits so counts and word scans stay exact */
+	void ClearTrailingBits();
+
+	TArray<uint64> Words;
+	int32 NumBits = 0;
+};
+
+/**
+ * Structure of arrays backing store for the grid tiles.
+ * Walk and spawn flags are packed bitsets, occupants live in a spatial index and positions are derived from the index.
+ * Paged storage keeps the flags in FGridTilePages and a sparse occupancy index, its setup cost does not scale with
+ * the grid size. Whole grid bitsets and attribute layers are only available on dense storage.
+ */
+struct FGridTileStorage
+{
+	void Init(int32 InNumRows, int32 InNumColumns);
+	void InitPaged(int32 InNumRows, int32 InNumColumns, int32 PageSize, int32 MaxResidentPages);
+	void Empty();
+
+	FORCEINLINE bool IsPaged() const { return bPaged; }
+
+	/** Bytes held by the flags, occupancy, attribute planes and pages */
+	SIZE_T GetAllocatedSize() const;
+	FORCEINLINE const FGridTilePages& GetPages() const { return Pages; }
+	FORCEINLINE FGridTilePages& GetPages() { return Pages; }
+
+	FORCEINLINE AActor* GetActorOnTile(const int32 Index) const { return Occupancy.GetFirst(Index); }
+	void SetActorOnTile(int32 Index, AActor* Actor);
+
+	FORCEINLINE void AddActorToTile(const int32 Index, AActor* Actor) { Occupancy.Add(Index, Actor); }
+	FORCEINLINE bool RemoveActorFromTile(const int32 Index, const TObjectKey<AActor> Actor) { return Occupancy.Remove(Index, Actor); }
+	FORCEINLINE bool RemoveActor(const TObjectKey<AActor> Actor) { return Occupancy.Remove(Actor); }
+	FORCEINLINE const FGridOccupancyIndex& GetOccupancy() const { return Occupancy; }
+
+	FORCEINLINE const FGridAttributeLayers& GetAttributes() const { return Attributes; }
+	FORCEINLINE FGridAttributeLayers& GetAttributes() { return Attributes; }
+
+	FORCEINLINE int32 Num() const { return NumRows * NumColumns; }
+	FORCEINLINE int32 GetNumRows() const { return NumRows; }
+	FORCEINLINE int32 GetNumColumns() const { return NumColumns; }
+
+	FORCEINLINE int32 PositionToIndex(const int32 Row, const int32 Column) const { return Row * NumColumns + Column; }
+	FORCEINLINE FIntPoint IndexToPosition(const int32 Index) const { return FIntPoint(Index / NumColumns, Index % NumColumns); }
+
+	FORCEINLINE bool CanWalkOn(const int32 Index) const
+	{
+		return bPaged ? Pages.CanWalkOn(Index / NumColumns, Index % NumColumns) : Walkable.Get(Index);
+	}
+
+	FORCEINLINE bool CanSpawnOn(const int32 Index) const
+	{
+		return bPaged ? Pages.CanSpawnOn(Index / NumColumns, Index % NumColumns) : Spawnable.Get(Index);
+	}
+
+	FORCEINLINE void SetCanWalkOn(const int32 Index, const bool bValue)
+	{
+		if(bPaged)
+		{
+			Pages.SetCanWalkOn(Index / NumColumns, Index % NumColumns, bValue);
+		}
+		else
+		{
+			Walkable.Set(Index, bValue);
+		}
+		++WalkVersion;
+	}
+
+	FORCEINLINE void SetCanSpawnOn(const int32 Index, const bool bValue)
+	{
+		if(bPaged)
+		{
+			Pages.SetCanSpawnOn(Index / NumColumns, Index % NumColumns, bValue);
+		}
+		else
+		{
+			Spawnable.Set(Index, bValue);
+		}
+	}
+
+	/** Bulk writes, whole words at a time on dense storage */
+	void SetCanWalkOnRange(int32 StartIndex, int32 Count, bool bValue);
+	void SetCanSpawnOnRange(int32 StartIndex, int32 Count, bool bValue);
+	void SetCanWalkOnMasked(const FGridBitset& Mask, bool bValue);
+	void SetCanSpawnOnMasked(const FGridBitset& Mask, bool bValue);
+
+	/** Replace the walk and spawn flags of dense storage, both must have one bit per tile */
+	void AdoptFlags(FGridBitset&& InWalkable, FGridBitset&& InSpawnable);
+
+	/** Overwrite a span of the walk and spawn words of dense storage, bits past the last tile are kept clear */
+	void SetFlagWords(int32 FirstWord, int32 NumWords, const uint64* InWalkable, const uint64* InSpawnable);
+
+	/** Whole grid bitsets, dense storage only */
+	FORCEINLINE const FGridBitset& GetWalkableBits() const { check(!bPaged); return Walkable; }
+	FORCEINLINE const FGridBitset& GetSpawnableBits() const { check(!bPaged); return Spawnable; }
+
+	/** Incremented whenever walkability may have changed, lets readers reuse copies of the walk bits */
+	FORCEINLINE uint32 GetWalkVersion() const { return WalkVersion; }
+
+private:
+	FGridBitset Walkable;
+	FGridBitset Spawnable;
+
+	FGridOccupancyIndex Occupancy;
+	FGridAttributeLayers Attributes;
+
+	FGridTilePages Pages;
+	bool bPaged = false;
+
+	int32 NumRows = 0;
+	int32 NumColumns = 0;
+	uint32 WalkVersion = 0;
+};